@@ -0,0 +1,334 @@
+// Performance benchmarks for libtxd hot paths.
+//
+// Run from the repository root (or any directory below it) so the example
+// TXDs are found. For machine-readable results use
+//   libtxd_bench --benchmark_out=results.json --benchmark_out_format=json
+// or the `libtxd_bench_json` target, which does exactly that.
+
+#include <benchmark/benchmark.h>
+#include <filesystem>
+#include <iterator>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <cstring>
+
+#include "libtxd/txd_types.h"
+#include "libtxd/txd_texture.h"
+#include "libtxd/txd_dictionary.h"
+#include "libtxd/txd_converter.h"
+#include "libtxd/txd_pixels.h"
+#include "libtxd/txd_mipmap.h"
+#include "libtxd/txd_encode_cache.h"
+#include "libtxd/txd_index.h"
+
+namespace fs = std::filesystem;
+
+namespace {
+
+const char* const EXAMPLES[] = {"gta3", "gtavc", "gtasa"};
+
+fs::path getExamplePath(const std::string& game) {
+    fs::path current = fs::current_path();
+    while (!current.empty()) {
+        if (fs::exists(current / "examples")) {
+            return current / "examples" / game / "infernus.txd";
+        }
+        if (current == current.parent_path()) {
+            break;
+        }
+        current = current.parent_path();
+    }
+    return fs::path("examples") / game / "infernus.txd";
+}
+
+// Deterministic RGBA8 test image: smooth gradients with some noise so the
+// DXT fitters and the quantizer have real work to do
+std::vector<uint8_t> makeImage(uint32_t width, uint32_t height) {
+    std::vector<uint8_t> image(static_cast<size_t>(width) * height * 4);
+    uint32_t seed = 12345;
+    for (uint32_t y = 0; y < height; y++) {
+        for (uint32_t x = 0; x < width; x++) {
+            seed = seed * 1103515245 + 12345;
+            uint8_t noise = static_cast<uint8_t>((seed >> 16) & 0x1F);
+            uint8_t* pixel = &image[(static_cast<size_t>(y) * width + x) * 4];
+            pixel[0] = static_cast<uint8_t>(x * 255 / width + noise);
+            pixel[1] = static_cast<uint8_t>(y * 255 / height + noise);
+            pixel[2] = static_cast<uint8_t>((x ^ y) + noise);
+            pixel[3] = static_cast<uint8_t>(((x / 8 + y / 8) & 1) ? 255 : 128);
+        }
+    }
+    return image;
+}
+
+struct FormatCase {
+    const char* name;
+    LibTXD::RasterFormat format;
+    uint32_t depth;
+    LibTXD::Compression compression;
+};
+
+const FormatCase FORMATS[] = {
+    {"B8G8R8A8", LibTXD::RasterFormat::B8G8R8A8, 32, LibTXD::Compression::NONE},
+    {"B8G8R8", LibTXD::RasterFormat::B8G8R8, 32, LibTXD::Compression::NONE},
+    {"B8G8R8_24", LibTXD::RasterFormat::B8G8R8, 24, LibTXD::Compression::NONE},
+    {"R5G6B5", LibTXD::RasterFormat::R5G6B5, 16, LibTXD::Compression::NONE},
+    {"A1R5G5B5", LibTXD::RasterFormat::A1R5G5B5, 16, LibTXD::Compression::NONE},
+    {"R4G4B4A4", LibTXD::RasterFormat::R4G4B4A4, 16, LibTXD::Compression::NONE},
+    {"LUM8", LibTXD::RasterFormat::LUM8, 8, LibTXD::Compression::NONE},
+    {"PAL8", LibTXD::RasterFormat::PAL8, 8, LibTXD::Compression::NONE},
+    {"PAL4", LibTXD::RasterFormat::PAL4, 4, LibTXD::Compression::NONE},
+    {"DXT1", LibTXD::RasterFormat::DEFAULT, 16, LibTXD::Compression::DXT1},
+    {"DXT3", LibTXD::RasterFormat::DEFAULT, 16, LibTXD::Compression::DXT3},
+};
+
+// Build a single-level texture of the given format from the test image
+LibTXD::Texture makeTexture(const FormatCase& c, uint32_t size) {
+    std::vector<uint8_t> rgba = makeImage(size, size);
+    
+    LibTXD::Texture texture;
+    texture.setPlatform(LibTXD::Platform::D3D9);
+    texture.setName(c.name);
+    texture.setRasterFormat(c.format);
+    texture.setDepth(c.depth);
+    texture.setCompression(c.compression);
+    
+    LibTXD::MipmapLevel level;
+    level.width = size;
+    level.height = size;
+    
+    const size_t pixelCount = static_cast<size_t>(size) * size;
+    if (c.compression != LibTXD::Compression::NONE) {
+        auto compressed = LibTXD::TextureConverter::compressToDXT(rgba.data(), size, size, c.compression, 0.0f);
+        size_t compressedSize = LibTXD::TextureConverter::getCompressedDataSize(size, size, c.compression);
+        level.data.assign(compressed.get(), compressed.get() + compressedSize);
+    } else if (c.format == LibTXD::RasterFormat::PAL8 || c.format == LibTXD::RasterFormat::PAL4) {
+        uint32_t paletteSize = c.format == LibTXD::RasterFormat::PAL8 ? 256 : 16;
+        std::vector<uint8_t> palette, indices;
+        LibTXD::TextureConverter::generatePalette(rgba.data(), size, size, paletteSize, palette, indices);
+        texture.setPalette(palette, paletteSize);
+        level.data = std::move(indices);
+    } else {
+        uint32_t bytesPerPixel = c.depth / 8;
+        auto pack = LibTXD::Pixels::getPacker(c.format, bytesPerPixel);
+        level.data.resize(pixelCount * bytesPerPixel);
+        pack(rgba.data(), level.data.data(), pixelCount);
+    }
+    level.dataSize = static_cast<uint32_t>(level.data.size());
+    texture.addMipmap(std::move(level));
+    return texture;
+}
+
+} // namespace
+
+// ----------------------------------------------------------------------------
+// Dictionary I/O
+// ----------------------------------------------------------------------------
+
+static void BM_DictionaryLoad(benchmark::State& state) {
+    fs::path path = getExamplePath(EXAMPLES[state.range(0)]);
+    auto mode = static_cast<LibTXD::LoadMode>(state.range(1));
+    if (!fs::exists(path)) {
+        state.SkipWithError("example file not found");
+        return;
+    }
+    
+    for (auto _ : state) {
+        LibTXD::TextureDictionary dict;
+        bool ok = dict.load(path.string(), mode);
+        benchmark::DoNotOptimize(ok);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(fs::file_size(path)));
+    state.SetLabel(std::string(EXAMPLES[state.range(0)]));
+}
+BENCHMARK(BM_DictionaryLoad)
+    ->ArgNames({"game", "mode"})
+    ->ArgsProduct({{0, 1, 2}, {
+        static_cast<int64_t>(LibTXD::LoadMode::Buffered),
+        static_cast<int64_t>(LibTXD::LoadMode::Mapped),
+        static_cast<int64_t>(LibTXD::LoadMode::Lazy)}});
+
+static void BM_DictionarySave(benchmark::State& state) {
+    fs::path path = getExamplePath(EXAMPLES[state.range(0)]);
+    LibTXD::TextureDictionary dict;
+    if (!dict.load(path.string())) {
+        state.SkipWithError("example file not found");
+        return;
+    }
+    
+    size_t bytes = 0;
+    for (auto _ : state) {
+        std::ostringstream stream;
+        dict.save(stream);
+        bytes = static_cast<size_t>(stream.tellp());
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(bytes));
+    state.SetLabel(std::string(EXAMPLES[state.range(0)]));
+}
+BENCHMARK(BM_DictionarySave)->ArgName("game")->DenseRange(0, 2);
+
+static void BM_DictionarySaveFile(benchmark::State& state) {
+    fs::path path = getExamplePath(EXAMPLES[state.range(0)]);
+    LibTXD::TextureDictionary dict;
+    if (!dict.load(path.string())) {
+        state.SkipWithError("example file not found");
+        return;
+    }
+    
+    fs::path outPath = fs::temp_directory_path() / "libtxd_bench_save.txd";
+    for (auto _ : state) {
+        dict.save(outPath.string());
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(fs::file_size(outPath)));
+    state.SetLabel(std::string(EXAMPLES[state.range(0)]));
+    
+    std::error_code ec;
+    fs::remove(outPath, ec);
+}
+BENCHMARK(BM_DictionarySaveFile)->ArgName("game")->DenseRange(0, 2);
+
+// ----------------------------------------------------------------------------
+// Conversion
+// ----------------------------------------------------------------------------
+
+static void BM_ConvertToRGBA8(benchmark::State& state) {
+    const FormatCase& c = FORMATS[state.range(0)];
+    const uint32_t size = static_cast<uint32_t>(state.range(1));
+    LibTXD::Texture texture = makeTexture(c, size);
+    std::vector<uint8_t> output(static_cast<size_t>(size) * size * 4);
+    
+    for (auto _ : state) {
+        LibTXD::TextureConverter::convertToRGBA8(texture, 0, output.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(size) * size);
+    state.SetLabel(c.name);
+}
+BENCHMARK(BM_ConvertToRGBA8)
+    ->ArgNames({"format", "size"})
+    ->ArgsProduct({benchmark::CreateDenseRange(0, static_cast<int64_t>(std::size(FORMATS)) - 1, 1), {256, 2048}})
+    ->Unit(benchmark::kMicrosecond);
+
+static void BM_ConvertToThumbnail(benchmark::State& state) {
+    const FormatCase& c = FORMATS[state.range(0)];
+    const uint32_t size = static_cast<uint32_t>(state.range(1));
+    LibTXD::Texture texture = makeTexture(c, size);
+    std::vector<uint8_t> output;
+    
+    for (auto _ : state) {
+        uint32_t width = 0, height = 0;
+        LibTXD::TextureConverter::convertToThumbnail(texture, 32, output, width, height);
+        benchmark::ClobberMemory();
+    }
+    state.SetLabel(c.name);
+}
+BENCHMARK(BM_ConvertToThumbnail)
+    ->ArgNames({"format", "size"})
+    ->ArgsProduct({benchmark::CreateDenseRange(0, static_cast<int64_t>(std::size(FORMATS)) - 1, 1), {256, 2048}})
+    ->Unit(benchmark::kMicrosecond);
+
+static void BM_CompressToDXT(benchmark::State& state) {
+    auto compression = state.range(0) == 1 ? LibTXD::Compression::DXT1 : LibTXD::Compression::DXT3;
+    float quality = state.range(1) ? 1.0f : 0.0f;
+    const uint32_t size = static_cast<uint32_t>(state.range(2));
+    std::vector<uint8_t> rgba = makeImage(size, size);
+    
+    for (auto _ : state) {
+        auto compressed = LibTXD::TextureConverter::compressToDXT(rgba.data(), size, size, compression, quality);
+        benchmark::DoNotOptimize(compressed.get());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(size) * size);
+}
+BENCHMARK(BM_CompressToDXT)
+    ->ArgNames({"dxt", "quality", "size"})
+    ->ArgsProduct({{1, 3}, {0, 1}, {256, 1024}})
+    ->Unit(benchmark::kMillisecond);
+
+// Repeat compression of the same image, served by the on-disk encode cache
+static void BM_CompressToDXTCached(benchmark::State& state) {
+    const uint32_t size = static_cast<uint32_t>(state.range(0));
+    std::vector<uint8_t> rgba = makeImage(size, size);
+    fs::path dir = fs::temp_directory_path() / "libtxd_bench_encode_cache";
+    LibTXD::TextureConverter::setEncodeCache(LibTXD::EncodeCache::open(dir.string()));
+    LibTXD::TextureConverter::compressToDXT(rgba.data(), size, size, LibTXD::Compression::DXT1);
+    
+    for (auto _ : state) {
+        auto compressed = LibTXD::TextureConverter::compressToDXT(rgba.data(), size, size, LibTXD::Compression::DXT1);
+        benchmark::DoNotOptimize(compressed.get());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(size) * size);
+    
+    LibTXD::TextureConverter::setEncodeCache(nullptr);
+    std::error_code ec;
+    fs::remove_all(dir, ec);
+}
+BENCHMARK(BM_CompressToDXTCached)->ArgName("size")->Arg(256)->Arg(1024)->Unit(benchmark::kMillisecond);
+
+static void BM_DecompressDXT(benchmark::State& state) {
+    auto compression = state.range(0) == 1 ? LibTXD::Compression::DXT1 : LibTXD::Compression::DXT3;
+    const uint32_t size = static_cast<uint32_t>(state.range(1));
+    std::vector<uint8_t> rgba = makeImage(size, size);
+    auto compressed = LibTXD::TextureConverter::compressToDXT(rgba.data(), size, size, compression, 0.0f);
+    
+    for (auto _ : state) {
+        auto output = LibTXD::TextureConverter::decompressDXT(compressed.get(), size, size, compression);
+        benchmark::DoNotOptimize(output.get());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(size) * size);
+}
+BENCHMARK(BM_DecompressDXT)
+    ->ArgNames({"dxt", "size"})
+    ->ArgsProduct({{1, 3}, {256, 2048}})
+    ->Unit(benchmark::kMicrosecond);
+
+static void BM_GeneratePalette(benchmark::State& state) {
+    const uint32_t paletteSize = static_cast<uint32_t>(state.range(0));
+    const uint32_t size = static_cast<uint32_t>(state.range(1));
+    std::vector<uint8_t> rgba = makeImage(size, size);
+    
+    for (auto _ : state) {
+        std::vector<uint8_t> palette, indices;
+        bool ok = LibTXD::TextureConverter::generatePalette(rgba.data(), size, size, paletteSize, palette, indices);
+        benchmark::DoNotOptimize(ok);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(size) * size);
+}
+BENCHMARK(BM_GeneratePalette)
+    ->ArgNames({"colors", "size"})
+    ->ArgsProduct({{16, 256}, {256, 1024}})
+    ->Unit(benchmark::kMillisecond);
+
+static void BM_GenerateMipChain(benchmark::State& state) {
+    const uint32_t size = static_cast<uint32_t>(state.range(0));
+    std::vector<uint8_t> rgba = makeImage(size, size);
+    
+    for (auto _ : state) {
+        auto chain = LibTXD::Mipmaps::generateChain(rgba.data(), size, size);
+        benchmark::DoNotOptimize(chain.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(size) * size);
+}
+BENCHMARK(BM_GenerateMipChain)->ArgName("size")->Arg(256)->Arg(2048)->Unit(benchmark::kMicrosecond);
+
+// Name lookup in an index of the example TXDs
+static void BM_TextureIndexFind(benchmark::State& state) {
+    fs::path indexPath = fs::temp_directory_path() / "libtxd_bench.idx";
+    LibTXD::TextureIndex::build(getExamplePath("gta3").parent_path().parent_path().string(), indexPath.string());
+    LibTXD::TextureIndex index;
+    if (!index.open(indexPath.string())) {
+        state.SkipWithError("cannot build index");
+        return;
+    }
+    
+    for (auto _ : state) {
+        auto found = index.find("White64");
+        benchmark::DoNotOptimize(found.data());
+    }
+    
+    index.close();
+    std::error_code ec;
+    fs::remove(indexPath, ec);
+}
+BENCHMARK(BM_TextureIndexFind)->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
@@ -4,17 +4,22 @@
 #include "TextureListWidget.h"
 #include "AboutDialog.h"
 #include "GameVersionDialog.h"
+#include "TXDLoader.h"
+#include "TXDSaver.h"
+#include "TXDExporter.h"
 #include "libtxd/txd_converter.h"
+#include "libtxd/txd_mipmap.h"
 #include <QFileDialog>
+#include <QInputDialog>
 #include <QMessageBox>
 #include <QMenuBar>
 #include <QMenu>
 #include <QToolBar>
 #include <QStatusBar>
+#include <QProgressBar>
 #include <QSplitter>
 #include <QVBoxLayout>
 #include <QHBoxLayout>
-#include <QListWidget>
 #include <QLabel>
 #include <QGroupBox>
 #include <QFileInfo>
@@ -28,10 +33,36 @@
 #include <QDir>
 #include <QFile>
 #include <QStandardPaths>
+#include <QThreadPool>
 #include <cstring>
+#include <algorithm>
 
 MainWindow::MainWindow(QWidget *parent)
-    : QMainWindow(parent), model(new TXDModel(this)), selectedTextureIndex(-1) {
+    : QMainWindow(parent), model(new TXDModel(this)), exportCompression(TXDExporter::DefaultCompression),
+      selectedTextureIndex(-1) {
+    // Decoded-pixel cache budget for untouched textures
+    bool budgetSet = false;
+    int cacheMB = qEnvironmentVariableIntValue("TXDEDIT_CACHE_MB", &budgetSet);
+    if (budgetSet && cacheMB > 0) {
+        model->setCacheBudget(static_cast<size_t>(cacheMB) << 20);
+    }
+    
+    // Persistent DXT/palette encode cache shared by saves and other instances,
+    // TXDEDIT_ENCODE_CACHE_MB=0 turns it off
+    bool encodeBudgetSet = false;
+    int encodeCacheMB = qEnvironmentVariableIntValue("TXDEDIT_ENCODE_CACHE_MB", &encodeBudgetSet);
+    uint64_t encodeCacheSize = encodeBudgetSet ? static_cast<uint64_t>(std::max(encodeCacheMB, 0)) << 20
+                                               : LibTXD::EncodeCache::DefaultMaxSize;
+    QString cacheLocation = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+    if (encodeCacheSize > 0 && !cacheLocation.isEmpty()) {
+        // Opening sizes up (and may trim) every entry on disk, so keep it off
+        // the UI thread; encodes before it is ready just aren't cached
+        const std::string encodeCacheDir = (cacheLocation + "/encode").toStdString();
+        QThreadPool::globalInstance()->start([encodeCacheDir, encodeCacheSize]() {
+            LibTXD::TextureConverter::setEncodeCache(LibTXD::EncodeCache::open(encodeCacheDir, encodeCacheSize));
+        });
+    }
+    
     setupMenus();  // Create actions first
     setupUI();     // Then setup UI which uses those actions
     
@@ -47,35 +78,65 @@ MainWindow::MainWindow(QWidget *parent)
     });
     connect(model, &TXDModel::textureRemoved, this, [this](size_t index) {
         if (!this || !propertiesWidget) return; // Guard against destruction
-        if (selectedTextureIndex >= static_cast<int>(index)) {
-            if (selectedTextureIndex == static_cast<int>(index)) {
-                selectedTextureIndex = -1;
-                updateTexturePreview();
-                updateTextureProperties();
-            } else {
-                selectedTextureIndex--;
-            }
-        }
+        // The list has already moved its current row; follow it
+        selectedTextureIndex = textureList->currentRow();
+        updateTexturePreview();
+        updateTextureProperties();
         updateTextureList();
     });
     connect(model, &TXDModel::textureUpdated, this, [this](size_t index) {
         if (!this || !propertiesWidget) return; // Guard against destruction
+        // The list refreshes its own row; properties are refreshed by whoever
+        // made the edit, since the properties panel may be the source of it
         if (static_cast<int>(index) == selectedTextureIndex) {
             updateTexturePreview();
-            updateTextureProperties();
         }
-        updateTextureList();
     });
     connect(model, &TXDModel::modifiedChanged, this, [this](bool modified) {
         if (!this) return; // Guard against destruction
         updateWindowTitle();
     });
+    connect(model, &TXDModel::textureLoaded, this, &MainWindow::onTextureLoaded);
+    
+    // Background loading
+    loader = new TXDLoader(model, this);
+    connect(loader, &TXDLoader::started, this, &MainWindow::onLoadStarted);
+    connect(loader, &TXDLoader::progress, this, &MainWindow::onLoadProgress);
+    connect(loader, &TXDLoader::finished, this, &MainWindow::onLoadFinished);
+    connect(loader, &TXDLoader::failed, this, &MainWindow::onLoadFailed);
+    
+    // Background saving
+    saver = new TXDSaver(model, this);
+    connect(saver, &TXDSaver::started, this, &MainWindow::onSaveStarted);
+    connect(saver, &TXDSaver::progress, this, &MainWindow::onSaveProgress);
+    connect(saver, &TXDSaver::finished, this, &MainWindow::onSaveFinished);
+    connect(saver, &TXDSaver::failed, this, &MainWindow::onSaveFailed);
+    connect(saver, &TXDSaver::cancelled, this, &MainWindow::onSaveCancelled);
+    
+    // Background bulk export
+    exporter = new TXDExporter(model, this);
+    connect(exporter, &TXDExporter::started, this, &MainWindow::onExportStarted);
+    connect(exporter, &TXDExporter::progress, this, &MainWindow::onExportProgress);
+    connect(exporter, &TXDExporter::finished, this, &MainWindow::onExportFinished);
+    connect(exporter, &TXDExporter::cancelled, this, &MainWindow::onExportCancelled);
     
     clearUI();
 }
 
 MainWindow::~MainWindow() {
     // Disconnect signals to prevent handlers from firing during destruction
+    if (loader) {
+        disconnect(loader, nullptr, this, nullptr);
+        loader->cancel();
+    }
+    if (saver) {
+        // A running save still completes (see ~TXDSaver)
+        disconnect(saver, nullptr, this, nullptr);
+    }
+    if (exporter) {
+        disconnect(exporter, nullptr, this, nullptr);
+        exporter->cancel();
+    }
     if (model) {
         disconnect(model, nullptr, this, nullptr);
     }
@@ -149,7 +210,8 @@ void MainWindow::setupUI() {
     
     textureList = new TextureListWidget(leftPanel);
     textureList->setObjectName("textureList");
-    connect(textureList, &QListWidget::currentRowChanged, this, &MainWindow::onTextureSelected);
+    textureList->setTextureModel(model);
+    connect(textureList, &TextureListWidget::currentRowChanged, this, &MainWindow::onTextureSelected);
     connect(textureList, &TextureListWidget::exportRequested, this, &MainWindow::onExportRequested);
     connect(textureList, &TextureListWidget::importRequested, this, &MainWindow::onImportRequested);
     connect(textureList, &TextureListWidget::replaceDiffuseRequested, this, &MainWindow::onReplaceDiffuseRequested);
@@ -258,6 +320,37 @@ void MainWindow::setupStatusBar() {
     bar->addWidget(statusTextureLabel);
     bar->addWidget(statusGameLabel);
     bar->addPermanentWidget(statusSelectionLabel, 1);
+    
+    // Shown only while a file is loading
+    loadProgress = new QProgressBar(this);
+    loadProgress->setMaximumWidth(160);
+    loadProgress->setTextVisible(false);
+    loadProgress->hide();
+    bar->addPermanentWidget(loadProgress);
+    
+    // Shown only while a file is saving
+    saveProgress = new QProgressBar(this);
+    saveProgress->setMaximumWidth(160);
+    saveProgress->setTextVisible(false);
+    saveProgress->hide();
+    bar->addPermanentWidget(saveProgress);
+    cancelSaveButton = new QPushButton("Cancel", this);
+    cancelSaveButton->setToolTip("Cancel saving; the file on disk is left unchanged");
+    cancelSaveButton->hide();
+    connect(cancelSaveButton, &QPushButton::clicked, this, [this]() { saver->cancel(); });
+    bar->addPermanentWidget(cancelSaveButton);
+    
+    // Shown only while a bulk export runs
+    exportProgress = new QProgressBar(this);
+    exportProgress->setMaximumWidth(160);
+    exportProgress->setTextVisible(false);
+    exportProgress->hide();
+    bar->addPermanentWidget(exportProgress);
+    cancelExportButton = new QPushButton("Cancel", this);
+    cancelExportButton->setToolTip("Stop exporting; files already written are kept");
+    cancelExportButton->hide();
+    connect(cancelExportButton, &QPushButton::clicked, this, [this]() { exporter->cancel(); });
+    bar->addPermanentWidget(cancelExportButton);
 }
 
 void MainWindow::setStatusMessage(const QString& text) {
@@ -901,6 +994,8 @@ void MainWindow::newFile() {
     }
     
     // Create new empty TXD model
+    loader->cancel();
+    if (loadProgress) loadProgress->hide();
     model->clear();
     // Set version based on game version
     uint32_t version = 0x1803FFFF; // Default to SA
@@ -958,34 +1053,7 @@ void MainWindow::openFile() {
     );
     
     if (!filepath.isEmpty()) {
-        if (loadTXD(filepath)) {
-            model->setFilePath(filepath);
-            updateWindowTitle();
-            if (statusFileLabel) {
-                statusFileLabel->setText("File: " + QFileInfo(filepath).fileName());
-            }
-            if (statusTextureLabel) {
-                statusTextureLabel->setText(QString("Textures: %1").arg(model->getTextureCount()));
-            }
-            updateGameVersionDisplay();
-            setStatusMessage("Path: " + filepath);
-            
-            saveAction->setEnabled(true);
-            saveAction->setVisible(true);
-            saveAsAction->setEnabled(true);
-            saveAsAction->setVisible(true);
-            if (toolbarSeparator) toolbarSeparator->setVisible(true);
-            closeAction->setEnabled(true);
-            addTextureAction->setEnabled(true);
-            removeTextureAction->setEnabled(true);
-            bulkExportAction->setEnabled(true);
-            // Show add/remove buttons when file is open
-            if (addBtn) {
-                addBtn->setEnabled(true);
-                addBtn->setVisible(true);
-            }
-            // Import/export remain hidden until a texture is selected
-        }
+        loadTXD(filepath);
     }
 }
 
@@ -999,10 +1067,7 @@ void MainWindow::saveFile() {
     if (filepath.isEmpty()) {
         saveAsFile();
     } else {
-        if (saveTXD(filepath)) {
-            model->setModified(false);
-            setStatusMessage("File saved successfully");
-        }
+        saveTXD(filepath);
     }
 }
 
@@ -1012,20 +1077,15 @@ void MainWindow::saveAsFile() {
     );
     
     if (!filepath.isEmpty()) {
-        if (saveTXD(filepath)) {
-            model->setFilePath(filepath);
-            model->setModified(false);
-            updateWindowTitle();
-            if (statusFileLabel) {
-                statusFileLabel->setText("File: " + QFileInfo(filepath).fileName());
-            }
-            setStatusMessage("File saved: " + filepath);
-        }
+        // The path is adopted once the save finishes (onSaveFinished)
+        saveTXD(filepath);
     }
 }
 
 void MainWindow::closeFile() {
-    if (model->getTextureCount() > 0 || !model->getFilePath().isEmpty()) {
+    if (loader->isLoading() || model->getTextureCount() > 0 || !model->getFilePath().isEmpty()) {
+        loader->cancel();
+        if (loadProgress) loadProgress->hide();
         model->clear();
         clearUI();
         updateWindowTitle();
@@ -1124,19 +1184,86 @@ void MainWindow::updateWindowTitle() {
     setWindowTitle(title);
 }
 
-bool MainWindow::loadTXD(const QString& filepath) {
-    if (!model->loadFromFile(filepath)) {
-        QMessageBox::critical(this, "Error", 
-            QString("Failed to load TXD file:\n%1").arg(filepath));
-        return false;
+void MainWindow::loadTXD(const QString& filepath) {
+    loader->load(filepath);
+    setStatusMessage("Loading " + QFileInfo(filepath).fileName() + "...");
+}
+
+void MainWindow::onLoadStarted(const QString& filepath, int textureCount) {
+    // The model has been reset for the new file; textures arrive via onTextureLoaded
+    clearUI();
+    updateWindowTitle();
+    if (statusFileLabel) {
+        statusFileLabel->setText("File: " + QFileInfo(filepath).fileName());
+    }
+    if (statusTextureLabel) {
+        statusTextureLabel->setText("Textures: 0");
+    }
+    if (loadProgress) {
+        loadProgress->setRange(0, textureCount);
+        loadProgress->setValue(0);
+        loadProgress->setVisible(textureCount > 0);
+    }
+    
+    // Editing stays disabled until every texture is in the model
+    saveAction->setEnabled(false);
+    saveAsAction->setEnabled(false);
+    addTextureAction->setEnabled(false);
+    removeTextureAction->setEnabled(false);
+    bulkExportAction->setEnabled(false);
+    closeAction->setEnabled(true);
+}
+
+void MainWindow::onLoadProgress(int loaded, int total) {
+    if (loadProgress) {
+        loadProgress->setValue(loaded);
+    }
+    setStatusMessage(QString("Loading textures %1/%2...").arg(loaded).arg(total));
+}
+
+void MainWindow::onTextureLoaded(size_t index) {
+    if (!propertiesWidget) return; // Guard against destruction
+    if (placeholderWidget) placeholderWidget->hide();
+    textureList->show();
+    if (index == 0) {
+        // onTextureSelected will be called via currentRowChanged
+        textureList->setCurrentRow(0);
     }
-    updateTextureList();
     if (statusTextureLabel) {
         statusTextureLabel->setText(QString("Textures: %1").arg(model->getTextureCount()));
     }
+}
+
+void MainWindow::onLoadFinished(const QString& filepath, int textureCount) {
+    if (loadProgress) loadProgress->hide();
     updateGameVersionDisplay();
-    setStatusMessage(QString("Loaded %1 textures").arg(model->getTextureCount()));
-    return true;
+    setStatusMessage("Path: " + filepath);
+    
+    saveAction->setEnabled(true);
+    saveAction->setVisible(true);
+    saveAsAction->setEnabled(true);
+    saveAsAction->setVisible(true);
+    if (toolbarSeparator) toolbarSeparator->setVisible(true);
+    closeAction->setEnabled(true);
+    addTextureAction->setEnabled(true);
+    removeTextureAction->setEnabled(true);
+    bulkExportAction->setEnabled(true);
+    // Show add/remove buttons when file is open
+    if (addBtn) {
+        addBtn->setEnabled(true);
+        addBtn->setVisible(true);
+    }
+    // Import/export remain hidden until a texture is selected
+    if (textureCount == 0) {
+        updateTextureList();
+    }
+}
+
+void MainWindow::onLoadFailed(const QString& filepath) {
+    if (loadProgress) loadProgress->hide();
+    setStatusMessage("Load failed");
+    QMessageBox::critical(this, "Error", 
+        QString("Failed to load TXD file:\n%1").arg(filepath));
 }
 
 bool MainWindow::saveTXD(const QString& filepath) {
@@ -1144,30 +1271,55 @@ bool MainWindow::saveTXD(const QString& filepath) {
         return false;
     }
     
-    if (!model->saveToFile(filepath)) {
-        QMessageBox::critical(this, "Error", 
-            QString("Failed to save TXD file:\n%1").arg(filepath));
-        setStatusMessage("Save failed");
-        return false;
-    }
-    
-    setStatusMessage("File saved successfully");
+    saver->save(filepath);
     return true;
 }
 
-void MainWindow::updateTextureList() {
-    // Preserve current selection before clearing
-    int currentRow = textureList->currentRow();
-    int preservedIndex = -1;
-    if (currentRow >= 0) {
-        QListWidgetItem* item = textureList->item(currentRow);
-        if (item) {
-            preservedIndex = item->data(Qt::UserRole).toInt();
-        }
+void MainWindow::onSaveStarted(const QString& filepath, int textureCount) {
+    if (saveProgress) {
+        saveProgress->setRange(0, textureCount);
+        saveProgress->setValue(0);
+        saveProgress->show();
+    }
+    if (cancelSaveButton) cancelSaveButton->show();
+    setStatusMessage("Saving " + QFileInfo(filepath).fileName() + "...");
+}
+
+void MainWindow::onSaveProgress(int done, int total) {
+    if (saveProgress) {
+        saveProgress->setValue(done);
     }
-    
-    textureList->clearTextures();
-    
+    setStatusMessage(QString("Compressing textures %1/%2...").arg(done).arg(total));
+}
+
+void MainWindow::onSaveFinished(const QString& filepath) {
+    if (saveProgress) saveProgress->hide();
+    if (cancelSaveButton) cancelSaveButton->hide();
+    // TXDSaver has already handed the path and revision to the model
+    updateWindowTitle();
+    if (statusFileLabel && model->getFilePath() == filepath) {
+        statusFileLabel->setText("File: " + QFileInfo(filepath).fileName());
+    }
+    setStatusMessage("File saved: " + filepath);
+}
+
+void MainWindow::onSaveFailed(const QString& filepath) {
+    if (saveProgress) saveProgress->hide();
+    if (cancelSaveButton) cancelSaveButton->hide();
+    setStatusMessage("Save failed");
+    QMessageBox::critical(this, "Error", 
+        QString("Failed to save TXD file:\n%1").arg(filepath));
+}
+
+void MainWindow::onSaveCancelled(const QString& filepath) {
+    if (saveProgress) saveProgress->hide();
+    if (cancelSaveButton) cancelSaveButton->hide();
+    setStatusMessage("Save cancelled");
+}
+
+void MainWindow::updateTextureList() {
+    // Rows follow the model through TextureListModel; this only keeps the
+    // surrounding UI in step with it
     if (!model || model->getTextureCount() == 0) {
         // Show placeholder, hide list
         if (placeholderWidget) placeholderWidget->show();
@@ -1189,23 +1341,8 @@ void MainWindow::updateTextureList() {
     if (placeholderWidget) placeholderWidget->hide();
     textureList->show();
     
-    for (size_t i = 0; i < model->getTextureCount(); i++) {
-        textureList->addTexture(model->getTexture(i), static_cast<int>(i));
-    }
-    
-    // Restore selection if it was valid, otherwise select first texture
-    if (preservedIndex >= 0 && preservedIndex < static_cast<int>(model->getTextureCount())) {
-        // Find the item with the preserved index
-        for (int i = 0; i < textureList->count(); i++) {
-            QListWidgetItem* item = textureList->item(i);
-            if (item && item->data(Qt::UserRole).toInt() == preservedIndex) {
-                textureList->setCurrentRow(i);
-                selectedTextureIndex = preservedIndex;
-                break;
-            }
-        }
-    } else if (textureList->count() > 0) {
-        // Auto-select first texture if no preserved selection
+    if (textureList->currentRow() < 0) {
+        // Auto-select first texture if nothing is selected
         // onTextureSelected will be called automatically via currentRowChanged signal
         textureList->setCurrentRow(0);
     }
@@ -1240,13 +1377,8 @@ void MainWindow::onTextureSelected(int index) {
         return;
     }
     
-    // Get the actual texture index from the item data
-    QListWidgetItem* item = textureList->item(index);
-    if (item) {
-        selectedTextureIndex = item->data(Qt::UserRole).toInt();
-    } else {
-        selectedTextureIndex = index;
-    }
+    // Rows are texture indices
+    selectedTextureIndex = index;
     
     // Update preview and properties when texture is selected
     updateTexturePreview();
@@ -1276,13 +1408,14 @@ void MainWindow::updateTexturePreview() {
     }
     
     TXDFileEntry* entry = model->getTexture(selectedTextureIndex);
-    if (!entry || entry->diffuse.empty()) {
+    TXDModel::Pixels pixels = model->getPixels(selectedTextureIndex);
+    if (!entry || !pixels) {
         previewWidget->clear();
         return;
     }
     
     // Use RGBA data directly
-    previewWidget->setTexture(entry->diffuse.data(), entry->width, entry->height, entry->hasAlpha);
+    previewWidget->setTexture(pixels->data(), entry->width, entry->height, entry->hasAlpha);
 }
 
 void MainWindow::updateTextureProperties() {
@@ -1313,18 +1446,15 @@ void MainWindow::onTexturePropertyChanged() {
         return;
     }
     
-    // Properties are updated directly on the texture entry in the model
-    // Properties are updated directly on the texture entry
-    model->setModified(true);
-    updateTexturePreview();
-    updateTextureList(); // In case name changed
+    // Properties are updated directly on the texture entry; this refreshes
+    // its list row and the preview
+    model->notifyTextureChanged(selectedTextureIndex);
 }
 
 void MainWindow::clearUI() {
     if (statusGameLabel) {
         statusGameLabel->setText("");
     }
-    textureList->clear();
     previewWidget->clear();
     propertiesWidget->clear();
     selectedTextureIndex = -1;
@@ -1409,7 +1539,7 @@ void MainWindow::addTexture() {
     entry.width = width;
     entry.height = height;
     entry.hasAlpha = hasAlpha;
-    entry.mipmapCount = 1;
+    entry.mipmapCount = LibTXD::Mipmaps::getFullChainLength(entry.width, entry.height);  // Chain is built on save
     entry.filterFlags = 0;
     entry.isNew = true;
     entry.platform = LibTXD::Platform::D3D8;  // Default to D3D8 for VC compatibility
@@ -1446,13 +1576,7 @@ void MainWindow::removeTexture() {
     
     if (ret == QMessageBox::Yes) {
         model->removeTexture(selectedTextureIndex);
-        model->setModified(true);
-        selectedTextureIndex = -1;
-        if (propertiesWidget) propertiesWidget->clear();
-        if (propertiesWidget) propertiesWidget->hide();
-        // Disable remove button after removal
-        if (removeBtn) removeBtn->setEnabled(false);
-        updateTextureList();
+        // Selection moves to a neighbouring texture (see textureRemoved)
         setStatusMessage("Texture removed");
     }
 }
@@ -1464,13 +1588,14 @@ void MainWindow::exportTexture() {
     }
     
     TXDFileEntry* entry = model->getTexture(selectedTextureIndex);
-    if (!entry || entry->diffuse.empty()) {
+    TXDModel::Pixels pixels = model->getPixels(selectedTextureIndex);
+    if (!entry || !pixels) {
         QMessageBox::warning(this, "Export Error", "Texture has no data.");
         return;
     }
     
     // Create QImage directly from RGBA data
-    QImage rgbaImage(entry->diffuse.data(), entry->width, entry->height, QImage::Format_RGBA8888);
+    QImage rgbaImage(pixels->data(), entry->width, entry->height, QImage::Format_RGBA8888);
     QImage image = rgbaImage.copy(); // Make a copy
     bool hasAlpha = entry->hasAlpha;
     
@@ -1676,7 +1801,7 @@ void MainWindow::importTexture() {
     entry.width = width;
     entry.height = height;
     entry.hasAlpha = hasAlpha;
-    entry.mipmapCount = 1;
+    entry.mipmapCount = LibTXD::Mipmaps::getFullChainLength(entry.width, entry.height);  // Chain is built on save
     entry.filterFlags = 0;
     entry.isNew = true;
     entry.platform = LibTXD::Platform::D3D8;  // Default to D3D8 for VC compatibility
@@ -1723,85 +1848,62 @@ void MainWindow::bulkExport() {
         return; // User cancelled
     }
     
-    // Ensure folder path ends with separator
-    if (!folderPath.endsWith('/') && !folderPath.endsWith('\\')) {
-        folderPath += '/';
+    // Lower levels write larger files much faster
+    bool ok = false;
+    int compression = QInputDialog::getInt(
+        this, "Bulk Export", "PNG compression level (0 = fastest, 9 = smallest files):",
+        exportCompression, 0, 9, 1, &ok
+    );
+    if (!ok) {
+        return;
     }
+    exportCompression = compression;
     
-    int successCount = 0;
-    int failCount = 0;
-    int alphaCount = 0;
-    
-    // Export all textures
-    for (size_t i = 0; i < textureCount; i++) {
-        TXDFileEntry* entry = model->getTexture(i);
-        if (!entry) {
-            failCount++;
-            continue;
-        }
-        
-        // Use preview pixmap from model
-        // Create QImage directly from RGBA data
-        if (entry->diffuse.empty()) {
-            failCount++;
-            continue;
-        }
-        
-        QImage rgbaImage(entry->diffuse.data(), entry->width, entry->height, QImage::Format_RGBA8888);
-        QImage image = rgbaImage.copy(); // Make a copy
-        
-        // Get base filename
-        QString baseName = entry->name;
-        if (baseName.isEmpty()) {
-            baseName = QString("texture_%1").arg(i);
-        }
-        
-        // Export diffuse
-        QString diffusePath = folderPath + baseName + ".png";
-        if (image.save(diffusePath)) {
-            successCount++;
-        } else {
-            failCount++;
-            continue; // Skip alpha if diffuse failed
-        }
-        
-        // Export alpha if texture has alpha channel
-        bool hasAlpha = entry->hasAlpha;
-        if (hasAlpha) {
-            QImage alphaImage = rgbaImage.copy();
-            int width = alphaImage.width();
-            int height = alphaImage.height();
-            
-            for (int y = 0; y < height; y++) {
-                for (int x = 0; x < width; x++) {
-                    QRgb pixel = alphaImage.pixel(x, y);
-                    uint8_t alpha = qAlpha(pixel);
-                    alphaImage.setPixel(x, y, qRgb(alpha, alpha, alpha));
-                }
-            }
-            
-            QString alphaPath = folderPath + baseName + "_alpha.png";
-            if (alphaImage.save(alphaPath)) {
-                alphaCount++;
-            }
-            // Don't count alpha failure as overall failure
-        }
+    // Decoding and encoding run in the background (see onExport*)
+    exporter->exportAll(folderPath, compression);
+}
+
+void MainWindow::onExportStarted(const QString& folderPath, int textureCount) {
+    if (exportProgress) {
+        exportProgress->setRange(0, textureCount);
+        exportProgress->setValue(0);
+        exportProgress->show();
+    }
+    if (cancelExportButton) cancelExportButton->show();
+    setStatusMessage("Exporting to " + folderPath + "...");
+}
+
+void MainWindow::onExportProgress(int done, int total) {
+    if (exportProgress) {
+        exportProgress->setValue(done);
     }
+    setStatusMessage(QString("Exporting textures %1/%2...").arg(done).arg(total));
+}
+
+void MainWindow::onExportFinished(const QString& folderPath, int exported, int alphaExported, int failedCount) {
+    if (exportProgress) exportProgress->hide();
+    if (cancelExportButton) cancelExportButton->hide();
     
     // Show summary
     QString message = QString("Bulk export completed:\n\n"
                               "Successfully exported: %1 texture(s)\n"
                               "Alpha channels exported: %2\n"
                               "Failed: %3 texture(s)")
-                      .arg(successCount).arg(alphaCount).arg(failCount);
+                      .arg(exported).arg(alphaExported).arg(failedCount);
     
-    if (failCount > 0) {
+    if (failedCount > 0) {
         QMessageBox::warning(this, "Bulk Export", message);
     } else {
         QMessageBox::information(this, "Bulk Export", message);
     }
     
-    setStatusMessage(QString("Bulk exported %1 texture(s) to %2").arg(successCount).arg(folderPath));
+    setStatusMessage(QString("Bulk exported %1 texture(s) to %2").arg(exported).arg(folderPath));
+}
+
+void MainWindow::onExportCancelled(const QString& folderPath) {
+    if (exportProgress) exportProgress->hide();
+    if (cancelExportButton) cancelExportButton->hide();
+    setStatusMessage("Bulk export cancelled");
 }
 
 void MainWindow::onExportRequested(int index) {
@@ -1810,13 +1912,7 @@ void MainWindow::onExportRequested(int index) {
     selectedTextureIndex = index;
     
     // Select the item in the list to match
-    for (int i = 0; i < textureList->count(); i++) {
-        QListWidgetItem* item = textureList->item(i);
-        if (item && item->data(Qt::UserRole).toInt() == index) {
-            textureList->setCurrentRow(i);
-            break;
-        }
-    }
+    textureList->setCurrentRow(index);
     
     // Call export function
     exportTexture();
@@ -1922,11 +2018,12 @@ void MainWindow::onReplaceDiffuseRequested(int index) {
     
     // Get existing RGBA data to preserve alpha if needed
     std::unique_ptr<uint8_t[]> existingRGBA;
-    if (!entry->diffuse.empty() && entry->diffuse.size() == oldWidth * oldHeight * 4) {
+    TXDModel::Pixels existingPixels = model->getPixels(index);
+    if (existingPixels && existingPixels->size() == oldWidth * oldHeight * 4) {
         // Copy existing RGBA data
         size_t dataSize = oldWidth * oldHeight * 4;
         existingRGBA = std::make_unique<uint8_t[]>(dataSize);
-        std::memcpy(existingRGBA.get(), entry->diffuse.data(), dataSize);
+        std::memcpy(existingRGBA.get(), existingPixels->data(), dataSize);
     }
     
     // Prepare new texture data
@@ -1966,15 +2063,17 @@ void MainWindow::onReplaceDiffuseRequested(int index) {
     }
     
     // Update entry data
-    entry->diffuse = newTextureData;
+    entry->diffuse = std::move(newTextureData);
     entry->width = newWidth;
     entry->height = newHeight;
-    model->setModified(true);
+    entry->pixelsDirty = true;
+    if (entry->mipmapCount > 1) {
+        entry->mipmapCount = LibTXD::Mipmaps::getFullChainLength(newWidth, newHeight);
+    }
+    model->notifyTextureChanged(index);
     
-    // Update UI
-    updateTextureList();
+    // Update UI (the list row and preview follow textureUpdated)
     if (selectedTextureIndex == index) {
-        updateTexturePreview();
         updateTextureProperties();
     }
     
@@ -2027,7 +2126,8 @@ void MainWindow::onReplaceAlphaRequested(int index) {
     }
     
     // Get existing texture data to preserve RGB
-    if (entry->diffuse.empty() || entry->diffuse.size() != width * height * 4) {
+    TXDModel::Pixels existingPixels = model->getPixels(index);
+    if (!existingPixels || existingPixels->size() != width * height * 4) {
         QMessageBox::warning(this, "Error", "Failed to get existing texture data.");
         return;
     }
@@ -2035,7 +2135,7 @@ void MainWindow::onReplaceAlphaRequested(int index) {
     // Copy existing RGBA data
     size_t dataSize = width * height * 4;
     std::unique_ptr<uint8_t[]> existingRGBA = std::make_unique<uint8_t[]>(dataSize);
-    std::memcpy(existingRGBA.get(), entry->diffuse.data(), dataSize);
+    std::memcpy(existingRGBA.get(), existingPixels->data(), dataSize);
     
     // Prepare new texture data
     std::vector<uint8_t> newTextureData(dataSize);
@@ -2070,14 +2170,13 @@ void MainWindow::onReplaceAlphaRequested(int index) {
     }
     
     // Update entry data
-    entry->diffuse = newTextureData;
+    entry->diffuse = std::move(newTextureData);
     entry->hasAlpha = true;
-    model->setModified(true);
+    entry->pixelsDirty = true;
+    model->notifyTextureChanged(index);
     
-    // Update UI
-    updateTextureList();
+    // Update UI (the list row and preview follow textureUpdated)
     if (selectedTextureIndex == index) {
-        updateTexturePreview();
         updateTextureProperties();
     }
     
@@ -2085,23 +2184,15 @@ void MainWindow::onReplaceAlphaRequested(int index) {
 }
 
 void MainWindow::onRemoveRequested(int index) {
-    // Temporarily set selectedTextureIndex to the requested index
-    int oldIndex = selectedTextureIndex;
     selectedTextureIndex = index;
     
     // Select the item in the list to match
-    for (int i = 0; i < textureList->count(); i++) {
-        QListWidgetItem* item = textureList->item(i);
-        if (item && item->data(Qt::UserRole).toInt() == index) {
-            textureList->setCurrentRow(i);
-            break;
-        }
-    }
+    textureList->setCurrentRow(index);
     
     // Call remove function
     removeTexture();
     
-    // Restore old selection (though it may be invalid after removal)
-    selectedTextureIndex = oldIndex;
+    // Keep following the list, which has moved on if the texture was removed
+    selectedTextureIndex = textureList->currentRow();
 }
 
@@ -5,7 +5,6 @@
 #include <QMenuBar>
 #include <QStatusBar>
 #include <QSplitter>
-#include <QListWidget>
 #include <QLabel>
 #include <QVBoxLayout>
 #include <QHBoxLayout>
@@ -21,6 +20,10 @@
 class TexturePreviewWidget;
 class TexturePropertiesWidget;
 class TextureListWidget;
+class TXDLoader;
+class TXDSaver;
+class TXDExporter;
+class QProgressBar;
 
 class MainWindow : public QMainWindow {
     Q_OBJECT
@@ -53,6 +56,23 @@ private slots:
     void onReplaceAlphaRequested(int index);
     void onRemoveRequested(int index);
     void onPreviewTabChanged();
+    
+    void onLoadStarted(const QString& filepath, int textureCount);
+    void onLoadProgress(int loaded, int total);
+    void onLoadFinished(const QString& filepath, int textureCount);
+    void onLoadFailed(const QString& filepath);
+    void onTextureLoaded(size_t index);
+    
+    void onSaveStarted(const QString& filepath, int textureCount);
+    void onSaveProgress(int done, int total);
+    void onSaveFinished(const QString& filepath);
+    void onSaveFailed(const QString& filepath);
+    void onSaveCancelled(const QString& filepath);
+    
+    void onExportStarted(const QString& folderPath, int textureCount);
+    void onExportProgress(int done, int total);
+    void onExportFinished(const QString& folderPath, int exported, int alphaExported, int failedCount);
+    void onExportCancelled(const QString& folderPath);
 
 private:
     void setupUI();
@@ -68,11 +88,17 @@ private:
     void updateGameVersionDisplay();
     void updateWindowTitle();
     
-    bool loadTXD(const QString& filepath);
+    // Starts a background load; the UI fills in as textures arrive
+    void loadTXD(const QString& filepath);
+    // Starts a background save; false if there is nothing to save
     bool saveTXD(const QString& filepath);
     QString getIconPath(const QString& iconName) const;
     
     TXDModel* model;
+    TXDLoader* loader = nullptr;
+    TXDSaver* saver = nullptr;
+    TXDExporter* exporter = nullptr;
+    int exportCompression;  // PNG level last chosen for bulk export
     int selectedTextureIndex;
     
     // UI Components
@@ -89,6 +115,11 @@ private:
     QLabel* statusTextureLabel;
     QLabel* statusSelectionLabel;
     QLabel* statusGameLabel;
+    QProgressBar* loadProgress = nullptr;
+    QProgressBar* saveProgress = nullptr;
+    QPushButton* cancelSaveButton = nullptr;
+    QProgressBar* exportProgress = nullptr;
+    QPushButton* cancelExportButton = nullptr;
     
     QAction* newAction = nullptr;
     QAction* openAction = nullptr;
@@ -0,0 +1,123 @@
+#include "TXDExporter.h"
+#include "TXDModel.h"
+#include "libtxd/txd_parallel.h"
+#include "libtxd/txd_pixels.h"
+#include <QImage>
+#include <QMetaObject>
+#include <algorithm>
+
+TXDExporter::TXDExporter(TXDModel* model, QObject* parent)
+    : QObject(parent)
+    , model(model)
+{
+    // One export at a time; textures fan out on the libtxd worker pool
+    pool.setMaxThreadCount(1);
+}
+
+TXDExporter::~TXDExporter() {
+    cancel();
+    pool.waitForDone();
+}
+
+void TXDExporter::exportAll(const QString& folderPath, int compression) {
+    cancel();
+
+    auto job = std::make_shared<Job>();
+    job->folderPath = folderPath;
+    if (!job->folderPath.endsWith('/') && !job->folderPath.endsWith('\\')) {
+        job->folderPath += '/';
+    }
+    job->entries = model->getEntries();
+    // Qt's PNG writer maps quality 100..0 onto zlib levels 0..9
+    compression = std::clamp(compression, 0, 9);
+    job->quality = 100 - (compression * 91 + 8) / 9;
+    current = job;
+    emit started(folderPath, static_cast<int>(job->entries.size()));
+    pool.start([this, job]() { run(job); });
+}
+
+void TXDExporter::cancel() {
+    if (current) {
+        current->cancelled = true;
+        emit cancelled(current->folderPath);
+        current.reset();
+    }
+}
+
+void TXDExporter::run(std::shared_ptr<Job> job) {
+    const size_t count = job->entries.size();
+    std::atomic<int> done{0};
+    std::atomic<int> exported{0};
+    std::atomic<int> alphaExported{0};
+    std::atomic<int> failedCount{0};
+    const LibTXD::Pixels::ExtractRow extractAlpha = LibTXD::Pixels::getAlphaExtractor();
+
+    LibTXD::Parallel::parallelFor(count, 1, [&](size_t first, size_t last) {
+        for (size_t i = first; i < last; i++) {
+            if (job->cancelled) {
+                return;
+            }
+            TXDFileEntry& entry = job->entries[i];
+
+            // Edited textures already hold their pixels
+            std::vector<uint8_t> decoded;
+            const std::vector<uint8_t>* pixels = &entry.diffuse;
+            if (entry.diffuse.empty()) {
+                pixels = TXDModel::decodePixels(entry, decoded) ? &decoded : nullptr;
+            }
+
+            QString baseName = entry.name;
+            if (baseName.isEmpty()) {
+                baseName = QString("texture_%1").arg(i);
+            }
+
+            if (!pixels) {
+                failedCount++;
+            } else {
+                const int width = static_cast<int>(entry.width);
+                const int height = static_cast<int>(entry.height);
+                QImage image(pixels->data(), width, height, width * 4, QImage::Format_RGBA8888);
+                if (!image.save(job->folderPath + baseName + ".png", "PNG", job->quality)) {
+                    failedCount++;
+                } else {
+                    exported++;
+                    if (entry.hasAlpha) {
+                        QImage alpha(width, height, QImage::Format_Grayscale8);
+                        for (int y = 0; y < height; y++) {
+                            extractAlpha(image.constScanLine(y), alpha.scanLine(y), static_cast<size_t>(width));
+                        }
+                        // Don't count alpha failure as overall failure
+                        if (alpha.save(job->folderPath + baseName + "_alpha.png", "PNG", job->quality)) {
+                            alphaExported++;
+                        }
+                    }
+                }
+            }
+
+            // Free the pixel copy as soon as the texture is written
+            std::vector<uint8_t>().swap(entry.diffuse);
+
+            const int written = ++done;
+            QMetaObject::invokeMethod(this, [this, job, written, count]() {
+                if (current == job) {
+                    emit progress(written, static_cast<int>(count));
+                }
+            }, Qt::QueuedConnection);
+        }
+    });
+
+    if (job->cancelled) {
+        return;
+    }
+
+    const int exportedTotal = exported;
+    const int alphaTotal = alphaExported;
+    const int failedTotal = failedCount;
+    QMetaObject::invokeMethod(this, [this, job, exportedTotal, alphaTotal, failedTotal]() {
+        if (current != job) {
+            return;
+        }
+        current.reset();
+        emit finished(job->folderPath, exportedTotal, alphaTotal, failedTotal);
+    }, Qt::QueuedConnection);
+}
@@ -0,0 +1,53 @@
+#ifndef TXD_EXPORTER_H
+#define TXD_EXPORTER_H
+
+#include "TXDModel.h"
+#include <QObject>
+#include <QString>
+#include <QThreadPool>
+#include <memory>
+#include <atomic>
+#include <vector>
+
+// Exports every texture of the model as PNG in the background. The entries
+// are copied when the export starts; decoding, alpha extraction and PNG
+// encoding then run for several textures at once on the libtxd worker pool.
+// Textures with alpha also get an 8-bit greyscale "<name>_alpha.png".
+class TXDExporter : public QObject {
+    Q_OBJECT
+
+public:
+    // zlib levels: 0 = fastest/largest .. 9 = slowest/smallest
+    static constexpr int DefaultCompression = 1;
+
+    explicit TXDExporter(TXDModel* model, QObject* parent = nullptr);
+    // Cancels a running export and waits for it to stop
+    ~TXDExporter();
+
+    void exportAll(const QString& folderPath, int compression = DefaultCompression);
+    void cancel();
+    bool isExporting() const { return current != nullptr; }
+
+signals:
+    void started(const QString& folderPath, int textureCount);
+    // `done` textures of `total` have been written (or failed)
+    void progress(int done, int total);
+    void finished(const QString& folderPath, int exported, int alphaExported, int failedCount);
+    void cancelled(const QString& folderPath);
+
+private:
+    struct Job {
+        QString folderPath;
+        std::vector<TXDFileEntry> entries;
+        int quality = -1;  // QImageWriter quality for the compression level
+        std::atomic<bool> cancelled{false};
+    };
+
+    void run(std::shared_ptr<Job> job);
+
+    TXDModel* model;
+    QThreadPool pool;
+    std::shared_ptr<Job> current;
+};
+
+#endif // TXD_EXPORTER_H
@@ -0,0 +1,119 @@
+#include "TXDLoader.h"
+#include "TXDModel.h"
+#include "libtxd/txd_dictionary.h"
+#include "libtxd/txd_parallel.h"
+#include <QMetaObject>
+#include <mutex>
+#include <vector>
+
+TXDLoader::TXDLoader(TXDModel* model, QObject* parent)
+    : QObject(parent)
+    , model(model)
+{
+    // One coordinating thread; decoding fans out on the libtxd worker pool
+    pool.setMaxThreadCount(1);
+}
+
+TXDLoader::~TXDLoader() {
+    cancel();
+    pool.waitForDone();
+}
+
+void TXDLoader::load(const QString& filepath) {
+    cancel();
+
+    auto job = std::make_shared<Job>();
+    job->filepath = filepath;
+    current = job;
+    pool.start([this, job]() { run(job); });
+}
+
+void TXDLoader::cancel() {
+    if (current) {
+        current->cancelled = true;
+        current.reset();
+    }
+}
+
+void TXDLoader::run(std::shared_ptr<Job> job) {
+    if (job->cancelled) {
+        return;
+    }
+
+    auto dict = std::make_shared<LibTXD::TextureDictionary>();
+    if (!dict->load(job->filepath.toStdString())) {
+        QMetaObject::invokeMethod(this, [this, job]() {
+            if (current == job) {
+                current.reset();
+                emit failed(job->filepath);
+            }
+        }, Qt::QueuedConnection);
+        return;
+    }
+
+    const size_t count = dict->getTextureCount();
+    const uint32_t version = dict->getVersion();
+    const LibTXD::GameVersion gameVersion = dict->getGameVersion();
+    QMetaObject::invokeMethod(this, [this, job, count, version, gameVersion]() {
+        if (current == job) {
+            model->beginLoad(job->filepath, version, gameVersion);
+            emit started(job->filepath, static_cast<int>(count));
+        }
+    }, Qt::QueuedConnection);
+
+    // Entries wait in their slot until every earlier one is done, then go to
+    // the UI thread together. Posting under the lock keeps the batches in
+    // order. Pixels aren't decoded here: the list only needs thumbnails,
+    // which come from the smallest mip level when a row is painted.
+    std::mutex mutex;
+    std::vector<std::unique_ptr<TXDFileEntry>> ready(count);
+    std::vector<bool> done(count, false);
+    size_t nextToPost = 0;
+
+    LibTXD::Parallel::parallelFor(count, 1, [&](size_t first, size_t last) {
+        for (size_t i = first; i < last; i++) {
+            std::unique_ptr<TXDFileEntry> decoded;
+            if (!job->cancelled) {
+                decoded = std::make_unique<TXDFileEntry>();
+                if (!TXDModel::decodeTexture(*dict->getTexture(i), *decoded)) {
+                    decoded.reset();  // Undecodable textures are skipped
+                }
+            }
+
+            std::lock_guard<std::mutex> lock(mutex);
+            ready[i] = std::move(decoded);
+            done[i] = true;
+
+            auto batch = std::make_shared<std::vector<TXDFileEntry>>();
+            size_t begin = nextToPost;
+            while (nextToPost < count && done[nextToPost]) {
+                if (ready[nextToPost]) {
+                    batch->push_back(std::move(*ready[nextToPost]));
+                    ready[nextToPost].reset();
+                }
+                nextToPost++;
+            }
+            if (nextToPost == begin || job->cancelled) {
+                continue;
+            }
+
+            const int posted = static_cast<int>(nextToPost);
+            QMetaObject::invokeMethod(this, [this, job, batch, posted, count]() {
+                if (current != job) {
+                    return;
+                }
+                for (auto& entry : *batch) {
+                    model->appendLoadedTexture(std::move(entry));
+                }
+                emit progress(posted, static_cast<int>(count));
+            }, Qt::QueuedConnection);
+        }
+    });
+
+    QMetaObject::invokeMethod(this, [this, job]() {
+        if (current == job) {
+            current.reset();
+            emit finished(job->filepath, static_cast<int>(model->getTextureCount()));
+        }
+    }, Qt::QueuedConnection);
+}
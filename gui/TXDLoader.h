@@ -0,0 +1,48 @@
+#ifndef TXD_LOADER_H
+#define TXD_LOADER_H
+
+#include <QObject>
+#include <QString>
+#include <QThreadPool>
+#include <memory>
+#include <atomic>
+
+class TXDModel;
+
+// Loads a TXD file in the background. The file is parsed on a worker thread,
+// textures are decoded in parallel, and each decoded texture is appended to
+// the model on the UI thread as soon as it and all textures before it are
+// ready, so the list fills in file order while the load runs.
+// Starting another load or calling cancel() abandons the current one.
+class TXDLoader : public QObject {
+    Q_OBJECT
+
+public:
+    explicit TXDLoader(TXDModel* model, QObject* parent = nullptr);
+    ~TXDLoader();
+
+    void load(const QString& filepath);
+    void cancel();
+    bool isLoading() const { return current != nullptr; }
+
+signals:
+    // File parsed; the model has been reset and textures will follow
+    void started(const QString& filepath, int textureCount);
+    void progress(int loaded, int total);
+    void finished(const QString& filepath, int textureCount);
+    void failed(const QString& filepath);
+
+private:
+    struct Job {
+        QString filepath;
+        std::atomic<bool> cancelled{false};
+    };
+
+    void run(std::shared_ptr<Job> job);
+
+    TXDModel* model;
+    QThreadPool pool;
+    std::shared_ptr<Job> current;
+};
+
+#endif // TXD_LOADER_H
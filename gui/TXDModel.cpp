@@ -2,10 +2,12 @@
 #include "libtxd/txd_dictionary.h"
 #include "libtxd/txd_converter.h"
 #include "libtxd/txd_texture.h"
+#include "libtxd/txd_parallel.h"
 #include <QPixmap>
 #include <QImage>
 #include <cstring>
 #include <algorithm>
+#include <atomic>
 
 TXDModel::TXDModel(QObject* parent)
     : QObject(parent)
@@ -54,7 +56,10 @@ bool TXDModel::saveToFile(const QString& filepath) const {
 }
 
 void TXDModel::clear() {
+    emit modelAboutToBeReset();
     entries.clear();
+    cache.clear();
+    document++;
     gameVersion = LibTXD::GameVersion::UNKNOWN;
     version = 0;
     modified = false;
@@ -97,10 +102,10 @@ const TXDFileEntry* TXDModel::findTexture(const QString& name) const {
 }
 
 void TXDModel::addTexture(TXDFileEntry entry) {
+    entry.id = nextId++;
     entries.push_back(std::move(entry));
     setModified(true);
     emit textureAdded(entries.size() - 1);
-    emit modelChanged();
 }
 
 void TXDModel::removeTexture(size_t index) {
@@ -108,10 +113,11 @@ void TXDModel::removeTexture(size_t index) {
         return;
     }
 
+    emit textureAboutToBeRemoved(index);
+    cache.remove(entries[index].id);
     entries.erase(entries.begin() + index);
     setModified(true);
     emit textureRemoved(index);
-    emit modelChanged();
 }
 
 void TXDModel::removeTexture(const QString& name) {
@@ -124,13 +130,53 @@ void TXDModel::removeTexture(const QString& name) {
     }
 }
 
+void TXDModel::notifyTextureChanged(size_t index) {
+    if (index >= entries.size()) {
+        return;
+    }
+    setModified(true);
+    emit textureUpdated(index);
+}
+
 void TXDModel::setModified(bool modified) {
+    if (modified) {
+        revision++;
+    }
     if (this->modified != modified) {
         this->modified = modified;
         emit modifiedChanged(modified);
     }
 }
 
+void TXDModel::markSaved(const QString& filepath, uint64_t savedDocument, uint64_t savedRevision,
+                         std::vector<std::shared_ptr<const LibTXD::Texture>> written) {
+    if (savedDocument != document) {
+        return;  // A different file has been opened since
+    }
+    filePath = filepath;
+    if (savedRevision != revision) {
+        return;
+    }
+    
+    // What was written is now the canonical data for edited textures; their
+    // pixels move to the cache, where they can be evicted
+    if (written.size() == entries.size()) {
+        for (size_t i = 0; i < entries.size(); ++i) {
+            TXDFileEntry& entry = entries[i];
+            if (entry.diffuse.empty() || !written[i]) {
+                continue;
+            }
+            entry.source = std::move(written[i]);
+            entry.rasterFormat = entry.source->getRasterFormat();
+            entry.mipmapCount = entry.source->getMipmapCount();
+            entry.pixelsDirty = false;
+            cache.insert(entry.id, std::make_shared<const std::vector<uint8_t>>(std::move(entry.diffuse)));
+            entry.diffuse = std::vector<uint8_t>();
+        }
+    }
+    setModified(false);
+}
+
 void TXDModel::setFilePath(const QString& path) {
     if (filePath != path) {
         filePath = path;
@@ -143,145 +189,213 @@ bool TXDModel::loadFromDictionary(LibTXD::TextureDictionary* dict) {
     }
 
     for (size_t i = 0; i < dict->getTextureCount(); ++i) {
-        const LibTXD::Texture* libTexture = dict->getTexture(i);
-        if (!libTexture || libTexture->getMipmapCount() == 0) {
-            continue;
-        }
-
+        LibTXD::Texture* libTexture = dict->getTexture(i);
         TXDFileEntry entry;
-        
-        // Get metadata
-        const auto& mipmap = libTexture->getMipmap(0);
-        entry.name = QString::fromStdString(libTexture->getName());
-        entry.maskName = QString::fromStdString(libTexture->getMaskName());
-        entry.rasterFormat = libTexture->getRasterFormat();
-        entry.compressionEnabled = (libTexture->getCompression() != LibTXD::Compression::NONE);
-        entry.width = mipmap.width;
-        entry.height = mipmap.height;
-        entry.hasAlpha = libTexture->hasAlpha();
-        entry.mipmapCount = libTexture->getMipmapCount();
-        entry.filterFlags = libTexture->getFilterFlags();
-        entry.isNew = false;  // Loaded from file
-        entry.platform = libTexture->getPlatform();  // Preserve platform for correct writing
-        
-        // Decompress for display (using temp texture with mipmap 0 only)
-        LibTXD::Texture tempTexture;
-        tempTexture.setName(libTexture->getName());
-        tempTexture.setMaskName(libTexture->getMaskName());
-        tempTexture.setRasterFormat(libTexture->getRasterFormat());
-        tempTexture.setCompression(libTexture->getCompression());
-        tempTexture.setHasAlpha(libTexture->hasAlpha());
-        tempTexture.setFilterFlags(libTexture->getFilterFlags());
-        tempTexture.setPlatform(libTexture->getPlatform());
-        tempTexture.setDepth(libTexture->getDepth());
-        
-        // Handle palette if present
-        if (libTexture->getPaletteSize() > 0) {
-            tempTexture.setPalette(libTexture->getPalette(), libTexture->getPaletteSize());
+        auto pixels = std::make_shared<std::vector<uint8_t>>();
+        if (libTexture && decodeTexture(*libTexture, entry, pixels.get())) {
+            entry.id = nextId++;
+            cache.insert(entry.id, std::move(pixels));
+            entries.push_back(std::move(entry));
         }
-        
-        LibTXD::MipmapLevel tempMipmap;
-        tempMipmap.width = mipmap.width;
-        tempMipmap.height = mipmap.height;
-        tempMipmap.data = mipmap.data;
-        tempMipmap.dataSize = mipmap.dataSize;
-        tempTexture.addMipmap(std::move(tempMipmap));
-        
-        // Convert to RGBA8 (decompress if needed)
-        auto rgbaData = LibTXD::TextureConverter::convertToRGBA8(tempTexture, 0);
-        if (rgbaData) {
-            size_t dataSize = entry.width * entry.height * 4;
-            entry.diffuse.assign(rgbaData.get(), rgbaData.get() + dataSize);
-        } else {
+    }
+
+    return true;
+}
+
+bool TXDModel::decodeTexture(LibTXD::Texture& texture, TXDFileEntry& entry, std::vector<uint8_t>* pixels) {
+    if (texture.getMipmapCount() == 0) {
+        return false;
+    }
+    
+    // Get metadata
+    const auto& mipmap = static_cast<const LibTXD::Texture&>(texture).getMipmap(0);
+    entry.name = QString::fromStdString(texture.getName());
+    entry.maskName = QString::fromStdString(texture.getMaskName());
+    entry.rasterFormat = texture.getRasterFormat();
+    entry.compressionEnabled = (texture.getCompression() != LibTXD::Compression::NONE);
+    entry.width = mipmap.width;
+    entry.height = mipmap.height;
+    entry.hasAlpha = texture.hasAlpha();
+    entry.mipmapCount = texture.getMipmapCount();
+    entry.filterFlags = texture.getFilterFlags();
+    entry.isNew = false;  // Loaded from file
+    entry.platform = texture.getPlatform();  // Preserve platform for correct writing
+    
+    // Untouched textures are not pinned; the pixels only warm the cache
+    if (pixels) {
+        pixels->resize(static_cast<size_t>(entry.width) * entry.height * 4);
+        if (!LibTXD::TextureConverter::convertToRGBA8(texture, 0, pixels->data())) {
             // Conversion failed, skip this texture
-            continue;
+            return false;
         }
+    } else if (!LibTXD::TextureConverter::canConvert(texture)) {
+        return false;
+    }
+    
+    // Keep the encoded texture for pass-through saves
+    entry.source = std::make_shared<const LibTXD::Texture>(std::move(texture));
+    entry.pixelsDirty = false;
+    return true;
+}
 
-        entries.push_back(std::move(entry));
+void TXDModel::beginLoad(const QString& filepath, uint32_t fileVersion, LibTXD::GameVersion fileGameVersion) {
+    emit modelAboutToBeReset();
+    entries.clear();
+    cache.clear();
+    document++;
+    filePath = filepath;
+    version = fileVersion;
+    gameVersion = fileGameVersion;
+    modified = false;
+    emit modelChanged();
+    emit modifiedChanged(false);
+}
+
+void TXDModel::appendLoadedTexture(TXDFileEntry entry) {
+    entry.id = nextId++;
+    entries.push_back(std::move(entry));
+    emit textureLoaded(entries.size() - 1);
+}
+
+TXDModel::Pixels TXDModel::getPixels(size_t index) {
+    if (index >= entries.size()) {
+        return nullptr;
     }
+    TXDFileEntry& entry = entries[index];
+    
+    if (!entry.diffuse.empty()) {
+        // Pinned; a cached copy from before the edit is stale
+        cache.remove(entry.id);
+        return Pixels(Pixels(), &entry.diffuse);
+    }
+    
+    if (Pixels cached = cache.find(entry.id)) {
+        return cached;
+    }
+    auto pixels = std::make_shared<std::vector<uint8_t>>();
+    if (!decodePixels(entry, *pixels)) {
+        return nullptr;
+    }
+    cache.insert(entry.id, pixels);
+    return pixels;
+}
 
+bool TXDModel::decodePixels(const TXDFileEntry& entry, std::vector<uint8_t>& rgba) {
+    if (!entry.diffuse.empty()) {
+        rgba = entry.diffuse;
+        return true;
+    }
+    if (!entry.source) {
+        return false;
+    }
+    rgba.resize(static_cast<size_t>(entry.width) * entry.height * 4);
+    if (!LibTXD::TextureConverter::convertToRGBA8(*entry.source, 0, rgba.data())) {
+        rgba.clear();
+        return false;
+    }
     return true;
 }
 
+bool TXDModel::canPassThrough(const TXDFileEntry& entry) {
+    if (!entry.source || entry.pixelsDirty) {
+        return false;
+    }
+    
+    // Anything that changes how the pixels would be encoded forces a re-encode
+    const LibTXD::Texture& source = *entry.source;
+    bool sourceCompressed = source.getCompression() != LibTXD::Compression::NONE;
+    return entry.compressionEnabled == sourceCompressed
+        && entry.hasAlpha == source.hasAlpha()
+        && entry.platform == source.getPlatform()
+        && entry.width == source.getWidth()
+        && entry.height == source.getHeight();
+}
+
 std::unique_ptr<LibTXD::TextureDictionary> TXDModel::createDictionary() const {
     auto dict = std::make_unique<LibTXD::TextureDictionary>();
     dict->setVersion(version);
 
-    for (const auto& entry : entries) {
-        LibTXD::Texture texture;
-        texture.setName(entry.name.toStdString());
-        texture.setMaskName(entry.maskName.toStdString());
-        texture.setFilterFlags(entry.filterFlags);
-        texture.setHasAlpha(entry.hasAlpha);
-        texture.setPlatform(entry.platform);
-
-        // Determine compression based on compressionEnabled flag and alpha
-        LibTXD::Compression comp = LibTXD::Compression::NONE;
-        if (entry.compressionEnabled) {
-            comp = entry.hasAlpha ? LibTXD::Compression::DXT3 : LibTXD::Compression::DXT1;
-        }
-        texture.setCompression(comp);
-
-        // Generate mipmap data
-        LibTXD::MipmapLevel mipmap;
-        mipmap.width = entry.width;
-        mipmap.height = entry.height;
-        
-        if (comp != LibTXD::Compression::NONE) {
-            // Compress RGBA data to DXT
-            auto compressedData = LibTXD::TextureConverter::compressToDXT(
-                entry.diffuse.data(), entry.width, entry.height, comp, 1.0f);
-            if (compressedData) {
-                size_t compressedSize = LibTXD::TextureConverter::getCompressedDataSize(
-                    entry.width, entry.height, comp);
-                mipmap.data.assign(compressedData.get(), compressedData.get() + compressedSize);
-                mipmap.dataSize = mipmap.data.size();
-                
-                // DXT compressed: set raster format, depth 16
-                texture.setRasterFormat(entry.hasAlpha ? LibTXD::RasterFormat::B8G8R8A8 : LibTXD::RasterFormat::B8G8R8);
-                texture.setDepth(16);  // DXT uses 16-bit depth indicator
-            } else {
-                // Compression failed, fall back to uncompressed
-                comp = LibTXD::Compression::NONE;
-                texture.setCompression(comp);
-            }
-        }
-        
-        if (comp == LibTXD::Compression::NONE) {
-            // Uncompressed - format and depth depend on alpha
-            // NOTE: GTA uses BGR byte order, diffuse is stored as RGBA
-            // Must swap R and B when writing
-            size_t pixelCount = entry.width * entry.height;
-            
-            if (entry.hasAlpha) {
-                // B8G8R8A8 (32-bit BGRA)
-                texture.setRasterFormat(LibTXD::RasterFormat::B8G8R8A8);
-                texture.setDepth(32);
-                mipmap.data.resize(pixelCount * 4);
-                for (size_t i = 0; i < pixelCount; ++i) {
-                    mipmap.data[i * 4 + 0] = entry.diffuse[i * 4 + 2];  // B (from R)
-                    mipmap.data[i * 4 + 1] = entry.diffuse[i * 4 + 1];  // G
-                    mipmap.data[i * 4 + 2] = entry.diffuse[i * 4 + 0];  // R (from B)
-                    mipmap.data[i * 4 + 3] = entry.diffuse[i * 4 + 3];  // A
-                }
-                mipmap.dataSize = mipmap.data.size();
-            } else {
-                // B8G8R8 (24-bit BGR) - strip alpha channel
-                texture.setRasterFormat(LibTXD::RasterFormat::B8G8R8);
-                texture.setDepth(24);
-                mipmap.data.resize(pixelCount * 3);
-                for (size_t i = 0; i < pixelCount; ++i) {
-                    mipmap.data[i * 3 + 0] = entry.diffuse[i * 4 + 2];  // B (from R)
-                    mipmap.data[i * 3 + 1] = entry.diffuse[i * 4 + 1];  // G
-                    mipmap.data[i * 3 + 2] = entry.diffuse[i * 4 + 0];  // R (from B)
-                }
-                mipmap.dataSize = mipmap.data.size();
+    // Encode on the worker pool, then add in order
+    std::vector<LibTXD::Texture> textures(entries.size());
+    std::atomic<bool> ok{true};
+    LibTXD::Parallel::parallelFor(entries.size(), 1, [&](size_t first, size_t last) {
+        for (size_t i = first; i < last; i++) {
+            if (!encodeTexture(entries[i], textures[i])) {
+                ok = false;
             }
         }
-        
-        texture.addMipmap(std::move(mipmap));
+    });
+    if (!ok) {
+        return nullptr;
+    }
+    for (auto& texture : textures) {
         dict->addTexture(std::move(texture));
     }
 
     return dict;
 }
+
+bool TXDModel::encodeTexture(const TXDFileEntry& entry, LibTXD::Texture& texture) {
+    // Untouched textures keep their original encoding; only metadata is updated
+    auto passThrough = [&]() {
+        texture = entry.source->clone();
+        texture.setName(entry.name.toStdString());
+        texture.setMaskName(entry.maskName.toStdString());
+        texture.setFilterFlags(entry.filterFlags);
+        return true;
+    };
+    if (canPassThrough(entry)) {
+        return passThrough();
+    }
+    // If re-encoding fails, unedited pixels are written as they were rather
+    // than as an empty texture; edited ones fail the save
+    auto fail = [&]() {
+        return entry.source && !entry.pixelsDirty && passThrough();
+    };
+    
+    texture.setName(entry.name.toStdString());
+    texture.setMaskName(entry.maskName.toStdString());
+    texture.setFilterFlags(entry.filterFlags);
+    texture.setHasAlpha(entry.hasAlpha);
+    texture.setPlatform(entry.platform);
+
+    // Determine compression based on compressionEnabled flag and alpha
+    LibTXD::Compression comp = LibTXD::Compression::NONE;
+    if (entry.compressionEnabled) {
+        comp = entry.hasAlpha ? LibTXD::Compression::DXT3 : LibTXD::Compression::DXT1;
+    }
+    
+    // NOTE: GTA uses BGR byte order, diffuse is stored as RGBA; the packers swap
+    // Uncompressed without alpha is 24-bit BGR, DXT uses a 16-bit depth indicator
+    texture.setRasterFormat(entry.hasAlpha ? LibTXD::RasterFormat::B8G8R8A8 : LibTXD::RasterFormat::B8G8R8);
+    auto setFormat = [&](LibTXD::Compression c) {
+        texture.setCompression(c);
+        texture.setDepth(c != LibTXD::Compression::NONE ? 16 : (entry.hasAlpha ? 32 : 24));
+    };
+    
+    // Re-encoding an untouched texture (e.g. compression toggled) starts
+    // from its decoded source
+    std::vector<uint8_t> decoded;
+    const uint8_t* rgba = entry.diffuse.data();
+    if (entry.diffuse.empty()) {
+        if (!decodePixels(entry, decoded)) {
+            return fail();
+        }
+        rgba = decoded.data();
+    }
+    
+    // Textures that had a mip chain (and new imports) get a full chain
+    // rebuilt from the edited pixels; the rest stay single-level
+    uint32_t levelCount = entry.mipmapCount > 1 ? 0 : 1;
+    
+    setFormat(comp);
+    bool encoded = LibTXD::TextureConverter::generateMipmaps(
+        texture, rgba, entry.width, entry.height, levelCount, 1.0f);
+    if (!encoded && comp != LibTXD::Compression::NONE) {
+        // Compression failed, fall back to uncompressed
+        setFormat(LibTXD::Compression::NONE);
+        encoded = LibTXD::TextureConverter::generateMipmaps(
+            texture, rgba, entry.width, entry.height, levelCount, 1.0f);
+    }
+    return encoded || fail();
+}
@@ -7,10 +7,12 @@
 #include <vector>
 #include <memory>
 #include "libtxd/txd_types.h"
+#include "TextureCache.h"
 
 // Forward declarations
 namespace LibTXD {
     class TextureDictionary;
+    class Texture;
 }
 
 // Simple texture entry - just holds data for presentation
@@ -30,35 +32,19 @@ struct TXDFileEntry {
     // Platform info (D3D8 for GTA3/VC, D3D9 for SA)
     LibTXD::Platform platform;
     
-    // Uncompressed data for display and editing (always RGBA8888)
+    // Pixels of new or edited textures (RGBA8888). Empty for untouched
+    // textures, which are decoded from `source` on demand through
+    // TXDModel::getPixels. Once filled this is the canonical image and stays
+    // pinned until it is written out.
     std::vector<uint8_t> diffuse;  // RGB + Alpha (if hasAlpha is true, alpha channel is meaningful)
     
-    // Helper: Get combined RGBA (for preview)
-    std::vector<uint8_t> getRGBA() const {
-        return diffuse;
-    }
+    // Texture as loaded from the file (null for new entries). Its encoded mips,
+    // palette, depth and raster format are written back verbatim on save unless
+    // the pixels or the encoding settings changed.
+    std::shared_ptr<const LibTXD::Texture> source;
+    bool pixelsDirty = false;  // Set whenever `diffuse` is edited
     
-    // Helper: Get RGB only (for diffuse view)
-    std::vector<uint8_t> getRGB() const {
-        std::vector<uint8_t> rgb;
-        rgb.reserve(width * height * 3);
-        for (size_t i = 0; i < diffuse.size(); i += 4) {
-            rgb.push_back(diffuse[i]);     // R
-            rgb.push_back(diffuse[i + 1]); // G
-            rgb.push_back(diffuse[i + 2]); // B
-        }
-        return rgb;
-    }
-    
-    // Helper: Get alpha channel only
-    std::vector<uint8_t> getAlpha() const {
-        std::vector<uint8_t> alpha;
-        alpha.reserve(width * height);
-        for (size_t i = 3; i < diffuse.size(); i += 4) {
-            alpha.push_back(diffuse[i]);
-        }
-        return alpha;
-    }
+    uint64_t id = 0;  // Assigned by TXDModel; keys the decoded-pixel cache
 };
 
 // Simple model - just holds data
@@ -71,6 +57,21 @@ public:
 
     // File operations
     bool loadFromFile(const QString& filepath);
+    
+    // Progressive loading (see TXDLoader): reset to an empty model for the
+    // file, then append decoded textures in file order. Neither marks the
+    // model as modified.
+    void beginLoad(const QString& filepath, uint32_t fileVersion, LibTXD::GameVersion fileGameVersion);
+    void appendLoadedTexture(TXDFileEntry entry);
+    
+    // Fill an entry from a loaded texture and move the texture into
+    // entry.source. Mipmap 0 is decoded into `pixels` if given, otherwise
+    // only checked to be decodable. Safe to call from worker threads.
+    static bool decodeTexture(LibTXD::Texture& texture, TXDFileEntry& entry,
+                              std::vector<uint8_t>* pixels = nullptr);
+    // Build the texture written for an entry, compressing it if needed.
+    // False if it could not be encoded. Safe to call from worker threads.
+    static bool encodeTexture(const TXDFileEntry& entry, LibTXD::Texture& texture);
     bool saveToFile(const QString& filepath) const;
     void clear();
 
@@ -79,6 +80,12 @@ public:
     uint32_t getVersion() const { return version; }
     bool isModified() const { return modified; }
     QString getFilePath() const { return filePath; }
+    // Copy of all entries, e.g. to save in the background while editing goes on
+    std::vector<TXDFileEntry> getEntries() const { return entries; }
+    // Change counters: `document` moves when another file replaces the
+    // contents, `revision` on every edit
+    uint64_t getDocument() const { return document; }
+    uint64_t getRevision() const { return revision; }
     void setVersion(uint32_t v) { version = v; setModified(true); }
     void setGameVersion(LibTXD::GameVersion gv) { gameVersion = gv; }
 
@@ -89,33 +96,63 @@ public:
     TXDFileEntry* findTexture(const QString& name);
     const TXDFileEntry* findTexture(const QString& name) const;
 
+    // Decoded pixels (RGBA8888) of a texture. Untouched textures are decoded
+    // from their source and kept in an LRU cache; the returned buffer stays
+    // valid until the entry itself is edited or removed.
+    using Pixels = TextureCache::Pixels;
+    Pixels getPixels(size_t index);
+    // Decode an entry's image without touching the cache; used to pin pixels
+    // in entry.diffuse before editing them. Safe to call from worker threads.
+    static bool decodePixels(const TXDFileEntry& entry, std::vector<uint8_t>& rgba);
+    // Bytes of decoded pixels kept for untouched textures
+    void setCacheBudget(size_t bytes) { cache.setBudget(bytes); }
+    
     // Texture management
     void addTexture(TXDFileEntry entry);
     void removeTexture(size_t index);
     void removeTexture(const QString& name);
+    // Call after editing an entry in place; marks the model modified
+    void notifyTextureChanged(size_t index);
 
     // Model state
     void setModified(bool modified);
     void setFilePath(const QString& path);
+    // A save of the given document/revision finished: adopt the path, and
+    // clear the modified flag unless there were edits since the snapshot.
+    // In that case `written` (one texture per entry) becomes the source of
+    // the edited entries, which releases their pinned pixels.
+    void markSaved(const QString& filepath, uint64_t savedDocument, uint64_t savedRevision,
+                   std::vector<std::shared_ptr<const LibTXD::Texture>> written = {});
 
 signals:
     void textureAdded(size_t index);
+    void textureLoaded(size_t index);  // Appended by a progressive load
+    void textureAboutToBeRemoved(size_t index);
     void textureRemoved(size_t index);
     void textureUpdated(size_t index);
+    // All entries are about to be replaced / have been replaced
+    void modelAboutToBeReset();
     void modelChanged();
     void modifiedChanged(bool modified);
 
 private:
     // Load from LibTXD::TextureDictionary - decompress immediately
+    // Textures are moved out of the dictionary into the entries' `source`
     bool loadFromDictionary(LibTXD::TextureDictionary* dict);
     // Save to LibTXD::TextureDictionary - compress on-the-fly
     std::unique_ptr<LibTXD::TextureDictionary> createDictionary() const;
+    // True if the entry can be written from its source texture without re-encoding
+    static bool canPassThrough(const TXDFileEntry& entry);
 
     std::vector<TXDFileEntry> entries;
     LibTXD::GameVersion gameVersion;
     uint32_t version;
     bool modified;
     QString filePath;
+    uint64_t document = 0;
+    uint64_t revision = 0;
+    uint64_t nextId = 1;
+    TextureCache cache;
 };
 
 #endif // TXD_MODEL_H
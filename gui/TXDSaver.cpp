@@ -0,0 +1,104 @@
+#include "TXDSaver.h"
+#include "TXDModel.h"
+#include "libtxd/txd_dictionary.h"
+#include "libtxd/txd_texture.h"
+#include "libtxd/txd_parallel.h"
+#include <QMetaObject>
+
+TXDSaver::TXDSaver(TXDModel* model, QObject* parent)
+    : QObject(parent)
+    , model(model)
+{
+    // Jobs run one after another so saves land in the order they were made;
+    // encoding fans out on the libtxd worker pool
+    pool.setMaxThreadCount(1);
+}
+
+TXDSaver::~TXDSaver() {
+    // Don't drop the user's data on exit
+    pool.waitForDone();
+}
+
+void TXDSaver::save(const QString& filepath) {
+    cancel();
+
+    auto job = std::make_shared<Job>();
+    job->filepath = filepath;
+    job->entries = model->getEntries();
+    job->version = model->getVersion();
+    job->document = model->getDocument();
+    job->revision = model->getRevision();
+    current = job;
+    emit started(filepath, static_cast<int>(job->entries.size()));
+    pool.start([this, job]() { run(job); });
+}
+
+void TXDSaver::cancel() {
+    if (current) {
+        current->cancelled = true;
+        emit cancelled(current->filepath);
+        current.reset();
+    }
+}
+
+void TXDSaver::run(std::shared_ptr<Job> job) {
+    const size_t count = job->entries.size();
+    std::vector<LibTXD::Texture> textures(count);
+    std::atomic<size_t> encoded{0};
+    std::atomic<bool> encodeFailed{false};
+
+    LibTXD::Parallel::parallelFor(count, 1, [&](size_t first, size_t last) {
+        for (size_t i = first; i < last; i++) {
+            if (job->cancelled) {
+                return;
+            }
+            if (!TXDModel::encodeTexture(job->entries[i], textures[i])) {
+                encodeFailed = true;
+            }
+
+            const int done = static_cast<int>(++encoded);
+            QMetaObject::invokeMethod(this, [this, job, done, count]() {
+                if (current == job) {
+                    emit progress(done, static_cast<int>(count));
+                }
+            }, Qt::QueuedConnection);
+        }
+    });
+
+    if (job->cancelled) {
+        return;
+    }
+
+    LibTXD::TextureDictionary dict;
+    dict.setVersion(job->version);
+    for (auto& texture : textures) {
+        dict.addTexture(std::move(texture));
+    }
+    // Free the pixel copies before the writer runs
+    job->entries.clear();
+    job->entries.shrink_to_fit();
+
+    // A texture that could not be encoded fails the save instead of being
+    // written without pixels
+    const bool saved = !job->cancelled && !encodeFailed && dict.save(job->filepath.toStdString());
+    
+    // Hand the written textures back so edited entries can drop their pixels
+    auto written = std::make_shared<std::vector<std::shared_ptr<const LibTXD::Texture>>>();
+    if (saved) {
+        for (size_t i = 0; i < dict.getTextureCount(); i++) {
+            written->push_back(std::make_shared<const LibTXD::Texture>(std::move(*dict.getTexture(i))));
+        }
+    }
+    QMetaObject::invokeMethod(this, [this, job, saved, written]() {
+        if (current != job) {
+            return;
+        }
+        current.reset();
+        if (saved) {
+            model->markSaved(job->filepath, job->document, job->revision, std::move(*written));
+            emit finished(job->filepath);
+        } else {
+            emit failed(job->filepath);
+        }
+    }, Qt::QueuedConnection);
+}
@@ -0,0 +1,56 @@
+#ifndef TXD_SAVER_H
+#define TXD_SAVER_H
+
+#include "TXDModel.h"
+#include <QObject>
+#include <QString>
+#include <QThreadPool>
+#include <memory>
+#include <atomic>
+#include <vector>
+#include <cstdint>
+
+// Saves a TXD file in the background. The model's entries are copied when the
+// save starts, so editing and browsing can continue while textures are
+// compressed in parallel on a worker thread. The file is written next to the
+// target and renamed over it only once complete.
+// Starting another save or calling cancel() abandons the current one; the
+// target file is left as it was.
+class TXDSaver : public QObject {
+    Q_OBJECT
+
+public:
+    explicit TXDSaver(TXDModel* model, QObject* parent = nullptr);
+    // Waits for a running save to finish writing
+    ~TXDSaver();
+
+    void save(const QString& filepath);
+    void cancel();
+    bool isSaving() const { return current != nullptr; }
+
+signals:
+    void started(const QString& filepath, int textureCount);
+    // `done` textures of `total` have been encoded
+    void progress(int done, int total);
+    void finished(const QString& filepath);
+    void failed(const QString& filepath);
+    void cancelled(const QString& filepath);
+
+private:
+    struct Job {
+        QString filepath;
+        std::vector<TXDFileEntry> entries;
+        uint32_t version = 0;
+        uint64_t document = 0;
+        uint64_t revision = 0;
+        std::atomic<bool> cancelled{false};
+    };
+
+    void run(std::shared_ptr<Job> job);
+
+    TXDModel* model;
+    QThreadPool pool;
+    std::shared_ptr<Job> current;
+};
+
+#endif // TXD_SAVER_H
@@ -0,0 +1,51 @@
+#include "TextureCache.h"
+
+TextureCache::Pixels TextureCache::find(uint64_t key) {
+    auto it = index.find(key);
+    if (it == index.end()) {
+        return nullptr;
+    }
+    items.splice(items.begin(), items, it->second);
+    return it->second->second;
+}
+
+void TextureCache::insert(uint64_t key, Pixels pixels) {
+    remove(key);
+    if (!pixels) {
+        return;
+    }
+    usage += pixels->size();
+    items.emplace_front(key, std::move(pixels));
+    index[key] = items.begin();
+    evict();
+}
+
+void TextureCache::remove(uint64_t key) {
+    auto it = index.find(key);
+    if (it == index.end()) {
+        return;
+    }
+    usage -= it->second->second->size();
+    items.erase(it->second);
+    index.erase(it);
+}
+
+void TextureCache::clear() {
+    items.clear();
+    index.clear();
+    usage = 0;
+}
+
+void TextureCache::setBudget(size_t bytes) {
+    budget = bytes;
+    evict();
+}
+
+void TextureCache::evict() {
+    while (usage > budget && items.size() > 1) {
+        const Item& oldest = items.back();
+        usage -= oldest.second->size();
+        index.erase(oldest.first);
+        items.pop_back();
+    }
+}
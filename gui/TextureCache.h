@@ -0,0 +1,45 @@
+#ifndef TEXTURE_CACHE_H
+#define TEXTURE_CACHE_H
+
+#include <cstdint>
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Least-recently-used store of decoded RGBA8 pixels, bounded by a byte budget.
+// Buffers are shared, so pixels handed out stay valid after being evicted.
+// The most recently inserted buffer is always kept, even if it alone exceeds
+// the budget.
+class TextureCache {
+public:
+    using Pixels = std::shared_ptr<const std::vector<uint8_t>>;
+
+    static constexpr size_t DefaultBudget = size_t(512) << 20;
+
+    explicit TextureCache(size_t budget = DefaultBudget) : budget(budget) {}
+
+    // Returns null if `key` is not cached; a hit becomes the most recent
+    Pixels find(uint64_t key);
+    void insert(uint64_t key, Pixels pixels);
+    void remove(uint64_t key);
+    void clear();
+
+    void setBudget(size_t bytes);
+    size_t getBudget() const { return budget; }
+    size_t getUsage() const { return usage; }
+
+private:
+    using Item = std::pair<uint64_t, Pixels>;
+
+    void evict();
+
+    std::list<Item> items;  // Most recent first
+    std::unordered_map<uint64_t, std::list<Item>::iterator> index;
+    size_t budget;
+    size_t usage = 0;
+};
+
+#endif // TEXTURE_CACHE_H
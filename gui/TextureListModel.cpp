@@ -0,0 +1,143 @@
+#include "TextureListModel.h"
+#include "TXDModel.h"
+#include "libtxd/txd_converter.h"
+#include <QImage>
+#include <QPainter>
+#include <QIcon>
+
+TextureListModel::TextureListModel(TXDModel* model, QObject* parent)
+    : QAbstractListModel(parent)
+    , txdModel(model)
+{
+    connect(txdModel, &TXDModel::modelAboutToBeReset, this, [this]() {
+        if (!resetting) {
+            beginResetModel();
+            resetting = true;
+        }
+    });
+    connect(txdModel, &TXDModel::modelChanged, this, [this]() {
+        if (!resetting) {
+            beginResetModel();
+        }
+        thumbnails.clear();
+        resetting = false;
+        endResetModel();
+    });
+    
+    // Textures are only ever appended, so announcing the row after the push
+    // is safe: views don't look at it before endInsertRows
+    auto appended = [this](size_t index) {
+        int row = static_cast<int>(index);
+        beginInsertRows(QModelIndex(), row, row);
+        endInsertRows();
+    };
+    connect(txdModel, &TXDModel::textureAdded, this, appended);
+    connect(txdModel, &TXDModel::textureLoaded, this, appended);
+    
+    connect(txdModel, &TXDModel::textureAboutToBeRemoved, this, [this](size_t index) {
+        int row = static_cast<int>(index);
+        if (const TXDFileEntry* entry = txdModel->getTexture(index)) {
+            thumbnails.remove(entry->id);
+        }
+        beginRemoveRows(QModelIndex(), row, row);
+    });
+    connect(txdModel, &TXDModel::textureRemoved, this, [this](size_t) {
+        endRemoveRows();
+    });
+    
+    connect(txdModel, &TXDModel::textureUpdated, this, [this](size_t index) {
+        if (const TXDFileEntry* entry = txdModel->getTexture(index)) {
+            thumbnails.remove(entry->id);
+        }
+        QModelIndex changed = this->index(static_cast<int>(index));
+        emit dataChanged(changed, changed);
+    });
+}
+
+int TextureListModel::rowCount(const QModelIndex& parent) const {
+    if (parent.isValid() || resetting) {
+        return 0;
+    }
+    return static_cast<int>(txdModel->getTextureCount());
+}
+
+QVariant TextureListModel::data(const QModelIndex& index, int role) const {
+    if (!index.isValid() || index.row() >= rowCount()) {
+        return QVariant();
+    }
+    const TXDFileEntry* entry = txdModel->getTexture(static_cast<size_t>(index.row()));
+    if (!entry) {
+        return QVariant();
+    }
+    
+    switch (role) {
+    case Qt::DisplayRole:
+        return formatTextureInfo(*entry);
+    case Qt::DecorationRole: {
+        // Only visible rows are painted, so only they pay for a thumbnail
+        auto it = thumbnails.find(entry->id);
+        if (it == thumbnails.end()) {
+            QPixmap thumbnail;
+            std::vector<uint8_t> rgba;
+            uint32_t width = 0, height = 0;
+            if (entry->diffuse.empty() && entry->source &&
+                LibTXD::TextureConverter::convertToThumbnail(*entry->source, ThumbnailSize, rgba, width, height)) {
+                // Untouched texture: decode a small mip level, not the full image
+                thumbnail = createThumbnail(rgba.data(), width, height, entry->hasAlpha);
+            } else if (TXDModel::Pixels pixels = txdModel->getPixels(static_cast<size_t>(index.row()))) {
+                thumbnail = createThumbnail(pixels->data(), entry->width, entry->height, entry->hasAlpha);
+            }
+            it = thumbnails.insert(entry->id, thumbnail);
+        }
+        return it->isNull() ? QVariant() : QVariant(QIcon(*it));
+    }
+    case Qt::UserRole:
+        // Texture index, same as the row
+        return index.row();
+    default:
+        return QVariant();
+    }
+}
+
+QString TextureListModel::formatTextureInfo(const TXDFileEntry& entry) {
+    QString compressionStr = entry.compressionEnabled ? 
+        (entry.hasAlpha ? "DXT3" : "DXT1") : "None";
+    
+    QString info = QString("Name: %1\nSize: %2x%3px\nHas alpha: %4\nCompression: %5")
+        .arg(entry.name)
+        .arg(entry.width)
+        .arg(entry.height)
+        .arg(entry.hasAlpha ? "Y" : "N")
+        .arg(compressionStr);
+    
+    return info;
+}
+
+QPixmap TextureListModel::createThumbnail(const uint8_t* rgbaData, int width, int height, bool hasAlpha) {
+    if (!rgbaData || width <= 0 || height <= 0) {
+        return QPixmap();
+    }
+    
+    // Create QImage directly from RGBA data
+    QImage image(rgbaData, width, height, QImage::Format_RGBA8888);
+    QImage imageCopy = image.copy();
+    
+    // If alpha is disabled, composite onto black background
+    if (!hasAlpha) {
+        QPixmap result(width, height);
+        result.fill(Qt::black);
+        QPainter painter(&result);
+        painter.setCompositionMode(QPainter::CompositionMode_SourceOver);
+        painter.drawImage(0, 0, imageCopy);
+        painter.end();
+        imageCopy = result.toImage();
+    }
+    
+    // Create thumbnail (32x32 max)
+    QPixmap pixmap = QPixmap::fromImage(imageCopy);
+    if (pixmap.width() > ThumbnailSize || pixmap.height() > ThumbnailSize) {
+        pixmap = pixmap.scaled(ThumbnailSize, ThumbnailSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+    }
+    
+    return pixmap;
+}
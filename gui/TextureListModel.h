@@ -0,0 +1,37 @@
+#ifndef TEXTURE_LIST_MODEL_H
+#define TEXTURE_LIST_MODEL_H
+
+#include <QAbstractListModel>
+#include <QHash>
+#include <QPixmap>
+#include <cstdint>
+
+class TXDModel;
+struct TXDFileEntry;
+
+// Item model over a TXDModel: one row per texture, in model order. Rows follow
+// the TXDModel's add/remove/update signals, so only changed rows are
+// refreshed. Thumbnails are built the first time a row is painted and kept
+// until its texture changes; untouched textures are thumbnailed from their
+// smallest mip level that still covers the icon.
+class TextureListModel : public QAbstractListModel {
+    Q_OBJECT
+
+public:
+    explicit TextureListModel(TXDModel* model, QObject* parent = nullptr);
+
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+
+private:
+    static constexpr int ThumbnailSize = 32;
+
+    static QString formatTextureInfo(const TXDFileEntry& entry);
+    static QPixmap createThumbnail(const uint8_t* rgbaData, int width, int height, bool hasAlpha);
+
+    TXDModel* txdModel;
+    mutable QHash<quint64, QPixmap> thumbnails;  // By TXDFileEntry::id
+    bool resetting = false;
+};
+
+#endif // TEXTURE_LIST_MODEL_H
@@ -1,132 +1,54 @@
 #include "TextureListWidget.h"
+#include "TextureListModel.h"
 #include "TXDModel.h"
-#include <QPixmap>
-#include <QImage>
-#include <QString>
-#include <QPainter>
-#include <QStyleOptionViewItem>
-#include <QModelIndex>
-#include <QPalette>
-#include <QStyle>
+#include <QItemSelectionModel>
 #include <QContextMenuEvent>
 #include <QMenu>
 #include <QAction>
 
 TextureListWidget::TextureListWidget(QWidget *parent)
-    : QListWidget(parent) {
-    setViewMode(QListWidget::ListMode);
+    : QListView(parent) {
+    setViewMode(QListView::ListMode);
     setIconSize(QSize(32, 32));
     setSpacing(2);
+    // Every row is 80px high; don't measure rows that aren't shown
+    setUniformItemSizes(true);
+    setSelectionMode(QAbstractItemView::SingleSelection);
     setItemDelegate(new TextureListItemDelegate(this));
 }
 
-QString TextureListWidget::formatTextureInfo(const TXDFileEntry* entry) const {
-    if (!entry) {
-        return "Invalid texture";
-    }
-    
-    QString compressionStr = entry->compressionEnabled ? 
-        (entry->hasAlpha ? "DXT3" : "DXT1") : "None";
-    
-    QString info = QString("Name: %1\nSize: %2x%3px\nHas alpha: %4\nCompression: %5")
-        .arg(entry->name)
-        .arg(entry->width)
-        .arg(entry->height)
-        .arg(entry->hasAlpha ? "Y" : "N")
-        .arg(compressionStr);
-    
-    return info;
+void TextureListWidget::setTextureModel(TXDModel* model) {
+    listModel = new TextureListModel(model, this);
+    setModel(listModel);
+    connect(selectionModel(), &QItemSelectionModel::currentRowChanged, this,
+            [this](const QModelIndex& current, const QModelIndex&) {
+        emit currentRowChanged(current.isValid() ? current.row() : -1);
+    });
 }
 
-QPixmap TextureListWidget::createThumbnail(const uint8_t* rgbaData, int width, int height, bool hasAlpha) const {
-    if (!rgbaData || width <= 0 || height <= 0) {
-        return QPixmap();
-    }
-    
-    // Create QImage directly from RGBA data
-    QImage image(rgbaData, width, height, QImage::Format_RGBA8888);
-    QImage imageCopy = image.copy();
-    
-    // If alpha is disabled, composite onto black background
-    if (!hasAlpha) {
-        QPixmap result(width, height);
-        result.fill(Qt::black);
-        QPainter painter(&result);
-        painter.setCompositionMode(QPainter::CompositionMode_SourceOver);
-        painter.drawImage(0, 0, imageCopy);
-        painter.end();
-        imageCopy = result.toImage();
-    }
-    
-    // Create thumbnail (32x32 max)
-    QPixmap pixmap = QPixmap::fromImage(imageCopy);
-    if (pixmap.width() > 32 || pixmap.height() > 32) {
-        pixmap = pixmap.scaled(32, 32, Qt::KeepAspectRatio, Qt::SmoothTransformation);
-    }
-    
-    return pixmap;
+int TextureListWidget::count() const {
+    return listModel ? listModel->rowCount() : 0;
 }
 
-void TextureListWidget::addTexture(const TXDFileEntry* entry, int index) {
-    if (!entry) {
-        return;
-    }
-    
-    QString info = formatTextureInfo(entry);
-    
-    QListWidgetItem* item = new QListWidgetItem(info, this);
-    
-    // Create thumbnail from RGBA data
-    if (!entry->diffuse.empty()) {
-        QPixmap thumbnail = createThumbnail(entry->diffuse.data(), entry->width, entry->height, entry->hasAlpha);
-    if (!thumbnail.isNull()) {
-        item->setIcon(QIcon(thumbnail));
-        }
-    }
-    
-    // Store index as data
-    item->setData(Qt::UserRole, index);
-    
-    // Set item height to accommodate multi-line text
-    item->setSizeHint(QSize(item->sizeHint().width(), 80));
-    
-    addItem(item);
+int TextureListWidget::currentRow() const {
+    QModelIndex current = currentIndex();
+    return current.isValid() ? current.row() : -1;
 }
 
-void TextureListWidget::updateTexture(const TXDFileEntry* entry, int index) {
-    QListWidgetItem* item = nullptr;
-    for (int i = 0; i < count(); i++) {
-        QListWidgetItem* it = this->item(i);
-        if (it && it->data(Qt::UserRole).toInt() == index) {
-            item = it;
-            break;
-        }
-    }
-    
-    if (item && entry) {
-        QString info = formatTextureInfo(entry);
-        item->setText(info);
-        
-        if (!entry->diffuse.empty()) {
-            QPixmap thumbnail = createThumbnail(entry->diffuse.data(), entry->width, entry->height, entry->hasAlpha);
-        if (!thumbnail.isNull()) {
-            item->setIcon(QIcon(thumbnail));
-            }
-        }
+void TextureListWidget::setCurrentRow(int row) {
+    if (!listModel) {
+        return;
     }
-}
-
-void TextureListWidget::clearTextures() {
-    clear();
+    setCurrentIndex(listModel->index(row));
 }
 
 void TextureListWidget::contextMenuEvent(QContextMenuEvent* event) {
-    QListWidgetItem* item = itemAt(event->pos());
-    if (!item) {
+    QModelIndex item = indexAt(event->pos());
+    if (!item.isValid()) {
         return;
     }
     
-    int index = item->data(Qt::UserRole).toInt();
+    int index = item.row();
     
     QMenu menu(this);
     
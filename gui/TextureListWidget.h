@@ -1,19 +1,16 @@
 #ifndef TEXTURELISTWIDGET_H
 #define TEXTURELISTWIDGET_H
 
-#include <QListWidget>
-#include <QListWidgetItem>
+#include <QListView>
 #include <QStyledItemDelegate>
 #include <QPainter>
 #include <QStyleOptionViewItem>
 #include <QModelIndex>
 #include <QStyle>
 #include <QApplication>
-#include "libtxd/txd_texture.h"
-#include "libtxd/txd_converter.h"
 
-// Forward declaration
-struct TXDFileEntry;
+class TXDModel;
+class TextureListModel;
 
 // Custom delegate to align icons to top
 class TextureListItemDelegate : public QStyledItemDelegate {
@@ -63,17 +60,21 @@ public:
     }
 };
 
-class TextureListWidget : public QListWidget {
+// Texture list view. Rows come from a TextureListModel over the TXDModel and
+// row numbers are texture indices.
+class TextureListWidget : public QListView {
     Q_OBJECT
 
 public:
     explicit TextureListWidget(QWidget *parent = nullptr);
     
-    void addTexture(const TXDFileEntry* entry, int index);
-    void updateTexture(const TXDFileEntry* entry, int index);
-    void clearTextures();
+    void setTextureModel(TXDModel* model);
+    int count() const;
+    int currentRow() const;
+    void setCurrentRow(int row);
 
 signals:
+    void currentRowChanged(int row);
     void exportRequested(int index);
     void importRequested(int index);
     void replaceDiffuseRequested(int index);
@@ -84,9 +85,7 @@ protected:
     void contextMenuEvent(QContextMenuEvent* event) override;
 
 private:
-    QString formatTextureInfo(const TXDFileEntry* entry) const;
-    QPixmap createThumbnail(const uint8_t* rgbaData, int width, int height, bool hasAlpha) const;
+    TextureListModel* listModel = nullptr;
 };
 
 #endif // TEXTURELISTWIDGET_H
-
@@ -1,6 +1,6 @@
 #include "TexturePreviewWidget.h"
+#include "libtxd/txd_pixels.h"
 #include <QPainter>
-#include <QPixmap>
 #include <QImage>
 
 TexturePreviewWidget::TexturePreviewWidget(QWidget *parent)
@@ -15,6 +15,9 @@ TexturePreviewWidget::TexturePreviewWidget(QWidget *parent)
     , mixedTabIndex(-1)
     , alphaTabsVisible(false)
     , currentHasAlpha(false)
+    , imageTabStale(false)
+    , alphaTabStale(false)
+    , mixedTabStale(false)
 {
     mainLayout = new QVBoxLayout(this);
     mainLayout->setContentsMargins(0, 0, 0, 0);
@@ -58,13 +61,18 @@ void TexturePreviewWidget::setTexture(const uint8_t* rgbaData, int width, int he
         mainLayout->addWidget(tabWidget);
     }
     
+    // One copy of the pixels for all tabs; nothing is drawn until a tab is
+    // shown. Set before the tabs change, as removing one switches tabs.
+    image = QImage(rgbaData, width, height, QImage::Format_RGBA8888).copy();
+    currentHasAlpha = hasAlpha;
+    imageTabStale = true;
+    alphaTabStale = hasAlpha;
+    mixedTabStale = hasAlpha;
+    
     // Show tab widget
     placeholderWidget->hide();
     tabWidget->show();
     
-    // Store alpha state
-    currentHasAlpha = hasAlpha;
-    
     // Add or remove alpha/mixed tabs based on alpha channel
     if (hasAlpha && !alphaTabsVisible) {
         alphaTabIndex = tabWidget->addTab(alphaView, "Alpha / mask");
@@ -76,6 +84,8 @@ void TexturePreviewWidget::setTexture(const uint8_t* rgbaData, int width, int he
         alphaTabIndex = -1;
         mixedTabIndex = -1;
         alphaTabsVisible = false;
+        alphaView->clear();
+        mixedView->clear();
     }
     
     // Reset views
@@ -85,15 +95,11 @@ void TexturePreviewWidget::setTexture(const uint8_t* rgbaData, int width, int he
         mixedView->resetHasBeenShown();
     }
     
-    // Update tabs
-    updateImageTab(rgbaData, width, height);
-    if (hasAlpha) {
-        updateAlphaTab(rgbaData, width, height);
-        updateMixedTab(rgbaData, width, height);
-    }
+    // Only the visible tab is built now
+    int currentTab = tabWidget->currentIndex();
+    updateTab(currentTab);
     
     // Reset current tab to 100%
-    int currentTab = tabWidget->currentIndex();
     if (currentTab == 0) {
         imageView->zoom100();
     } else if (hasAlpha && currentTab == alphaTabIndex) {
@@ -103,70 +109,71 @@ void TexturePreviewWidget::setTexture(const uint8_t* rgbaData, int width, int he
     }
 }
 
-void TexturePreviewWidget::updateImageTab(const uint8_t* rgbaData, int width, int height) {
-    QPixmap pixmap = createImagePixmap(rgbaData, width, height, currentHasAlpha, false, false);
-    imageView->setPixmap(pixmap);
+void TexturePreviewWidget::updateTab(int index) {
+    if (image.isNull()) {
+        return;
+    }
+    
+    if (index == 0 && imageTabStale) {
+        imageView->setImage(createImageView());
+        imageTabStale = false;
+    } else if (alphaTabsVisible && index == alphaTabIndex && alphaTabStale) {
+        alphaView->setImage(createAlphaView());
+        alphaTabStale = false;
+    } else if (alphaTabsVisible && index == mixedTabIndex && mixedTabStale) {
+        mixedView->setImage(createMixedView());
+        mixedTabStale = false;
+    }
 }
 
-void TexturePreviewWidget::updateAlphaTab(const uint8_t* rgbaData, int width, int height) {
-    QPixmap pixmap = createImagePixmap(rgbaData, width, height, currentHasAlpha, true, false);
-    alphaView->setPixmap(pixmap);
+QImage TexturePreviewWidget::createImageView() const {
+    if (currentHasAlpha) {
+        return image;
+    }
+    
+    // Alpha is disabled - composite onto black background
+    QImage result(image.width(), image.height(), QImage::Format_RGB32);
+    result.fill(Qt::black);
+    QPainter painter(&result);
+    painter.setCompositionMode(QPainter::CompositionMode_SourceOver);
+    painter.drawImage(0, 0, image);
+    painter.end();
+    return result;
 }
 
-void TexturePreviewWidget::updateMixedTab(const uint8_t* rgbaData, int width, int height) {
-    QPixmap pixmap = createImagePixmap(rgbaData, width, height, currentHasAlpha, false, true);
-    mixedView->setPixmap(pixmap);
+QImage TexturePreviewWidget::createAlphaView() const {
+    // Show only alpha channel as grayscale
+    QImage alpha(image.width(), image.height(), QImage::Format_Grayscale8);
+    auto extract = LibTXD::Pixels::getAlphaExtractor();
+    for (int y = 0; y < image.height(); y++) {
+        extract(image.constScanLine(y), alpha.scanLine(y), static_cast<size_t>(image.width()));
+    }
+    return alpha;
 }
 
-QPixmap TexturePreviewWidget::createImagePixmap(const uint8_t* rgbaData, int width, int height, bool hasAlpha, bool showAlpha, bool mixed) {
-    if (!rgbaData || width <= 0 || height <= 0) {
-        return QPixmap();
-    }
-    
-    // Create QImage directly from RGBA data
-    QImage image(rgbaData, width, height, QImage::Format_RGBA8888);
-    QImage imageCopy = image.copy(); // Make a copy
-    
-    if (showAlpha) {
-        // Show only alpha channel as grayscale
-        for (int y = 0; y < height; y++) {
-            for (int x = 0; x < width; x++) {
-                QRgb pixel = imageCopy.pixel(x, y);
-                uint8_t alpha = qAlpha(pixel);
-                imageCopy.setPixel(x, y, qRgb(alpha, alpha, alpha));
-            }
-        }
-    } else if (mixed) {
-        // Show RGB with alpha as checkerboard pattern
-        QPixmap checkerPattern(16, 16);
-        checkerPattern.fill(Qt::lightGray);
-        QPainter checkerPainter(&checkerPattern);
-        checkerPainter.fillRect(0, 0, 8, 8, Qt::white);
-        checkerPainter.fillRect(8, 8, 8, 8, Qt::white);
-        checkerPainter.end();
-        
-        QPixmap result = QPixmap::fromImage(imageCopy);
-        QPainter painter(&result);
-        painter.setCompositionMode(QPainter::CompositionMode_DestinationOver);
-        painter.fillRect(result.rect(), QBrush(checkerPattern));
-        painter.end();
-        
-        return result;
-    } else if (!hasAlpha) {
-        // Alpha is disabled - composite onto black background
-        QPixmap result(width, height);
-        result.fill(Qt::black);
-        QPainter painter(&result);
-        painter.setCompositionMode(QPainter::CompositionMode_SourceOver);
-        painter.drawImage(0, 0, imageCopy);
-        painter.end();
-        return result;
-    }
-    
-    return QPixmap::fromImage(imageCopy);
+QImage TexturePreviewWidget::createMixedView() const {
+    // Show RGB with alpha as checkerboard pattern
+    QImage checkerPattern(16, 16, QImage::Format_RGB32);
+    checkerPattern.fill(Qt::lightGray);
+    QPainter checkerPainter(&checkerPattern);
+    checkerPainter.fillRect(0, 0, 8, 8, Qt::white);
+    checkerPainter.fillRect(8, 8, 8, 8, Qt::white);
+    checkerPainter.end();
+    
+    QImage result(image.width(), image.height(), QImage::Format_RGB32);
+    QPainter painter(&result);
+    painter.fillRect(result.rect(), QBrush(checkerPattern));
+    painter.drawImage(0, 0, image);
+    painter.end();
+    
+    return result;
 }
 
 void TexturePreviewWidget::clear() {
+    image = QImage();
+    imageTabStale = false;
+    alphaTabStale = false;
+    mixedTabStale = false;
     if (tabWidget) {
         tabWidget->hide();
     }
@@ -201,6 +208,9 @@ TexturePreviewWidget::ActiveTab TexturePreviewWidget::getCurrentTab() const {
 }
 
 void TexturePreviewWidget::onTabChanged(int index) {
+    // Tabs are built when first shown
+    updateTab(index);
+    
     // Reset zoom when switching tabs
     if (index == 0 && imageView) {
         imageView->zoom100();
@@ -7,6 +7,7 @@
 #include <QVBoxLayout>
 #include <QTabWidget>
 #include <QHBoxLayout>
+#include <QImage>
 #include "libtxd/txd_texture.h"
 #include "libtxd/txd_converter.h"
 #include "TextureViewWidget.h"
@@ -16,7 +17,8 @@ class TexturePreviewWidget : public QWidget {
 
 public:
     explicit TexturePreviewWidget(QWidget *parent = nullptr);
-    // Simple: just pass RGBA data directly
+    // Simple: just pass RGBA data directly. The data is copied once; each
+    // tab's image is built from that copy when the tab is first shown.
     void setTexture(const uint8_t* rgbaData, int width, int height, bool hasAlpha);
     void clear();
     
@@ -31,10 +33,11 @@ private slots:
     void onTabChanged(int index);
 
 private:
-    void updateImageTab(const uint8_t* rgbaData, int width, int height);
-    void updateAlphaTab(const uint8_t* rgbaData, int width, int height);
-    void updateMixedTab(const uint8_t* rgbaData, int width, int height);
-    QPixmap createImagePixmap(const uint8_t* rgbaData, int width, int height, bool hasAlpha, bool showAlpha = false, bool mixed = false);
+    // Build the image of the tab at `index` if it is out of date
+    void updateTab(int index);
+    QImage createImageView() const;
+    QImage createAlphaView() const;
+    QImage createMixedView() const;
     
     QVBoxLayout* mainLayout;
     QTabWidget* tabWidget;
@@ -48,6 +51,11 @@ private:
     int mixedTabIndex;
     bool alphaTabsVisible;
     bool currentHasAlpha;  // Store current alpha state
+    
+    QImage image;  // Current texture (RGBA8888), shared by all tabs
+    bool imageTabStale;
+    bool alphaTabStale;
+    bool mixedTabStale;
 };
 
 #endif // TEXTUREPREVIEWWIDGET_H
@@ -335,7 +335,10 @@ void TexturePropertiesWidget::onAlphaChannelToggled(bool enabled) {
         return;
     }
     
-    // Update alpha channel in RGBA data
+    // Update alpha channel in RGBA data, pinning untouched pixels first
+    if (currentEntry->diffuse.empty()) {
+        TXDModel::decodePixels(*currentEntry, currentEntry->diffuse);
+    }
     if (!currentEntry->diffuse.empty() && currentEntry->diffuse.size() == currentEntry->width * currentEntry->height * 4) {
         if (enabled) {
             // Alpha enabled - just set alpha to 255 (fully opaque)
@@ -359,6 +362,7 @@ void TexturePropertiesWidget::onAlphaChannelToggled(bool enabled) {
     
     // Update alpha flag
     currentEntry->hasAlpha = enabled;
+    currentEntry->pixelsDirty = true;
     
     emit propertyChanged();
 }
@@ -0,0 +1,120 @@
+#include "TextureTileItem.h"
+#include <QPainter>
+#include <QStyleOptionGraphicsItem>
+#include <algorithm>
+
+namespace {
+
+// Pixmaps of visible tiles, in KB
+constexpr int TileCacheBudget = 64 * 1024;
+
+} // namespace
+
+TextureTileItem::TextureTileItem(QGraphicsItem* parent)
+    : QGraphicsItem(parent)
+    , tiles(TileCacheBudget)
+{
+    // Needed for option->exposedRect
+    setFlag(QGraphicsItem::ItemUsesExtendedStyleOption);
+}
+
+void TextureTileItem::setImage(const QImage& image) {
+    prepareGeometryChange();
+    levels.clear();
+    tiles.clear();
+    if (!image.isNull()) {
+        levels.push_back(image);
+    }
+    update();
+}
+
+QRectF TextureTileItem::boundingRect() const {
+    if (levels.empty()) {
+        return QRectF();
+    }
+    return QRectF(0, 0, levels[0].width(), levels[0].height());
+}
+
+int TextureTileItem::getLevelCount() const {
+    if (levels.empty()) {
+        return 0;
+    }
+    // Stop once the whole image fits in one tile
+    int count = 1;
+    int size = std::max(levels[0].width(), levels[0].height());
+    while (size > TileSize) {
+        size = (size + 1) / 2;
+        count++;
+    }
+    return count;
+}
+
+const QImage& TextureTileItem::getLevel(int index) {
+    while (static_cast<int>(levels.size()) <= index) {
+        const QImage& previous = levels.back();
+        levels.push_back(previous.scaled(std::max(1, previous.width() / 2), std::max(1, previous.height() / 2),
+                                         Qt::IgnoreAspectRatio, Qt::SmoothTransformation));
+    }
+    return levels[index];
+}
+
+const QPixmap* TextureTileItem::getTile(int level, int x, int y) {
+    const quint64 key = (static_cast<quint64>(level) << 48) | (static_cast<quint64>(y) << 24) | static_cast<quint64>(x);
+    if (const QPixmap* cached = tiles.object(key)) {
+        return cached;
+    }
+
+    const QImage& image = getLevel(level);
+    QRect rect = QRect(x * TileSize, y * TileSize, TileSize, TileSize).intersected(image.rect());
+    QPixmap* tile = new QPixmap(QPixmap::fromImage(image.copy(rect)));
+    int cost = std::max(1, rect.width() * rect.height() * 4 / 1024);
+    // QCache deletes the pixmap if it doesn't fit; fall back to not caching
+    if (!tiles.insert(key, tile, cost)) {
+        return nullptr;
+    }
+    return tiles.object(key);
+}
+
+void TextureTileItem::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget) {
+    Q_UNUSED(widget);
+    if (levels.empty()) {
+        return;
+    }
+
+    // Largest level that still has at least one texel per screen pixel
+    const qreal scale = QStyleOptionGraphicsItem::levelOfDetailFromTransform(painter->worldTransform());
+    int level = 0;
+    const int levelCount = getLevelCount();
+    while (level + 1 < levelCount && scale * (1 << (level + 1)) <= 1.0) {
+        level++;
+    }
+
+    // getLevel may grow `levels`, so look at level 0 afterwards
+    const QImage& image = getLevel(level);
+    const QImage& full = levels[0];
+    const qreal sx = static_cast<qreal>(full.width()) / image.width();
+    const qreal sy = static_cast<qreal>(full.height()) / image.height();
+
+    // Exposed area in texels of the level
+    QRectF exposed = option->exposedRect.intersected(boundingRect());
+    QRect area = QRectF(exposed.left() / sx, exposed.top() / sy, exposed.width() / sx, exposed.height() / sy)
+        .toAlignedRect().intersected(image.rect());
+    if (area.isEmpty()) {
+        return;
+    }
+
+    // Antialiased edges would show the seams between tiles
+    painter->setRenderHint(QPainter::Antialiasing, false);
+
+    for (int ty = area.top() / TileSize; ty <= area.bottom() / TileSize; ty++) {
+        for (int tx = area.left() / TileSize; tx <= area.right() / TileSize; tx++) {
+            QRect rect = QRect(tx * TileSize, ty * TileSize, TileSize, TileSize).intersected(image.rect());
+            QRectF target(rect.x() * sx, rect.y() * sy, rect.width() * sx, rect.height() * sy);
+            if (const QPixmap* tile = getTile(level, tx, ty)) {
+                painter->drawPixmap(target, *tile, QRectF(tile->rect()));
+            } else {
+                painter->drawImage(target, image, QRectF(rect));
+            }
+        }
+    }
+}
@@ -0,0 +1,37 @@
+#ifndef TEXTURE_TILE_ITEM_H
+#define TEXTURE_TILE_ITEM_H
+
+#include <QGraphicsItem>
+#include <QImage>
+#include <QPixmap>
+#include <QCache>
+#include <vector>
+
+// Scene item that draws an image as square tiles. Only tiles in the exposed
+// area are turned into pixmaps, and when zoomed out they are cut from a
+// half-size level of the image instead of scaling the full one, so painting
+// costs about the same for any image size. Levels are built the first time
+// a zoom needs them.
+class TextureTileItem : public QGraphicsItem {
+public:
+    static constexpr int TileSize = 256;
+
+    explicit TextureTileItem(QGraphicsItem* parent = nullptr);
+
+    void setImage(const QImage& image);
+    bool isNull() const { return levels.empty(); }
+
+    QRectF boundingRect() const override;
+    void paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget = nullptr) override;
+
+private:
+    // Level 0 is the image, each further level half the size of the previous
+    const QImage& getLevel(int index);
+    int getLevelCount() const;
+    const QPixmap* getTile(int level, int x, int y);
+
+    std::vector<QImage> levels;
+    QCache<quint64, QPixmap> tiles;  // Cost in KB
+};
+
+#endif // TEXTURE_TILE_ITEM_H
@@ -1,4 +1,5 @@
 #include "TextureViewWidget.h"
+#include "TextureTileItem.h"
 #include <QHBoxLayout>
 #include <QVBoxLayout>
 #include <QToolButton>
@@ -6,7 +7,6 @@
 #include <QWheelEvent>
 #include <QMouseEvent>
 #include <QKeyEvent>
-#include <QGraphicsPixmapItem>
 #include <QGraphicsScene>
 #include <QGraphicsView>
 #include <QScrollBar>
@@ -44,8 +44,8 @@ void TextureViewWidget::setupUI() {
     setFocusPolicy(Qt::StrongFocus);
     graphicsView->setFocusPolicy(Qt::StrongFocus);
     
-    pixmapItem = new QGraphicsPixmapItem();
-    scene->addItem(pixmapItem);
+    imageItem = new TextureTileItem();
+    scene->addItem(imageItem);
     
     // Install event filter on viewport to handle panning
     graphicsView->viewport()->installEventFilter(this);
@@ -126,14 +126,14 @@ void TextureViewWidget::setupUI() {
     floatingControls->raise();
 }
 
-void TextureViewWidget::setPixmap(const QPixmap& pixmap) {
-    if (pixmap.isNull()) {
+void TextureViewWidget::setImage(const QImage& image) {
+    if (image.isNull()) {
         clear();
         return;
     }
     
-    pixmapItem->setPixmap(pixmap);
-    scene->setSceneRect(pixmapItem->boundingRect());
+    imageItem->setImage(image);
+    scene->setSceneRect(imageItem->boundingRect());
     
     // Don't auto-zoom here - let the tab change handler or explicit zoom100() handle it
     // This ensures proper sizing when widget is first shown
@@ -147,7 +147,7 @@ void TextureViewWidget::setPixmap(const QPixmap& pixmap) {
 }
 
 void TextureViewWidget::clear() {
-    pixmapItem->setPixmap(QPixmap());
+    imageItem->setImage(QImage());
     scene->setSceneRect(0, 0, 0, 0);
     resetView();
     floatingControls->hide();
@@ -165,7 +165,7 @@ void TextureViewWidget::zoomOut() {
 }
 
 void TextureViewWidget::zoomFit() {
-    if (pixmapItem->pixmap().isNull()) {
+    if (imageItem->isNull()) {
         return;
     }
     
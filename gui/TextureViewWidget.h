@@ -6,7 +6,6 @@
 #include <QScrollArea>
 #include <QGraphicsView>
 #include <QGraphicsScene>
-#include <QGraphicsPixmapItem>
 #include <QWheelEvent>
 #include <QMouseEvent>
 #include <QEvent>
@@ -16,13 +15,18 @@
 #include <QToolButton>
 #include <QSlider>
 #include <QLabel>
+#include <QImage>
 
+class TextureTileItem;
+
+// Zoomable, pannable view of one image. The image is drawn in tiles (see
+// TextureTileItem), so large textures pan and zoom smoothly.
 class TextureViewWidget : public QWidget {
     Q_OBJECT
 
 public:
     explicit TextureViewWidget(QWidget *parent = nullptr);
-    void setPixmap(const QPixmap& pixmap);
+    void setImage(const QImage& image);
     void clear();
     
     void zoomIn();
@@ -46,7 +50,7 @@ private:
     
     QGraphicsView* graphicsView;
     QGraphicsScene* scene;
-    QGraphicsPixmapItem* pixmapItem;
+    TextureTileItem* imageItem;
     
     QWidget* floatingControls;
     QToolButton* zoomInBtn;
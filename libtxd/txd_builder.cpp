@@ -0,0 +1,395 @@
+#include "txd_builder.h"
+#include "txd_dictionary.h"
+#include "txd_converter.h"
+#include "txd_parallel.h"
+#include "txd_hash.h"
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace LibTXD {
+
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr const char* ManifestMagic = "TXDMANIFEST";
+constexpr int ManifestVersion = 1;
+
+struct FileStamp {
+    uint64_t size = 0;
+    int64_t time = 0;
+
+    bool operator==(const FileStamp& other) const { return size == other.size && time == other.time; }
+};
+
+struct ManifestEntry {
+    FileStamp stamp;
+    uint64_t hash = 0;
+    std::string name;
+    std::string path;
+};
+
+// What a TXD was built from, written next to it after every build
+struct Manifest {
+    BuildSettings settings;
+    FileStamp output;
+    std::vector<ManifestEntry> entries;
+};
+
+bool getStamp(const fs::path& path, FileStamp& stamp) {
+    std::error_code ec;
+    stamp.size = fs::file_size(path, ec);
+    if (ec) {
+        return false;
+    }
+    stamp.time = static_cast<int64_t>(fs::last_write_time(path, ec).time_since_epoch().count());
+    return !ec;
+}
+
+std::string toLower(std::string text) {
+    std::transform(text.begin(), text.end(), text.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return text;
+}
+
+std::vector<std::string> splitTabs(const std::string& line) {
+    std::vector<std::string> fields;
+    size_t start = 0;
+    while (true) {
+        size_t tab = line.find('\t', start);
+        fields.push_back(line.substr(start, tab - start));
+        if (tab == std::string::npos) {
+            return fields;
+        }
+        start = tab + 1;
+    }
+}
+
+// Tab-separated lines:
+//   TXDMANIFEST  1
+//   settings     version(hex)  platform  compress  mipmaps  quality
+//   output       size  mtime
+//   source       size  mtime  hash(hex)  name  path
+bool readManifest(const fs::path& path, Manifest& manifest) {
+    std::ifstream file(path);
+    std::string line;
+    if (!file || !std::getline(file, line)) {
+        return false;
+    }
+    std::vector<std::string> fields = splitTabs(line);
+    if (fields.size() != 2 || fields[0] != ManifestMagic || std::atoi(fields[1].c_str()) != ManifestVersion) {
+        return false;
+    }
+
+    bool haveSettings = false;
+    bool haveOutput = false;
+    while (std::getline(file, line)) {
+        fields = splitTabs(line);
+        if (fields[0] == "settings" && fields.size() == 6) {
+            BuildSettings& s = manifest.settings;
+            s.version = static_cast<uint32_t>(std::strtoul(fields[1].c_str(), nullptr, 16));
+            s.platform = static_cast<Platform>(std::strtoul(fields[2].c_str(), nullptr, 10));
+            s.compress = fields[3] == "1";
+            s.mipmaps = fields[4] == "1";
+            s.quality = std::strtof(fields[5].c_str(), nullptr);
+            haveSettings = true;
+        } else if (fields[0] == "output" && fields.size() == 3) {
+            manifest.output.size = std::strtoull(fields[1].c_str(), nullptr, 10);
+            manifest.output.time = std::strtoll(fields[2].c_str(), nullptr, 10);
+            haveOutput = true;
+        } else if (fields[0] == "source" && fields.size() == 6) {
+            ManifestEntry entry;
+            entry.stamp.size = std::strtoull(fields[1].c_str(), nullptr, 10);
+            entry.stamp.time = std::strtoll(fields[2].c_str(), nullptr, 10);
+            entry.hash = std::strtoull(fields[3].c_str(), nullptr, 16);
+            entry.name = fields[4];
+            entry.path = fields[5];
+            manifest.entries.push_back(std::move(entry));
+        } else {
+            return false;
+        }
+    }
+    return haveSettings && haveOutput;
+}
+
+bool writeManifest(const fs::path& path, const Manifest& manifest) {
+    const BuildSettings& s = manifest.settings;
+    std::ostringstream out;
+    char line[128];
+    out << ManifestMagic << '\t' << ManifestVersion << '\n';
+    std::snprintf(line, sizeof(line), "settings\t%08X\t%u\t%d\t%d\t%.9g\n", s.version,
+                  static_cast<unsigned>(s.platform), s.compress ? 1 : 0, s.mipmaps ? 1 : 0, s.quality);
+    out << line;
+    out << "output\t" << manifest.output.size << '\t' << manifest.output.time << '\n';
+    for (const ManifestEntry& entry : manifest.entries) {
+        std::snprintf(line, sizeof(line), "%016llX", static_cast<unsigned long long>(entry.hash));
+        out << "source\t" << entry.stamp.size << '\t' << entry.stamp.time << '\t' << line << '\t'
+            << entry.name << '\t' << entry.path << '\n';
+    }
+
+    // Same write-and-rename as TextureDictionary::save
+    fs::path tempPath = path;
+    tempPath += ".tmp";
+    std::error_code ec;
+    {
+        std::ofstream file(tempPath, std::ios::binary);
+        const std::string text = out.str();
+        if (!file || !file.write(text.data(), static_cast<std::streamsize>(text.size()))) {
+            file.close();
+            fs::remove(tempPath, ec);
+            return false;
+        }
+    }
+    fs::rename(tempPath, path, ec);
+    if (ec) {
+        fs::remove(tempPath, ec);
+        return false;
+    }
+    return true;
+}
+
+bool readFile(const fs::path& path, std::vector<uint8_t>& data) {
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) {
+        return false;
+    }
+    std::streamsize size = file.tellg();
+    file.seekg(0);
+    data.resize(static_cast<size_t>(size));
+    return static_cast<bool>(file.read(reinterpret_cast<char*>(data.data()), size));
+}
+
+// Buffers reused by every source a thread decodes
+struct Scratch {
+    std::vector<uint8_t> file;
+    std::vector<uint8_t> rgba;
+};
+
+Scratch& getScratch() {
+    thread_local Scratch scratch;
+    return scratch;
+}
+
+} // namespace
+
+bool BuildSettings::operator==(const BuildSettings& other) const {
+    return version == other.version && platform == other.platform && compress == other.compress &&
+           mipmaps == other.mipmaps && quality == other.quality;
+}
+
+DictionaryBuilder::DictionaryBuilder(ImageDecoder decoder, const BuildSettings& settings)
+    : decoder(std::move(decoder)), settings(settings) {
+}
+
+bool DictionaryBuilder::encodeImage(Texture& texture, const uint8_t* rgba, uint32_t width, uint32_t height,
+                                    const BuildSettings& settings) {
+    const bool alpha = texture.hasAlpha();
+    texture.setRasterFormat(alpha ? RasterFormat::B8G8R8A8 : RasterFormat::B8G8R8);
+    auto setFormat = [&](Compression compression) {
+        texture.setCompression(compression);
+        // Uncompressed without alpha is 24-bit BGR, DXT uses a 16-bit depth indicator
+        texture.setDepth(compression != Compression::NONE ? 16 : (alpha ? 32 : 24));
+    };
+
+    Compression compression = Compression::NONE;
+    if (settings.compress) {
+        compression = alpha ? Compression::DXT3 : Compression::DXT1;
+    }
+    setFormat(compression);
+
+    const uint32_t levelCount = settings.mipmaps ? 0 : 1;
+    if (TextureConverter::generateMipmaps(texture, rgba, width, height, levelCount, settings.quality)) {
+        return true;
+    }
+    if (compression == Compression::NONE) {
+        return false;
+    }
+    setFormat(Compression::NONE);
+    return TextureConverter::generateMipmaps(texture, rgba, width, height, levelCount, settings.quality);
+}
+
+BuildResult DictionaryBuilder::build(const BuildTarget& target) const {
+    BuildResult result;
+    const fs::path outputPath = fs::u8path(target.output);
+    fs::path manifestPath = outputPath;
+    manifestPath += ".manifest";
+
+    // Texture names are looked up case-insensitively, so they must differ in more than case
+    std::unordered_set<std::string> names;
+    for (const BuildSource& source : target.sources) {
+        if (!names.insert(toLower(source.name)).second) {
+            result.error = "duplicate texture name " + source.name;
+            return result;
+        }
+    }
+
+    // Only trust the existing TXD if it is exactly what the last build wrote
+    Manifest previous;
+    TextureDictionary existing;
+    FileStamp outputStamp;
+    bool incremental = !force && readManifest(manifestPath, previous) && previous.settings == settings &&
+                       getStamp(outputPath, outputStamp) && outputStamp == previous.output &&
+                       existing.load(target.output, LoadMode::Mapped);
+
+    std::unordered_map<std::string, const ManifestEntry*> previousEntries;
+    if (incremental) {
+        for (const ManifestEntry& entry : previous.entries) {
+            previousEntries[entry.name] = &entry;
+        }
+    }
+
+    // Check and, if needed, encode every source in parallel
+    const size_t count = target.sources.size();
+    std::vector<Texture> encoded(count);
+    std::vector<Texture*> reused(count, nullptr);
+    std::vector<ManifestEntry> entries(count);
+    std::vector<std::string> errors(count);
+    std::atomic<uint64_t> bytesRead{0};
+
+    Parallel::parallelFor(count, 1, [&](size_t first, size_t last) {
+        for (size_t i = first; i < last; i++) {
+            const BuildSource& source = target.sources[i];
+            const fs::path sourcePath = fs::u8path(source.path);
+            ManifestEntry& entry = entries[i];
+            entry.name = source.name;
+            entry.path = source.path;
+            if (!getStamp(sourcePath, entry.stamp)) {
+                errors[i] = "cannot read " + source.path;
+                continue;
+            }
+
+            auto known = previousEntries.find(source.name);
+            Texture* current = known != previousEntries.end() ? existing.findTexture(source.name) : nullptr;
+            if (current && known->second->stamp == entry.stamp) {
+                entry.hash = known->second->hash;
+                reused[i] = current;
+                continue;
+            }
+
+            Scratch& scratch = getScratch();
+            if (!readFile(sourcePath, scratch.file)) {
+                errors[i] = "cannot read " + source.path;
+                continue;
+            }
+            bytesRead += scratch.file.size();
+            entry.hash = Hash::hash64(scratch.file.data(), scratch.file.size());
+            // Touched but not changed
+            if (current && known->second->hash == entry.hash) {
+                reused[i] = current;
+                continue;
+            }
+
+            uint32_t width = 0;
+            uint32_t height = 0;
+            if (!decoder(scratch.file.data(), scratch.file.size(), scratch.rgba, width, height)) {
+                errors[i] = "cannot decode " + source.path;
+                continue;
+            }
+
+            Texture& texture = encoded[i];
+            texture.setName(source.name);
+            texture.setPlatform(settings.platform);
+            bool alpha = false;
+            for (size_t p = 3; p < scratch.rgba.size() && !alpha; p += 4) {
+                alpha = scratch.rgba[p] != 255;
+            }
+            texture.setHasAlpha(alpha);
+            if (!encodeImage(texture, scratch.rgba.data(), width, height, settings)) {
+                errors[i] = "cannot encode " + source.path;
+            }
+        }
+    });
+
+    result.bytesRead = bytesRead;
+    for (const std::string& error : errors) {
+        if (!error.empty()) {
+            result.error = error;
+            return result;
+        }
+    }
+
+    for (size_t i = 0; i < count; i++) {
+        if (reused[i]) {
+            result.reused++;
+        } else {
+            result.encoded++;
+        }
+    }
+    if (incremental) {
+        for (const ManifestEntry& entry : previous.entries) {
+            if (names.count(toLower(entry.name)) == 0) {
+                result.removed++;
+            }
+        }
+    }
+
+    // Same textures in the same order: leave the TXD alone
+    bool sameOrder = incremental && previous.entries.size() == count;
+    for (size_t i = 0; sameOrder && i < count; i++) {
+        sameOrder = previous.entries[i].name == entries[i].name;
+    }
+    Manifest manifest;
+    manifest.settings = settings;
+    manifest.entries = std::move(entries);
+
+    if (sameOrder && result.encoded == 0) {
+        manifest.output = outputStamp;
+        // Refresh modification times of touched sources
+        bool stampsChanged = false;
+        for (size_t i = 0; i < count; i++) {
+            stampsChanged |= !(manifest.entries[i].stamp == previous.entries[i].stamp);
+        }
+        if (stampsChanged && !writeManifest(manifestPath, manifest)) {
+            result.error = "cannot write " + manifestPath.string();
+            return result;
+        }
+        result.ok = true;
+        return result;
+    }
+
+    // Reused textures still view the mapped old file, so their chunks are
+    // written straight from it
+    TextureDictionary dict;
+    dict.setVersion(settings.version);
+    for (size_t i = 0; i < count; i++) {
+        dict.addTexture(reused[i] ? std::move(*reused[i]) : std::move(encoded[i]));
+    }
+
+    std::error_code ec;
+    if (outputPath.has_parent_path()) {
+        fs::create_directories(outputPath.parent_path(), ec);
+    }
+    if (!dict.save(target.output)) {
+        result.error = "cannot write " + target.output;
+        return result;
+    }
+    if (!getStamp(outputPath, manifest.output) || !writeManifest(manifestPath, manifest)) {
+        result.error = "cannot write " + manifestPath.string();
+        return result;
+    }
+
+    result.written = true;
+    result.ok = true;
+    return result;
+}
+
+std::vector<BuildResult> DictionaryBuilder::build(const std::vector<BuildTarget>& targets) const {
+    std::vector<BuildResult> results(targets.size());
+    // Sources inside each target are spread over the pool too, so a few
+    // large TXDs still use every thread
+    Parallel::parallelFor(targets.size(), 1, [&](size_t first, size_t last) {
+        for (size_t i = first; i < last; i++) {
+            results[i] = build(targets[i]);
+        }
+    });
+    return results;
+}
+
+} // namespace LibTXD
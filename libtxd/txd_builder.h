@@ -0,0 +1,84 @@
+#ifndef TXD_BUILDER_H
+#define TXD_BUILDER_H
+
+#include "txd_texture.h"
+#include "txd_types.h"
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace LibTXD {
+
+// How source images are encoded into textures
+struct BuildSettings {
+    uint32_t version = 0x1803FFFF;
+    Platform platform = Platform::D3D9;
+    bool compress = true;   // DXT1, or DXT3 for images with alpha
+    bool mipmaps = true;    // Full chain, otherwise only the top level
+    float quality = 1.0f;
+
+    bool operator==(const BuildSettings& other) const;
+    bool operator!=(const BuildSettings& other) const { return !(*this == other); }
+};
+
+// One source image of a TXD
+struct BuildSource {
+    std::string name;   // Texture name
+    std::string path;   // Image file
+};
+
+// A TXD to build. Its manifest, which records the sources it was built from,
+// is kept next to it in `output` + ".manifest".
+struct BuildTarget {
+    std::string output;
+    std::vector<BuildSource> sources;
+};
+
+struct BuildResult {
+    bool ok = false;
+    bool written = false;     // False if the TXD was already up to date
+    size_t encoded = 0;       // Textures encoded from their source image
+    size_t reused = 0;        // Textures copied unchanged from the existing TXD
+    size_t removed = 0;       // Textures dropped because their source is gone
+    uint64_t bytesRead = 0;   // Source image bytes read
+    std::string error;
+};
+
+// Decode an image file's contents to RGBA8; libtxd has no image codecs of its
+// own, so the caller supplies one
+using ImageDecoder = std::function<bool(const uint8_t* data, size_t size, std::vector<uint8_t>& rgba,
+                                        uint32_t& width, uint32_t& height)>;
+
+// Incremental TXD builds. A source is only decoded and encoded again when
+// its size or modification time differ from the manifest and its content
+// hash does too; unchanged textures are taken from the existing TXD (memory
+// mapped, so their chunks are written back verbatim). If nothing changed
+// the TXD is not rewritten at all. Different settings, a missing manifest or
+// a TXD changed since the last build mean a full rebuild.
+class DictionaryBuilder {
+public:
+    DictionaryBuilder(ImageDecoder decoder, const BuildSettings& settings);
+
+    // Force every texture to be encoded again
+    void setForce(bool force) { this->force = force; }
+
+    BuildResult build(const BuildTarget& target) const;
+    // Build several TXDs in parallel; results are in target order
+    std::vector<BuildResult> build(const std::vector<BuildTarget>& targets) const;
+
+    // Encode RGBA8 pixels into `texture`, keeping its name, platform and
+    // hasAlpha(): B8G8R8A8/B8G8R8, or DXT3/DXT1 by alpha when compressing,
+    // falling back to uncompressed if compression fails.
+    static bool encodeImage(Texture& texture, const uint8_t* rgba, uint32_t width, uint32_t height,
+                            const BuildSettings& settings);
+
+private:
+    ImageDecoder decoder;
+    BuildSettings settings;
+    bool force = false;
+};
+
+} // namespace LibTXD
+
+#endif // TXD_BUILDER_H
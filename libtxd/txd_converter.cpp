@@ -1,12 +1,31 @@
 #include "txd_converter.h"
+#include "txd_parallel.h"
+#include "txd_dxt.h"
+#include "txd_pixels.h"
+#include "txd_mipmap.h"
 #include <squish.h>
 #include <libimagequant.h>
 #include <cstring>
 #include <algorithm>
 #include <stdexcept>
+#include <atomic>
 
 namespace LibTXD {
 
+namespace {
+
+// Shared by all threads; read and replaced atomically
+std::shared_ptr<EncodeCache> encodeCache;
+
+std::shared_ptr<EncodeCache> getCacheFor(uint32_t width, uint32_t height) {
+    if (static_cast<size_t>(width) * height < TextureConverter::MinCachedPixels) {
+        return nullptr;
+    }
+    return std::atomic_load(&encodeCache);
+}
+
+} // namespace
+
 std::unique_ptr<uint8_t[]> TextureConverter::decompressDXT(
     const uint8_t* compressedData,
     uint32_t width,
@@ -18,23 +37,51 @@ std::unique_ptr<uint8_t[]> TextureConverter::decompressDXT(
     }
     
     auto output = std::make_unique<uint8_t[]>(width * height * 4);
+    if (!decompressDXTInto(compressedData, width, height, compression, output.get())) {
+        return nullptr;
+    }
     
-    int flags = 0;
-    switch (compression) {
-        case Compression::DXT1:
-            flags = squish::kDxt1;
-            break;
-        case Compression::DXT3:
-            flags = squish::kDxt3;
-            break;
-        default:
-            return nullptr;
+    return output;
+}
+
+bool TextureConverter::decompressDXTInto(
+    const uint8_t* compressedData,
+    uint32_t width,
+    uint32_t height,
+    Compression compression,
+    uint8_t* output,
+    size_t outputStride) {
+    
+    if (!compressedData || !output || width == 0 || height == 0) {
+        return false;
     }
     
-    // Decompress using squish
-    squish::DecompressImage(output.get(), static_cast<int>(width), static_cast<int>(height), compressedData, flags);
+    if (compression != Compression::DXT1 && compression != Compression::DXT3) {
+        return false;
+    }
     
-    return output;
+    if (outputStride == 0) {
+        outputStride = static_cast<size_t>(width) * 4;
+    }
+    
+    const uint32_t blocksWide = (width + 3) / 4;
+    const uint32_t blocksHigh = (height + 3) / 4;
+    const size_t bytesPerBlock = (compression == Compression::DXT1) ? 8 : 16;
+    size_t bandRows = std::max<size_t>(1, blocksHigh / (Parallel::getThreadCount() * 4));
+    
+    const bool dxt3 = (compression == Compression::DXT3);
+    const DXT::Decoder decoder = DXT::getBestDecoder();
+    
+    // Decode bands of block rows in parallel, straight into the destination
+    Parallel::parallelFor(blocksHigh, bandRows, [&](size_t firstRow, size_t lastRow) {
+        for (size_t by = firstRow; by < lastRow; by++) {
+            uint32_t y = static_cast<uint32_t>(by) * 4;
+            DXT::decodeBlockRow(decoder, compressedData + by * blocksWide * bytesPerBlock, dxt3,
+                                width, std::min(4u, height - y), output + y * outputStride, outputStride);
+        }
+    });
+    
+    return true;
 }
 
 std::unique_ptr<uint8_t[]> TextureConverter::compressToDXT(
@@ -74,12 +121,168 @@ std::unique_ptr<uint8_t[]> TextureConverter::compressToDXT(
     
     auto compressedData = std::make_unique<uint8_t[]>(compressedSize);
     
-    // Compress using squish
-    squish::CompressImage(rgbaData, static_cast<int>(width), static_cast<int>(height), compressedData.get(), flags);
+    std::shared_ptr<EncodeCache> cache = getCacheFor(width, height);
+    EncodeCache::Key cacheKey;
+    if (cache) {
+        cacheKey = EncodeCache::makeKey(rgbaData, width, height,
+            compression == Compression::DXT1 ? EncodeCache::Kind::DXT1 : EncodeCache::Kind::DXT3,
+            static_cast<uint32_t>(flags));
+        if (cache->find(cacheKey, compressedData.get(), compressedSize)) {
+            return compressedData;
+        }
+    }
+    
+    // Compress bands of block rows in parallel. Each block is built exactly
+    // like squish::CompressImage does, so the output is identical to it.
+    const uint32_t blocksWide = (width + 3) / 4;
+    const uint32_t blocksHigh = (height + 3) / 4;
+    const size_t bytesPerBlock = (compression == Compression::DXT1) ? 8 : 16;
+    uint8_t* blocks = compressedData.get();
+    
+    // Aim for a few bands per thread so uneven blocks still balance out
+    size_t bandRows = std::max<size_t>(1, blocksHigh / (Parallel::getThreadCount() * 4));
+    
+    Parallel::parallelFor(blocksHigh, bandRows, [&](size_t firstRow, size_t lastRow) {
+        for (size_t by = firstRow; by < lastRow; by++) {
+            uint8_t* targetBlock = blocks + by * blocksWide * bytesPerBlock;
+            for (uint32_t bx = 0; bx < blocksWide; bx++) {
+                uint8_t sourceRgba[16 * 4] = {0};
+                int mask = 0;
+                for (uint32_t py = 0; py < 4; py++) {
+                    uint32_t sy = static_cast<uint32_t>(by) * 4 + py;
+                    if (sy >= height) {
+                        break;
+                    }
+                    for (uint32_t px = 0; px < 4; px++) {
+                        uint32_t sx = bx * 4 + px;
+                        if (sx >= width) {
+                            break;
+                        }
+                        std::memcpy(sourceRgba + 4 * (4 * py + px), rgbaData + 4 * (static_cast<size_t>(width) * sy + sx), 4);
+                        mask |= 1 << (4 * py + px);
+                    }
+                }
+                
+                squish::CompressMasked(sourceRgba, mask, targetBlock, flags);
+                targetBlock += bytesPerBlock;
+            }
+        }
+    });
+    
+    if (cache) {
+        cache->store(cacheKey, compressedData.get(), compressedSize);
+    }
     
     return compressedData;
 }
 
+bool TextureConverter::encodeMipmap(
+    const Texture& texture,
+    const uint8_t* rgbaData,
+    uint32_t width,
+    uint32_t height,
+    MipmapLevel& mipmap,
+    float quality) {
+    
+    if (!rgbaData || width == 0 || height == 0) {
+        return false;
+    }
+    
+    mipmap = MipmapLevel();
+    mipmap.width = width;
+    mipmap.height = height;
+    
+    Compression compression = texture.getCompression();
+    if (compression == Compression::DXT1 || compression == Compression::DXT3) {
+        auto compressed = compressToDXT(rgbaData, width, height, compression, quality);
+        if (!compressed) {
+            return false;
+        }
+        mipmap.data.assign(compressed.get(), compressed.get() + getCompressedDataSize(width, height, compression));
+    } else if (compression == Compression::NONE) {
+        uint32_t bytesPerPixel = texture.getDepth() / 8;
+        Pixels::PackRow pack = Pixels::getPacker(texture.getRasterFormat(), bytesPerPixel);
+        if (!pack) {
+            return false;
+        }
+        size_t pixelCount = static_cast<size_t>(width) * height;
+        mipmap.data.resize(pixelCount * bytesPerPixel);
+        pack(rgbaData, mipmap.data.data(), pixelCount);
+    } else {
+        return false;
+    }
+    
+    mipmap.dataSize = static_cast<uint32_t>(mipmap.data.size());
+    return true;
+}
+
+bool TextureConverter::generateMipmaps(
+    Texture& texture,
+    const uint8_t* rgbaData,
+    uint32_t width,
+    uint32_t height,
+    uint32_t levelCount,
+    float quality) {
+    
+    if (!rgbaData || width == 0 || height == 0) {
+        return false;
+    }
+    
+    std::vector<std::vector<uint8_t>> chain = Mipmaps::generateChain(rgbaData, width, height, levelCount);
+    std::vector<MipmapLevel> levels(chain.size() + 1);
+    
+    // One task per level; each compressToDXT call is itself parallel, so the
+    // big levels keep every thread busy while the small ones finish
+    std::atomic<bool> failed(false);
+    Parallel::parallelFor(levels.size(), 1, [&](size_t first, size_t last) {
+        for (size_t i = first; i < last; i++) {
+            uint32_t w = width;
+            uint32_t h = height;
+            for (size_t level = 0; level < i; level++) {
+                w = Mipmaps::nextSize(w);
+                h = Mipmaps::nextSize(h);
+            }
+            const uint8_t* source = i == 0 ? rgbaData : chain[i - 1].data();
+            if (!encodeMipmap(texture, source, w, h, levels[i], quality)) {
+                failed = true;
+            }
+        }
+    });
+    if (failed) {
+        return false;
+    }
+    
+    texture.clearMipmaps();
+    for (auto& level : levels) {
+        texture.addMipmap(std::move(level));
+    }
+    
+    uint32_t format = static_cast<uint32_t>(texture.getRasterFormat());
+    if (levels.size() > 1) {
+        format |= static_cast<uint32_t>(RasterFormat::MIPMAP);
+    } else {
+        format &= ~static_cast<uint32_t>(RasterFormat::MIPMAP);
+    }
+    texture.setRasterFormat(static_cast<RasterFormat>(format));
+    return true;
+}
+
+void TextureConverter::setThreadCount(unsigned count) {
+    Parallel::setThreadCount(count);
+}
+
+unsigned TextureConverter::getThreadCount() {
+    return Parallel::getThreadCount();
+}
+
+void TextureConverter::setEncodeCache(std::shared_ptr<EncodeCache> cache) {
+    std::atomic_store(&encodeCache, std::move(cache));
+}
+
+std::shared_ptr<EncodeCache> TextureConverter::getEncodeCache() {
+    return std::atomic_load(&encodeCache);
+}
+
 size_t TextureConverter::getCompressedDataSize(uint32_t width, uint32_t height, Compression compression) {
     int flags = 0;
     switch (compression) {
@@ -108,6 +311,24 @@ bool TextureConverter::generatePalette(
         return false;
     }
     
+    const int speed = 5; // Balance between speed and quality
+    const size_t pixelCount = static_cast<size_t>(width) * height;
+    
+    // Cached entries hold the palette followed by the indices
+    std::shared_ptr<EncodeCache> cache = getCacheFor(width, height);
+    EncodeCache::Key cacheKey;
+    if (cache) {
+        cacheKey = EncodeCache::makeKey(rgbaData, width, height,
+            paletteSize == 16 ? EncodeCache::Kind::Palette16 : EncodeCache::Kind::Palette256,
+            static_cast<uint32_t>(speed));
+        std::vector<uint8_t> entry(paletteSize * 4 + pixelCount);
+        if (cache->find(cacheKey, entry.data(), entry.size())) {
+            palette.assign(entry.begin(), entry.begin() + paletteSize * 4);
+            indexedData.assign(entry.begin() + paletteSize * 4, entry.end());
+            return true;
+        }
+    }
+    
     // Create libimagequant attributes
     liq_attr* attr = liq_attr_create();
     if (!attr) {
@@ -115,7 +336,7 @@ bool TextureConverter::generatePalette(
     }
     
     liq_set_max_colors(attr, static_cast<int>(paletteSize));
-    liq_set_speed(attr, 5); // Balance between speed and quality
+    liq_set_speed(attr, speed);
     
     // Create image from RGBA data
     liq_image* image = liq_image_create_rgba(attr, rgbaData, static_cast<int>(width), static_cast<int>(height), 0);
@@ -153,14 +374,20 @@ bool TextureConverter::generatePalette(
     }
     
     // Remap image to indexed
-    indexedData.resize(width * height);
-    liq_write_remapped_image(result, image, indexedData.data(), width * height);
+    indexedData.resize(pixelCount);
+    liq_write_remapped_image(result, image, indexedData.data(), pixelCount);
     
     // Cleanup
     liq_result_destroy(result);
     liq_image_destroy(image);
     liq_attr_destroy(attr);
     
+    if (cache) {
+        std::vector<uint8_t> entry(palette);
+        entry.insert(entry.end(), indexedData.begin(), indexedData.end());
+        cache->store(cacheKey, entry.data(), entry.size());
+    }
+    
     return true;
 }
 
@@ -176,22 +403,12 @@ void TextureConverter::convertPaletteToRGBA(
         return;
     }
     
-    for (uint32_t y = 0; y < height; y++) {
-        for (uint32_t x = 0; x < width; x++) {
-            uint32_t index = indexedData[y * width + x];
-            if (index >= paletteSize) {
-                index = 0; // Safety check
-            }
-            
-            uint32_t outIndex = (y * width + x) * 4;
-            uint32_t palIndex = index * 4;
-            
-            output[outIndex + 0] = palette[palIndex + 0];  // R
-            output[outIndex + 1] = palette[palIndex + 1];  // G
-            output[outIndex + 2] = palette[palIndex + 2];  // B
-            output[outIndex + 3] = palette[palIndex + 3];  // A
-        }
-    }
+    // Out-of-range indices are clamped once, in the table
+    alignas(32) uint32_t table[256];
+    Pixels::buildPaletteTable(palette, paletteSize, table);
+    
+    Pixels::ExpandRow expand = Pixels::getPalette8Expander();
+    expand(indexedData, table, output, static_cast<size_t>(width) * height);
 }
 
 std::unique_ptr<uint8_t[]> TextureConverter::convertToRGBA8(
@@ -203,11 +420,43 @@ std::unique_ptr<uint8_t[]> TextureConverter::convertToRGBA8(
     }
     
     const auto& mipmap = texture.getMipmap(mipmapIndex);
-    if (mipmap.width == 0 || mipmap.height == 0 || mipmap.data.empty()) {
+    if (mipmap.width == 0 || mipmap.height == 0 || !mipmap.getData()) {
         return nullptr;
     }
     
     auto output = std::make_unique<uint8_t[]>(mipmap.width * mipmap.height * 4);
+    if (!convertToRGBA8(texture, mipmapIndex, output.get())) {
+        return nullptr;
+    }
+    
+    return output;
+}
+
+bool TextureConverter::convertToRGBA8(
+    const Texture& texture,
+    size_t mipmapIndex,
+    uint8_t* output,
+    size_t outputStride) {
+    
+    if (!output || mipmapIndex >= texture.getMipmapCount()) {
+        return false;
+    }
+    
+    const auto& mipmap = texture.getMipmap(mipmapIndex);
+    if (mipmap.width == 0 || mipmap.height == 0 || !mipmap.getData()) {
+        return false;
+    }
+    
+    const size_t rowBytes = static_cast<size_t>(mipmap.width) * 4;
+    if (outputStride == 0) {
+        outputStride = rowBytes;
+    }
+    
+    auto fillBlack = [&]() {
+        for (uint32_t y = 0; y < mipmap.height; y++) {
+            std::memset(output + y * outputStride, 0, rowBytes);
+        }
+    };
     
     // Check for palette textures
     uint32_t rasterFormat = static_cast<uint32_t>(texture.getRasterFormat());
@@ -216,39 +465,169 @@ std::unique_ptr<uint8_t[]> TextureConverter::convertToRGBA8(
     if (isPalette) {
         // Handle palette texture
         uint32_t paletteSize = texture.getPaletteSize();
-        const std::vector<uint8_t>& palette = texture.getPalette();
+        ByteSpan palette = texture.getPalette();
         
         if (paletteSize == 0 || palette.empty() || palette.size() < paletteSize * 4) {
             // Invalid palette data - fill with black
-            std::memset(output.get(), 0, mipmap.width * mipmap.height * 4);
-            return output;
+            fillBlack();
+            return true;
         }
         
-        // For palette textures, mipmap.data contains only the indexed image data
-        const uint8_t* indexedData = mipmap.data.data();
-        const uint8_t* paletteData = palette.data();
+        // For palette textures, mipmap.data contains only the indexed image data.
+        // PAL4 is usually stored one index per byte; data too short for that
+        // is two indices per byte, low nibble first.
+        const size_t pixelCount = static_cast<size_t>(mipmap.width) * mipmap.height;
+        bool packed = (rasterFormat & 0x4000) != 0 && mipmap.dataSize < pixelCount;
+        size_t sourceStride = packed ? (mipmap.width + 1) / 2 : mipmap.width;
+        if (mipmap.dataSize < sourceStride * mipmap.height) {
+            fillBlack();
+            return true;
+        }
+        
+        alignas(32) uint32_t table[256];
+        Pixels::buildPaletteTable(palette.data(), paletteSize, table);
+        Pixels::ExpandRow expand = packed ? Pixels::getPalette4Expander() : Pixels::getPalette8Expander();
         
-        convertPaletteToRGBA(indexedData, paletteData, paletteSize, mipmap.width, mipmap.height, output.get());
+        const uint8_t* indexedData = mipmap.getData();
+        for (uint32_t y = 0; y < mipmap.height; y++) {
+            expand(indexedData + y * sourceStride, table, output + y * outputStride, mipmap.width);
+        }
     } else {
         // Convert based on compression
         switch (texture.getCompression()) {
             case Compression::DXT1:
-                convertDXT1(mipmap.data.data(), mipmap.width, mipmap.height, output.get());
-                break;
             case Compression::DXT3:
-                convertDXT3(mipmap.data.data(), mipmap.width, mipmap.height, output.get());
+                if (mipmap.dataSize < getCompressedDataSize(mipmap.width, mipmap.height, texture.getCompression())) {
+                    // Truncated block data
+                    fillBlack();
+                    break;
+                }
+                decompressDXTInto(mipmap.getData(), mipmap.width, mipmap.height, texture.getCompression(),
+                                  output, outputStride);
                 break;
             case Compression::NONE:
-                convertUncompressed(texture, mipmap, output.get());
+                convertUncompressed(texture, mipmap, output, outputStride);
                 break;
             default:
                 // Unsupported compression
-                std::memset(output.get(), 0, mipmap.width * mipmap.height * 4);
+                fillBlack();
                 break;
         }
     }
     
-    return output;
+    return true;
+}
+
+bool TextureConverter::convertToThumbnail(
+    const Texture& texture,
+    uint32_t targetSize,
+    std::vector<uint8_t>& rgba,
+    uint32_t& width,
+    uint32_t& height) {
+    
+    if (texture.getMipmapCount() == 0 || targetSize == 0) {
+        return false;
+    }
+    
+    // Smallest level that still covers the target
+    size_t level = 0;
+    for (size_t i = 1; i < texture.getMipmapCount(); i++) {
+        const auto& candidate = texture.getMipmap(i);
+        if (std::max(candidate.width, candidate.height) < targetSize) {
+            break;
+        }
+        level = i;
+    }
+    
+    const auto& mipmap = texture.getMipmap(level);
+    if (mipmap.width == 0 || mipmap.height == 0 || !mipmap.getData()) {
+        return false;
+    }
+    
+    uint32_t rasterFormat = static_cast<uint32_t>(texture.getRasterFormat());
+    bool isPalette = (rasterFormat & 0x2000) != 0 || (rasterFormat & 0x4000) != 0;
+    Compression compression = texture.getCompression();
+    bool isDXT = !isPalette && (compression == Compression::DXT1 || compression == Compression::DXT3);
+    
+    if (isDXT && std::max(mipmap.width, mipmap.height) >= targetSize * 4 &&
+        mipmap.dataSize >= getCompressedDataSize(mipmap.width, mipmap.height, compression)) {
+        // One pixel per 4x4 block
+        const bool dxt3 = compression == Compression::DXT3;
+        width = (mipmap.width + 3) / 4;
+        height = (mipmap.height + 3) / 4;
+        rgba.resize(static_cast<size_t>(width) * height * 4);
+        const size_t blockRowBytes = static_cast<size_t>(width) * (dxt3 ? 16 : 8);
+        size_t bandRows = std::max<size_t>(1, height / (Parallel::getThreadCount() * 4));
+        Parallel::parallelFor(height, bandRows, [&](size_t firstRow, size_t lastRow) {
+            for (size_t y = firstRow; y < lastRow; y++) {
+                DXT::averageBlockRow(mipmap.getData() + y * blockRowBytes, dxt3, width,
+                                     rgba.data() + y * width * 4);
+            }
+        });
+    } else {
+        width = mipmap.width;
+        height = mipmap.height;
+        rgba.resize(static_cast<size_t>(width) * height * 4);
+        if (!convertToRGBA8(texture, level, rgba.data())) {
+            return false;
+        }
+    }
+    
+    // A plain box filter: thumbnails don't need the gamma-correct mip filter
+    uint32_t factor = 1;
+    while (std::max(width, height) / (factor * 2) >= targetSize) {
+        factor *= 2;
+    }
+    if (factor > 1) {
+        uint32_t reducedWidth = (width + factor - 1) / factor;
+        uint32_t reducedHeight = (height + factor - 1) / factor;
+        std::vector<uint8_t> reduced(static_cast<size_t>(reducedWidth) * reducedHeight * 4);
+        boxReduce(rgba.data(), width, height, factor, reduced.data());
+        rgba.swap(reduced);
+        width = reducedWidth;
+        height = reducedHeight;
+    }
+    
+    return true;
+}
+
+void TextureConverter::boxReduce(
+    const uint8_t* rgba,
+    uint32_t width,
+    uint32_t height,
+    uint32_t factor,
+    uint8_t* output) {
+    
+    const uint32_t outWidth = (width + factor - 1) / factor;
+    const uint32_t outHeight = (height + factor - 1) / factor;
+    std::vector<uint32_t> sums(static_cast<size_t>(outWidth) * 4);
+    
+    for (uint32_t oy = 0; oy < outHeight; oy++) {
+        const uint32_t y0 = oy * factor;
+        const uint32_t y1 = std::min(y0 + factor, height);
+        std::fill(sums.begin(), sums.end(), 0);
+        for (uint32_t y = y0; y < y1; y++) {
+            const uint8_t* pixel = rgba + static_cast<size_t>(y) * width * 4;
+            for (uint32_t ox = 0; ox < outWidth; ox++) {
+                uint32_t* sum = &sums[ox * 4];
+                const uint32_t columns = std::min(factor, width - ox * factor);
+                for (uint32_t x = 0; x < columns; x++, pixel += 4) {
+                    sum[0] += pixel[0];
+                    sum[1] += pixel[1];
+                    sum[2] += pixel[2];
+                    sum[3] += pixel[3];
+                }
+            }
+        }
+        
+        uint8_t* out = output + static_cast<size_t>(oy) * outWidth * 4;
+        for (uint32_t ox = 0; ox < outWidth; ox++) {
+            const uint32_t count = (std::min((ox + 1) * factor, width) - ox * factor) * (y1 - y0);
+            for (int c = 0; c < 4; c++) {
+                out[ox * 4 + c] = static_cast<uint8_t>((sums[ox * 4 + c] + count / 2) / count);
+            }
+        }
+    }
 }
 
 bool TextureConverter::canConvert(const Texture& texture) {
@@ -270,7 +649,8 @@ bool TextureConverter::canConvert(const Texture& texture) {
 void TextureConverter::convertUncompressed(
     const Texture& texture,
     const MipmapLevel& mipmap,
-    uint8_t* output) {
+    uint8_t* output,
+    size_t outputStride) {
     
     uint32_t format = static_cast<uint32_t>(texture.getRasterFormat());
     uint32_t formatMask = format & 0x0F00;
@@ -280,11 +660,32 @@ void TextureConverter::convertUncompressed(
         bpp = 4; // Default to 32-bit
     }
     
+    const uint8_t* source = mipmap.getData();
+    const size_t sourceStride = static_cast<size_t>(mipmap.width) * bpp;
+    
+    if (mipmap.dataSize < sourceStride * mipmap.height) {
+        // Truncated pixel data
+        for (uint32_t y = 0; y < mipmap.height; y++) {
+            std::memset(output + y * outputStride, 0, mipmap.width * 4);
+        }
+        return;
+    }
+    
+    // Common formats: one row kernel chosen for the whole image
+    Pixels::UnpackRow unpack = Pixels::getUnpacker(texture.getRasterFormat(), bpp);
+    if (unpack) {
+        for (uint32_t y = 0; y < mipmap.height; y++) {
+            unpack(source + y * sourceStride, output + y * outputStride, mipmap.width);
+        }
+        return;
+    }
+    
+    // Unusual format/depth combinations
     for (uint32_t y = 0; y < mipmap.height; y++) {
         for (uint32_t x = 0; x < mipmap.width; x++) {
             uint32_t pixelIndex = y * mipmap.width + x;
-            const uint8_t* pixelData = mipmap.data.data() + (pixelIndex * bpp);
-            uint8_t* outPixel = output + (pixelIndex * 4);
+            const uint8_t* pixelData = source + (pixelIndex * bpp);
+            uint8_t* outPixel = output + y * outputStride + x * 4;
             
             uint8_t r = 0, g = 0, b = 0, a = 255;
             
@@ -349,28 +750,4 @@ void TextureConverter::convertUncompressed(
     }
 }
 
-void TextureConverter::convertDXT1(
-    const uint8_t* data,
-    uint32_t width,
-    uint32_t height,
-    uint8_t* output) {
-    
-    auto decompressed = decompressDXT(data, width, height, Compression::DXT1);
-    if (decompressed) {
-        std::memcpy(output, decompressed.get(), width * height * 4);
-    }
-}
-
-void TextureConverter::convertDXT3(
-    const uint8_t* data,
-    uint32_t width,
-    uint32_t height,
-    uint8_t* output) {
-    
-    auto decompressed = decompressDXT(data, width, height, Compression::DXT3);
-    if (decompressed) {
-        std::memcpy(output, decompressed.get(), width * height * 4);
-    }
-}
-
 } // namespace LibTXD
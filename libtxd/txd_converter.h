@@ -3,6 +3,7 @@
 
 #include "txd_texture.h"
 #include "txd_types.h"
+#include "txd_encode_cache.h"
 #include <cstdint>
 #include <vector>
 #include <memory>
@@ -21,7 +22,20 @@ public:
         Compression compression
     );
     
+    // Decompress DXT data straight into a caller-provided RGBA8 buffer
+    // Block rows are decoded in parallel. outputStride is the distance in bytes
+    // between output rows (0 = width*4). Returns false on invalid arguments.
+    static bool decompressDXTInto(
+        const uint8_t* compressedData,
+        uint32_t width,
+        uint32_t height,
+        Compression compression,
+        uint8_t* output,
+        size_t outputStride = 0
+    );
+    
     // Compress RGBA8 data to DXT format
+    // Block rows are compressed in parallel; output matches squish::CompressImage
     // Returns nullptr on failure, or a buffer with compressed data
     static std::unique_ptr<uint8_t[]> compressToDXT(
         const uint8_t* rgbaData,
@@ -63,30 +77,84 @@ public:
         size_t mipmapIndex = 0
     );
     
+    // Same, writing into a caller-provided buffer with the given row stride
+    // (0 = width*4). Returns false if the mipmap has no data.
+    static bool convertToRGBA8(
+        const Texture& texture,
+        size_t mipmapIndex,
+        uint8_t* output,
+        size_t outputStride = 0
+    );
+    
+    // Decode a small RGBA8 version of the texture for previews. Only the
+    // smallest stored mipmap whose larger side is at least targetSize is read.
+    // DXT levels still 4x too large are decoded at quarter size by averaging
+    // blocks, then the image is box filtered by the largest power of two that
+    // keeps its larger side at least targetSize.
+    static bool convertToThumbnail(
+        const Texture& texture,
+        uint32_t targetSize,
+        std::vector<uint8_t>& rgba,  // Output: width * height * 4 bytes
+        uint32_t& width,
+        uint32_t& height
+    );
+    
+    // Encode an RGBA8 image as one mipmap level in the texture's format:
+    // DXT1/DXT3 per its compression, otherwise its raster format stored with
+    // depth/8 bytes per pixel. Palette formats are not supported.
+    static bool encodeMipmap(
+        const Texture& texture,
+        const uint8_t* rgbaData,
+        uint32_t width,
+        uint32_t height,
+        MipmapLevel& mipmap,
+        float quality = 1.0f
+    );
+    
+    // Replace the texture's mipmaps with a chain built from RGBA8 level 0
+    // levelCount: number of levels, 0 = full chain down to 1x1
+    // Levels are downsampled first, then all of them are encoded in parallel.
+    // Sets the MIPMAP raster flag when more than one level is stored.
+    static bool generateMipmaps(
+        Texture& texture,
+        const uint8_t* rgbaData,
+        uint32_t width,
+        uint32_t height,
+        uint32_t levelCount = 0,
+        float quality = 1.0f
+    );
+    
     // Check if a texture format can be converted
     static bool canConvert(const Texture& texture);
     
+    // Persistent cache consulted by compressToDXT and generatePalette
+    // (nullptr = none, the default). Images smaller than MinCachedPixels are
+    // always encoded, as that is cheaper than a file lookup.
+    static constexpr size_t MinCachedPixels = 64 * 64;
+    static void setEncodeCache(std::shared_ptr<EncodeCache> cache);
+    static std::shared_ptr<EncodeCache> getEncodeCache();
+    
+    // Threads used by parallel conversions, including the caller
+    // 0 = one per hardware thread (default), 1 = serial
+    static void setThreadCount(unsigned count);
+    static unsigned getThreadCount();
+    
 private:
     // Helper: Convert uncompressed texture data to RGBA8
     static void convertUncompressed(
         const Texture& texture,
         const MipmapLevel& mipmap,
-        uint8_t* output
-    );
-    
-    // Helper: Convert DXT1 compressed data
-    static void convertDXT1(
-        const uint8_t* data,
-        uint32_t width,
-        uint32_t height,
-        uint8_t* output
+        uint8_t* output,
+        size_t outputStride
     );
     
-    // Helper: Convert DXT3 compressed data
-    static void convertDXT3(
-        const uint8_t* data,
+    // Helper: Average factor x factor boxes of an RGBA8 image (edge boxes are
+    // clipped) into ceil(width/factor) x ceil(height/factor) pixels
+    static void boxReduce(
+        const uint8_t* rgba,
         uint32_t width,
         uint32_t height,
+        uint32_t factor,
         uint8_t* output
     );
 };
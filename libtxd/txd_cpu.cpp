@@ -0,0 +1,78 @@
+#include "txd_cpu.h"
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define TXD_CPU_MSVC_X86
+#elif defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define TXD_CPU_GNU_X86
+#endif
+
+namespace LibTXD {
+namespace CPU {
+
+#if defined(TXD_CPU_MSVC_X86)
+
+namespace {
+
+struct Features {
+    bool sse2 = false;
+    bool ssse3 = false;
+    bool avx2 = false;
+
+    Features() {
+        int info[4] = {0};
+        __cpuid(info, 0);
+        int maxLeaf = info[0];
+
+        __cpuid(info, 1);
+        sse2 = (info[3] & (1 << 26)) != 0;
+        ssse3 = (info[2] & (1 << 9)) != 0;
+        bool osxsave = (info[2] & (1 << 27)) != 0;
+        bool avx = (info[2] & (1 << 28)) != 0;
+
+        // AVX state must also be enabled by the OS
+        if (maxLeaf >= 7 && osxsave && avx && (_xgetbv(0) & 0x6) == 0x6) {
+            __cpuidex(info, 7, 0);
+            avx2 = (info[1] & (1 << 5)) != 0;
+        }
+    }
+};
+
+const Features& features() {
+    static const Features detected;
+    return detected;
+}
+
+} // namespace
+
+bool hasSSE2() { return features().sse2; }
+bool hasSSSE3() { return features().ssse3; }
+bool hasAVX2() { return features().avx2; }
+
+#elif defined(TXD_CPU_GNU_X86)
+
+bool hasSSE2() {
+    static const bool supported = (__builtin_cpu_init(), __builtin_cpu_supports("sse2") != 0);
+    return supported;
+}
+
+bool hasSSSE3() {
+    static const bool supported = (__builtin_cpu_init(), __builtin_cpu_supports("ssse3") != 0);
+    return supported;
+}
+
+bool hasAVX2() {
+    static const bool supported = (__builtin_cpu_init(), __builtin_cpu_supports("avx2") != 0);
+    return supported;
+}
+
+#else
+
+bool hasSSE2() { return false; }
+bool hasSSSE3() { return false; }
+bool hasAVX2() { return false; }
+
+#endif
+
+} // namespace CPU
+} // namespace LibTXD
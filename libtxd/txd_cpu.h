@@ -0,0 +1,18 @@
+#ifndef TXD_CPU_H
+#define TXD_CPU_H
+
+namespace LibTXD {
+
+// Runtime CPU feature detection, used to pick SIMD code paths.
+// Always false on non-x86 targets.
+namespace CPU {
+
+bool hasSSE2();
+bool hasSSSE3();
+bool hasAVX2();
+
+} // namespace CPU
+
+} // namespace LibTXD
+
+#endif // TXD_CPU_H
@@ -1,8 +1,13 @@
 #include "txd_dictionary.h"
 #include "txd_types.h"
+#include "txd_reader.h"
+#include "txd_writer.h"
 #include <fstream>
 #include <algorithm>
 #include <cstring>
+#include <filesystem>
+#include <system_error>
+#include <iterator>
 
 namespace LibTXD {
 
@@ -19,6 +24,7 @@ TextureDictionary::TextureDictionary(TextureDictionary&& other) noexcept
     , textureMap(std::move(other.textureMap))
     , version(other.version)
     , gameVersion(other.gameVersion)
+    , mapping(std::move(other.mapping))
 {
 }
 
@@ -28,6 +34,7 @@ TextureDictionary& TextureDictionary::operator=(TextureDictionary&& other) noexc
         textureMap = std::move(other.textureMap);
         version = other.version;
         gameVersion = other.gameVersion;
+        mapping = std::move(other.mapping);
     }
     return *this;
 }
@@ -102,9 +109,23 @@ void TextureDictionary::removeTexture(const std::string& name) {
 void TextureDictionary::clear() {
     textures.clear();
     textureMap.clear();
+    mapping.reset();
 }
 
-bool TextureDictionary::load(const std::string& filepath) {
+bool TextureDictionary::load(const std::string& filepath, LoadMode mode) {
+    if (mode == LoadMode::Mapped || mode == LoadMode::Lazy) {
+        std::shared_ptr<MappedFile> file = MappedFile::open(filepath);
+        if (!file) {
+            return false;
+        }
+        clear();
+        if (!readFromMemory(file->getData(), file->getSize(), file, mode == LoadMode::Lazy)) {
+            return false;
+        }
+        mapping = std::move(file);
+        return true;
+    }
+    
     std::ifstream file(filepath, std::ios::binary);
     if (!file.is_open()) {
         return false;
@@ -112,17 +133,42 @@ bool TextureDictionary::load(const std::string& filepath) {
     return load(file);
 }
 
+bool TextureDictionary::load(const uint8_t* data, size_t size, std::shared_ptr<const void> backing) {
+    clear();
+    return readFromMemory(data, size, backing);
+}
+
 bool TextureDictionary::load(std::istream& stream) {
     clear();
     return readFromStream(stream);
 }
 
 bool TextureDictionary::save(const std::string& filepath) const {
-    std::ofstream file(filepath, std::ios::binary);
-    if (!file.is_open()) {
+    ChunkWriter writer;
+    write(writer);
+    
+    // Write next to the target and swap it in afterwards, so a failed or
+    // interrupted save never leaves a truncated file behind. This also keeps
+    // the file we may be mapped from intact until the new one is complete.
+    // The data is on disk before the rename, so a crash can't leave the new
+    // name pointing at an empty file.
+    std::string tempPath = filepath + ".tmp";
+    std::error_code ec;
+    if (!writer.writeToFile(tempPath, true)) {
+        std::filesystem::remove(tempPath, ec);
+        return false;
+    }
+    // The replacement keeps the original's permissions
+    std::filesystem::file_status original = std::filesystem::status(filepath, ec);
+    if (!ec && std::filesystem::exists(original)) {
+        std::filesystem::permissions(tempPath, original.permissions(), ec);
+    }
+    std::filesystem::rename(tempPath, filepath, ec);
+    if (ec) {
+        std::filesystem::remove(tempPath, ec);
         return false;
     }
-    return save(file);
+    return true;
 }
 
 bool TextureDictionary::save(std::ostream& stream) const {
@@ -130,8 +176,32 @@ bool TextureDictionary::save(std::ostream& stream) const {
 }
 
 bool TextureDictionary::readFromStream(std::istream& stream) {
+    // Slurp the rest of the stream; textures share the buffer
+    std::streampos start = stream.tellg();
+    stream.seekg(0, std::ios::end);
+    std::streampos end = stream.tellg();
+    
+    auto buffer = std::make_shared<std::vector<uint8_t>>();
+    if (start != std::streampos(-1) && end != std::streampos(-1) && end >= start) {
+        stream.seekg(start, std::ios::beg);
+        buffer->resize(static_cast<size_t>(end - start));
+        stream.read(reinterpret_cast<char*>(buffer->data()), buffer->size());
+        buffer->resize(static_cast<size_t>(stream.gcount()));
+    } else {
+        // Not seekable, read until EOF
+        stream.clear();
+        buffer->assign(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+    }
+    
+    return readFromMemory(buffer->data(), buffer->size(), buffer);
+}
+
+bool TextureDictionary::readFromMemory(const uint8_t* data, size_t size, const std::shared_ptr<const void>& backing,
+                                       bool headersOnly) {
+    ChunkReader reader(data, size);
+    
     ChunkHeader header;
-    if (!header.read(stream)) {
+    if (!reader.readHeader(header)) {
         return false;
     }
     
@@ -143,48 +213,27 @@ bool TextureDictionary::readFromStream(std::istream& stream) {
     // Don't detect game version yet - wait until after reading textures
     // so we can use platform information
     
-    size_t sectionStart = stream.tellg();
-    size_t sectionEnd = sectionStart + header.length;
+    ChunkReader section = reader.child(header.length);
     
     // Read child sections
-    while (stream.tellg() < static_cast<std::streampos>(sectionEnd) && stream.good()) {
-        ChunkHeader childHeader;
-        if (!childHeader.read(stream)) {
-            break;
-        }
+    while (section.remaining() >= 12) {
+        const uint8_t* childStart = section.current();
         
-        size_t childStart = stream.tellg();
-        size_t childEnd = childStart + childHeader.length;
+        ChunkHeader childHeader;
+        section.readHeader(childHeader);
+        ChunkReader child = section.child(childHeader.length);
         
-        if (childHeader.type == ChunkType::STRUCT) {
-            // Read texture count
-            uint16_t textureCount;
-            stream.read(reinterpret_cast<char*>(&textureCount), 2);
-            textureCount = fromLittleEndian16(textureCount);
-            
-            // Skip unknown field (2 bytes)
-            stream.seekg(2, std::ios::cur);
-            
-            // Skip to end of struct
-            stream.seekg(childEnd, std::ios::beg);
-        } else if (childHeader.type == ChunkType::TEXTURENATIVE) {
-            // The readD3D function expects to read the TEXTURENATIVE header first
-            // But we've already read it, so we need to seek back
-            stream.seekg(childStart - 12, std::ios::beg);
-            
+        if (childHeader.type == ChunkType::TEXTURENATIVE) {
+            // Texture parses its own section, header included
             Texture texture;
-            if (texture.readD3D(stream)) {
+            bool ok = headersOnly
+                ? texture.readD3DHeader(childStart, 12 + child.size(), backing)
+                : texture.readD3D(childStart, 12 + child.size(), backing);
+            if (ok) {
                 addTexture(std::move(texture));
             }
-            // Ensure we're at the end of the section
-            stream.seekg(childEnd, std::ios::beg);
-        } else if (childHeader.type == ChunkType::EXTENSION) {
-            // Skip extension section
-            stream.seekg(childHeader.length, std::ios::cur);
-        } else {
-            // Unknown section, skip it
-            stream.seekg(childHeader.length, std::ios::cur);
         }
+        // STRUCT (texture count), EXTENSION and unknown sections are skipped
     }
     
     // Detect game version after reading textures (so we can use platform info)
@@ -194,49 +243,32 @@ bool TextureDictionary::readFromStream(std::istream& stream) {
 }
 
 bool TextureDictionary::writeToStream(std::ostream& stream) const {
-    size_t sectionStart = stream.tellp();
-    
-    // Write TEXDICTIONARY header (will update later)
-    ChunkHeader sectionHeader;
-    sectionHeader.type = ChunkType::TEXDICTIONARY;
-    sectionHeader.length = 0; // Will update
-    sectionHeader.version = version;
-    sectionHeader.write(stream);
-    
-    // Write STRUCT section (texture count)
-    ChunkHeader structHeader;
-    structHeader.type = ChunkType::STRUCT;
-    structHeader.length = 4;
-    structHeader.version = version;
-    structHeader.write(stream);
+    ChunkWriter writer;
+    write(writer);
+    return writer.writeTo(stream);
+}
+
+void TextureDictionary::write(ChunkWriter& writer) const {
+    // Every length is known up front, so the file is produced in one pass
+    uint32_t sectionSize = 12 + 4;
+    for (const auto& texture : textures) {
+        sectionSize += texture.getD3DSize();
+    }
+    sectionSize += 12;
     
-    uint16_t textureCount = toLittleEndian16(static_cast<uint16_t>(textures.size()));
-    stream.write(reinterpret_cast<const char*>(&textureCount), 2);
+    writer.writeHeader(ChunkType::TEXDICTIONARY, sectionSize, version);
     
-    // Write unknown field (2 bytes, typically 0)
-    uint16_t unknown = 0;
-    stream.write(reinterpret_cast<const char*>(&unknown), 2);
+    // STRUCT section: texture count and an unknown field (typically 0)
+    writer.writeHeader(ChunkType::STRUCT, 4, version);
+    writer.writeU16(static_cast<uint16_t>(textures.size()));
+    writer.writeU16(0);
     
-    // Write all textures
     for (const auto& texture : textures) {
-        texture.writeD3D(stream, version);
+        texture.writeD3D(writer, version);
     }
     
-    // Write extension section (empty)
-    ChunkHeader extHeader;
-    extHeader.type = ChunkType::EXTENSION;
-    extHeader.length = 0;
-    extHeader.version = version;
-    extHeader.write(stream);
-    
-    // Update section size
-    size_t sectionEnd = stream.tellp();
-    stream.seekp(sectionStart + 4, std::ios::beg);
-    uint32_t sectionSize = toLittleEndian32(static_cast<uint32_t>(sectionEnd - sectionStart - 12));
-    stream.write(reinterpret_cast<const char*>(&sectionSize), 4);
-    stream.seekp(sectionEnd, std::ios::beg);
-    
-    return true;
+    // Extension section (empty)
+    writer.writeHeader(ChunkType::EXTENSION, 0, version);
 }
 
 GameVersion TextureDictionary::detectGameVersion(uint32_t versionValue) {
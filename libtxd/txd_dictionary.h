@@ -3,6 +3,7 @@
 
 #include "txd_texture.h"
 #include "txd_types.h"
+#include "txd_mapped_file.h"
 #include <cstdint>
 #include <string>
 #include <vector>
@@ -12,6 +13,14 @@
 
 namespace LibTXD {
 
+// How pixel data is brought into memory when loading from a file
+enum class LoadMode {
+    Buffered,   // Read the file into one buffer; textures share it
+    Mapped,     // Memory-map the file; mipmaps and palettes view the mapping
+    Lazy        // Like Mapped, but only texture headers are parsed up front;
+                // pixels and palette are located on first getMipmap()/getPalette()
+};
+
 // Texture Dictionary class - represents a TXD file
 class TextureDictionary {
 public:
@@ -43,8 +52,11 @@ public:
     void setVersion(uint32_t v);
     
     // File I/O
-    bool load(const std::string& filepath);
+    bool load(const std::string& filepath, LoadMode mode = LoadMode::Buffered);
     bool load(std::istream& stream);
+    // Parse from memory. Textures view the buffer and keep 'backing' alive.
+    bool load(const uint8_t* data, size_t size, std::shared_ptr<const void> backing);
+    // Writes "<filepath>.tmp" and renames it over filepath once complete
     bool save(const std::string& filepath) const;
     bool save(std::ostream& stream) const;
     
@@ -53,10 +65,14 @@ private:
     std::unordered_map<std::string, size_t> textureMap; // name -> index
     uint32_t version;
     GameVersion gameVersion;
+    std::shared_ptr<MappedFile> mapping; // Source file when loaded with LoadMode::Mapped
     
     // Helper functions
     bool readFromStream(std::istream& stream);
+    bool readFromMemory(const uint8_t* data, size_t size, const std::shared_ptr<const void>& backing,
+                        bool headersOnly = false);
     bool writeToStream(std::ostream& stream) const;
+    void write(ChunkWriter& writer) const;
     GameVersion detectGameVersion(uint32_t versionValue);
     void rebuildTextureMap();
 };
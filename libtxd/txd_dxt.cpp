@@ -0,0 +1,337 @@
+#include "txd_dxt.h"
+#include "txd_cpu.h"
+#include <cstring>
+#include <algorithm>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define TXD_DXT_X86
+#include <immintrin.h>
+#endif
+
+#if defined(TXD_DXT_X86) && (defined(__GNUC__) || defined(__clang__))
+#define TXD_TARGET_SSE2 __attribute__((target("sse2")))
+#define TXD_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define TXD_TARGET_SSE2
+#define TXD_TARGET_AVX2
+#endif
+
+namespace LibTXD {
+namespace DXT {
+
+namespace {
+
+// Expand a 565 endpoint the way squish does: replicate the high bits
+inline void unpack565(uint32_t value, uint32_t& r, uint32_t& g, uint32_t& b) {
+    r = (value >> 11) & 0x1F;
+    g = (value >> 5) & 0x3F;
+    b = value & 0x1F;
+    r = (r << 3) | (r >> 2);
+    g = (g << 2) | (g >> 4);
+    b = (b << 3) | (b >> 2);
+}
+
+inline uint32_t packRGBA(uint32_t r, uint32_t g, uint32_t b, uint32_t a) {
+    return r | (g << 8) | (b << 16) | (a << 24);
+}
+
+// The four colours of a block as little-endian RGBA words.
+// DXT3 colour blocks always use four-colour mode.
+inline void buildPalette(const uint8_t* colour, bool dxt1, uint32_t palette[4]) {
+    uint32_t a = colour[0] | (colour[1] << 8);
+    uint32_t b = colour[2] | (colour[3] << 8);
+
+    uint32_t r0, g0, b0, r1, g1, b1;
+    unpack565(a, r0, g0, b0);
+    unpack565(b, r1, g1, b1);
+
+    palette[0] = packRGBA(r0, g0, b0, 255);
+    palette[1] = packRGBA(r1, g1, b1, 255);
+
+    if (dxt1 && a <= b) {
+        palette[2] = packRGBA((r0 + r1) / 2, (g0 + g1) / 2, (b0 + b1) / 2, 255);
+        palette[3] = 0;
+    } else {
+        palette[2] = packRGBA((2 * r0 + r1) / 3, (2 * g0 + g1) / 3, (2 * b0 + b1) / 3, 255);
+        palette[3] = packRGBA((r0 + 2 * r1) / 3, (g0 + 2 * g1) / 3, (b0 + 2 * b1) / 3, 255);
+    }
+}
+
+inline uint32_t load32(const uint8_t* p) {
+    return p[0] | (p[1] << 8) | (p[2] << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+// Set bits in a word (portable; no compiler builtins)
+inline uint32_t countBits(uint32_t value) {
+    value = value - ((value >> 1) & 0x55555555u);
+    value = (value & 0x33333333u) + ((value >> 2) & 0x33333333u);
+    value = (value + (value >> 4)) & 0x0F0F0F0Fu;
+    return (value * 0x01010101u) >> 24;
+}
+
+inline void store32(uint8_t* p, uint32_t value) {
+    p[0] = static_cast<uint8_t>(value);
+    p[1] = static_cast<uint8_t>(value >> 8);
+    p[2] = static_cast<uint8_t>(value >> 16);
+    p[3] = static_cast<uint8_t>(value >> 24);
+}
+
+// Copy the visible part of a decoded 4x4 block (16 byte rows) to the image
+inline void storeClipped(const uint8_t* block, uint32_t columns, uint32_t rows, uint8_t* output, size_t outputStride) {
+    for (uint32_t y = 0; y < rows; y++) {
+        std::memcpy(output + y * outputStride, block + y * 16, columns * 4);
+    }
+}
+
+void decodeBlockScalar(const uint8_t* block, bool dxt3, uint8_t* output, size_t outputStride) {
+    const uint8_t* colour = dxt3 ? block + 8 : block;
+    uint32_t palette[4];
+    buildPalette(colour, !dxt3, palette);
+
+    uint32_t indices = load32(colour + 4);
+    for (uint32_t i = 0; i < 16; i++) {
+        uint32_t pixel = palette[(indices >> (2 * i)) & 3];
+        if (dxt3) {
+            uint32_t alpha = (block[i / 2] >> ((i & 1) * 4)) & 0x0F;
+            pixel = (pixel & 0x00FFFFFF) | ((alpha | (alpha << 4)) << 24);
+        }
+        store32(output + (i / 4) * outputStride + (i % 4) * 4, pixel);
+    }
+}
+
+void decodeRowScalar(const uint8_t* blocks, bool dxt3, uint32_t width, uint32_t rows, uint8_t* output, size_t outputStride) {
+    const size_t blockSize = dxt3 ? 16 : 8;
+    for (uint32_t x = 0; x < width; x += 4, blocks += blockSize) {
+        if (rows == 4 && x + 4 <= width) {
+            decodeBlockScalar(blocks, dxt3, output + x * 4, outputStride);
+        } else {
+            uint8_t temp[64];
+            decodeBlockScalar(blocks, dxt3, temp, 16);
+            storeClipped(temp, std::min(4u, width - x), rows, output + x * 4, outputStride);
+        }
+    }
+}
+
+#ifdef TXD_DXT_X86
+
+// Per-pixel alpha of a DXT3 block, already shifted into the top byte of
+// each 32-bit lane: a[0] = pixels 0-3, ..., a[3] = pixels 12-15
+TXD_TARGET_SSE2 inline void expandAlphaSSE2(const uint8_t* block, __m128i a[4]) {
+    const __m128i nibbleMask = _mm_set1_epi8(0x0F);
+    const __m128i zero = _mm_setzero_si128();
+
+    __m128i packed = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(block));
+    __m128i lo = _mm_and_si128(packed, nibbleMask);
+    __m128i hi = _mm_and_si128(_mm_srli_epi16(packed, 4), nibbleMask);
+    // Byte i is the alpha nibble of pixel i; widen to 8 bits as q | q << 4
+    __m128i nibbles = _mm_unpacklo_epi8(lo, hi);
+    __m128i alpha = _mm_or_si128(nibbles, _mm_slli_epi16(nibbles, 4));
+
+    __m128i low8 = _mm_unpacklo_epi8(zero, alpha);
+    __m128i high8 = _mm_unpackhi_epi8(zero, alpha);
+    a[0] = _mm_unpacklo_epi16(zero, low8);
+    a[1] = _mm_unpackhi_epi16(zero, low8);
+    a[2] = _mm_unpacklo_epi16(zero, high8);
+    a[3] = _mm_unpackhi_epi16(zero, high8);
+}
+
+TXD_TARGET_SSE2 inline void decodeBlockSSE2(const uint8_t* block, bool dxt3, uint8_t* output, size_t outputStride) {
+    const uint8_t* colour = dxt3 ? block + 8 : block;
+    uint32_t palette[4];
+    buildPalette(colour, !dxt3, palette);
+
+    const __m128i p0 = _mm_set1_epi32(static_cast<int>(palette[0]));
+    const __m128i p1 = _mm_set1_epi32(static_cast<int>(palette[1]));
+    const __m128i p2 = _mm_set1_epi32(static_cast<int>(palette[2]));
+    const __m128i p3 = _mm_set1_epi32(static_cast<int>(palette[3]));
+    const __m128i p01 = _mm_xor_si128(p0, p1);
+    const __m128i p23 = _mm_xor_si128(p2, p3);
+
+    // Every lane sees all 32 index bits; per-row masks pick out its own two
+    const __m128i indices = _mm_set1_epi32(static_cast<int>(load32(colour + 4)));
+    __m128i bit0 = _mm_setr_epi32(1 << 0, 1 << 2, 1 << 4, 1 << 6);
+    __m128i bit1 = _mm_setr_epi32(1 << 1, 1 << 3, 1 << 5, 1 << 7);
+
+    __m128i alpha[4];
+    const __m128i colourMask = _mm_set1_epi32(0x00FFFFFF);
+    if (dxt3) {
+        expandAlphaSSE2(block, alpha);
+    }
+
+    for (int row = 0; row < 4; row++) {
+        __m128i low = _mm_cmpeq_epi32(_mm_and_si128(indices, bit0), bit0);
+        __m128i high = _mm_cmpeq_epi32(_mm_and_si128(indices, bit1), bit1);
+
+        __m128i first = _mm_xor_si128(p0, _mm_and_si128(p01, low));
+        __m128i second = _mm_xor_si128(p2, _mm_and_si128(p23, low));
+        __m128i pixels = _mm_xor_si128(first, _mm_and_si128(_mm_xor_si128(first, second), high));
+
+        if (dxt3) {
+            pixels = _mm_or_si128(_mm_and_si128(pixels, colourMask), alpha[row]);
+        }
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(output + row * outputStride), pixels);
+
+        bit0 = _mm_slli_epi32(bit0, 8);
+        bit1 = _mm_slli_epi32(bit1, 8);
+    }
+}
+
+TXD_TARGET_SSE2 void decodeRowSSE2(const uint8_t* blocks, bool dxt3, uint32_t width, uint32_t rows, uint8_t* output, size_t outputStride) {
+    const size_t blockSize = dxt3 ? 16 : 8;
+    uint32_t x = 0;
+    // Interior blocks go straight to the image
+    if (rows == 4) {
+        for (; x + 4 <= width; x += 4, blocks += blockSize) {
+            decodeBlockSSE2(blocks, dxt3, output + x * 4, outputStride);
+        }
+    }
+    for (; x < width; x += 4, blocks += blockSize) {
+        uint8_t temp[64];
+        decodeBlockSSE2(blocks, dxt3, temp, 16);
+        storeClipped(temp, std::min(4u, width - x), rows, output + x * 4, outputStride);
+    }
+}
+
+TXD_TARGET_AVX2 inline void decodeBlockAVX2(const uint8_t* block, bool dxt3, uint8_t* output, size_t outputStride) {
+    const uint8_t* colour = dxt3 ? block + 8 : block;
+    uint32_t palette[4];
+    buildPalette(colour, !dxt3, palette);
+
+    const __m256i lookup = _mm256_setr_epi32(
+        static_cast<int>(palette[0]), static_cast<int>(palette[1]),
+        static_cast<int>(palette[2]), static_cast<int>(palette[3]),
+        static_cast<int>(palette[0]), static_cast<int>(palette[1]),
+        static_cast<int>(palette[2]), static_cast<int>(palette[3]));
+    const __m256i three = _mm256_set1_epi32(3);
+
+    // 2-bit indices of pixels 0-7 and 8-15, one per lane, then a table lookup
+    const __m256i indices = _mm256_set1_epi32(static_cast<int>(load32(colour + 4)));
+    const __m256i shiftLow = _mm256_setr_epi32(0, 2, 4, 6, 8, 10, 12, 14);
+    const __m256i shiftHigh = _mm256_setr_epi32(16, 18, 20, 22, 24, 26, 28, 30);
+    __m256i top = _mm256_permutevar8x32_epi32(lookup, _mm256_and_si256(_mm256_srlv_epi32(indices, shiftLow), three));
+    __m256i bottom = _mm256_permutevar8x32_epi32(lookup, _mm256_and_si256(_mm256_srlv_epi32(indices, shiftHigh), three));
+
+    if (dxt3) {
+        // Alpha nibbles of pixels 0-7 and 8-15, widened as q | q << 4 into the top byte
+        const __m256i nibbleMask = _mm256_set1_epi32(0x0F);
+        const __m256i colourMask = _mm256_set1_epi32(0x00FFFFFF);
+        const __m256i shiftNibble = _mm256_setr_epi32(0, 4, 8, 12, 16, 20, 24, 28);
+        __m256i alphaTop = _mm256_and_si256(_mm256_srlv_epi32(_mm256_set1_epi32(static_cast<int>(load32(block))), shiftNibble), nibbleMask);
+        __m256i alphaBottom = _mm256_and_si256(_mm256_srlv_epi32(_mm256_set1_epi32(static_cast<int>(load32(block + 4))), shiftNibble), nibbleMask);
+        alphaTop = _mm256_slli_epi32(_mm256_or_si256(alphaTop, _mm256_slli_epi32(alphaTop, 4)), 24);
+        alphaBottom = _mm256_slli_epi32(_mm256_or_si256(alphaBottom, _mm256_slli_epi32(alphaBottom, 4)), 24);
+        top = _mm256_or_si256(_mm256_and_si256(top, colourMask), alphaTop);
+        bottom = _mm256_or_si256(_mm256_and_si256(bottom, colourMask), alphaBottom);
+    }
+
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(output), _mm256_castsi256_si128(top));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(output + outputStride), _mm256_extracti128_si256(top, 1));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(output + 2 * outputStride), _mm256_castsi256_si128(bottom));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(output + 3 * outputStride), _mm256_extracti128_si256(bottom, 1));
+}
+
+TXD_TARGET_AVX2 void decodeRowAVX2(const uint8_t* blocks, bool dxt3, uint32_t width, uint32_t rows, uint8_t* output, size_t outputStride) {
+    const size_t blockSize = dxt3 ? 16 : 8;
+    uint32_t x = 0;
+    // Interior blocks go straight to the image
+    if (rows == 4) {
+        for (; x + 4 <= width; x += 4, blocks += blockSize) {
+            decodeBlockAVX2(blocks, dxt3, output + x * 4, outputStride);
+        }
+    }
+    for (; x < width; x += 4, blocks += blockSize) {
+        uint8_t temp[64];
+        decodeBlockAVX2(blocks, dxt3, temp, 16);
+        storeClipped(temp, std::min(4u, width - x), rows, output + x * 4, outputStride);
+    }
+}
+
+#endif // TXD_DXT_X86
+
+} // namespace
+
+bool isDecoderSupported(Decoder decoder) {
+    switch (decoder) {
+        case Decoder::Scalar:
+            return true;
+#ifdef TXD_DXT_X86
+        case Decoder::SSE2:
+            return CPU::hasSSE2();
+        case Decoder::AVX2:
+            return CPU::hasAVX2();
+#endif
+        default:
+            return false;
+    }
+}
+
+Decoder getBestDecoder() {
+    static const Decoder best = isDecoderSupported(Decoder::AVX2) ? Decoder::AVX2
+                              : isDecoderSupported(Decoder::SSE2) ? Decoder::SSE2
+                              : Decoder::Scalar;
+    return best;
+}
+
+void decodeBlockRow(
+    Decoder decoder,
+    const uint8_t* blocks,
+    bool dxt3,
+    uint32_t width,
+    uint32_t rows,
+    uint8_t* output,
+    size_t outputStride) {
+
+    switch (decoder) {
+#ifdef TXD_DXT_X86
+        case Decoder::AVX2:
+            decodeRowAVX2(blocks, dxt3, width, rows, output, outputStride);
+            return;
+        case Decoder::SSE2:
+            decodeRowSSE2(blocks, dxt3, width, rows, output, outputStride);
+            return;
+#endif
+        default:
+            decodeRowScalar(blocks, dxt3, width, rows, output, outputStride);
+            return;
+    }
+}
+
+void averageBlockRow(const uint8_t* blocks, bool dxt3, uint32_t blocksWide, uint8_t* output) {
+    const size_t blockSize = dxt3 ? 16 : 8;
+    for (uint32_t x = 0; x < blocksWide; x++, blocks += blockSize, output += 4) {
+        const uint8_t* colour = dxt3 ? blocks + 8 : blocks;
+        uint32_t palette[4];
+        buildPalette(colour, !dxt3, palette);
+
+        // Weight the palette by how often each 2-bit index occurs
+        uint32_t indices = load32(colour + 4);
+        uint32_t low = indices & 0x55555555u;
+        uint32_t high = (indices >> 1) & 0x55555555u;
+        uint32_t counts[4];
+        counts[1] = countBits(low & ~high);
+        counts[2] = countBits(high & ~low);
+        counts[3] = countBits(low & high);
+        counts[0] = 16 - counts[1] - counts[2] - counts[3];
+
+        uint32_t sum[4] = {0, 0, 0, 0};
+        for (uint32_t c = 0; c < 4; c++) {
+            for (uint32_t channel = 0; channel < 4; channel++) {
+                sum[channel] += counts[c] * ((palette[c] >> (8 * channel)) & 0xFF);
+            }
+        }
+        if (dxt3) {
+            // Explicit alpha replaces the palette's
+            sum[3] = 0;
+            for (uint32_t i = 0; i < 8; i++) {
+                sum[3] += ((blocks[i] & 0x0F) + (blocks[i] >> 4)) * 17;
+            }
+        }
+
+        for (uint32_t channel = 0; channel < 4; channel++) {
+            output[channel] = static_cast<uint8_t>((sum[channel] + 8) / 16);
+        }
+    }
+}
+
+} // namespace DXT
+} // namespace LibTXD
@@ -0,0 +1,48 @@
+#ifndef TXD_DXT_H
+#define TXD_DXT_H
+
+#include <cstdint>
+#include <cstddef>
+
+namespace LibTXD {
+
+// DXT1/DXT3 block decoding with SIMD implementations.
+// Every implementation produces exactly the same pixels as squish::Decompress.
+namespace DXT {
+
+enum class Decoder {
+    Scalar,
+    SSE2,
+    AVX2
+};
+
+// Fastest decoder the running CPU supports
+Decoder getBestDecoder();
+bool isDecoderSupported(Decoder decoder);
+
+// Decode one row of blocks into RGBA8.
+// blocks:      blocksWide consecutive DXT1 (8 byte) or DXT3 (16 byte) blocks
+// width:       image width in pixels (only the first `width` columns are written)
+// rows:        number of pixel rows to write, 1..4
+// output:      first pixel of the block row, rows are outputStride bytes apart
+// The decoder must be supported by the CPU.
+void decodeBlockRow(
+    Decoder decoder,
+    const uint8_t* blocks,
+    bool dxt3,
+    uint32_t width,
+    uint32_t rows,
+    uint8_t* output,
+    size_t outputStride
+);
+
+// Average each block of a block row into a single RGBA8 pixel, which decodes
+// the image at quarter size without expanding the texels. Blocks on the
+// right/bottom edge are averaged over all 16 texels.
+void averageBlockRow(const uint8_t* blocks, bool dxt3, uint32_t blocksWide, uint8_t* output);
+
+} // namespace DXT
+
+} // namespace LibTXD
+
+#endif // TXD_DXT_H
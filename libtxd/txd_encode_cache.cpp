@@ -0,0 +1,219 @@
+#include "txd_encode_cache.h"
+#include "txd_hash.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <thread>
+#include <vector>
+
+namespace LibTXD {
+
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr char EntryMagic[4] = {'T', 'X', 'E', 'C'};
+constexpr uint32_t EntryVersion = 1;
+constexpr const char* EntryExtension = ".bin";
+
+// Stored in front of every payload; a mismatch is treated as a miss
+struct EntryHeader {
+    char magic[4];
+    uint32_t version;
+    uint64_t hash;
+    uint32_t width;
+    uint32_t height;
+    uint32_t kind;
+    uint32_t settings;
+    uint64_t payloadSize;
+};
+
+bool matches(const EntryHeader& header, const EncodeCache::Key& key, size_t size) {
+    return std::memcmp(header.magic, EntryMagic, 4) == 0 && header.version == EntryVersion &&
+           header.hash == key.hash && header.width == key.width && header.height == key.height &&
+           header.kind == static_cast<uint32_t>(key.kind) && header.settings == key.settings &&
+           header.payloadSize == size;
+}
+
+} // namespace
+
+EncodeCache::EncodeCache(const std::string& directory, uint64_t maxSize)
+    : directory(directory), maxSize(maxSize) {
+}
+
+std::shared_ptr<EncodeCache> EncodeCache::open(const std::string& directory, uint64_t maxSize) {
+    std::error_code ec;
+    fs::create_directories(fs::u8path(directory), ec);
+    if (!fs::is_directory(fs::u8path(directory), ec)) {
+        return nullptr;
+    }
+
+    std::shared_ptr<EncodeCache> cache(new EncodeCache(directory, maxSize));
+
+    // Entries left by earlier runs count towards the limit
+    uint64_t total = 0;
+    for (fs::recursive_directory_iterator it(fs::u8path(directory), ec), end; !ec && it != end; it.increment(ec)) {
+        std::error_code entryError;
+        if (it->is_regular_file(entryError) && it->path().extension() == EntryExtension) {
+            total += it->file_size(entryError);
+        }
+    }
+    cache->size = total;
+    if (total > maxSize) {
+        cache->evict();
+    }
+    return cache;
+}
+
+EncodeCache::Key EncodeCache::makeKey(const uint8_t* rgbaData, uint32_t width, uint32_t height, Kind kind,
+                                      uint32_t settings) {
+    Key key;
+    key.width = width;
+    key.height = height;
+    key.kind = kind;
+    key.settings = settings;
+
+    uint64_t hash = Hash::hash64(rgbaData, static_cast<size_t>(width) * height * 4);
+    hash = Hash::combine(hash, (static_cast<uint64_t>(width) << 32) | height);
+    hash = Hash::combine(hash, (static_cast<uint64_t>(kind) << 32) | settings);
+    key.hash = hash;
+    return key;
+}
+
+std::string EncodeCache::getEntryPath(const Key& key) const {
+    // 256 subdirectories keep directory sizes reasonable for large caches
+    char name[32];
+    std::snprintf(name, sizeof(name), "%02x/%016llx", static_cast<unsigned>(key.hash >> 56),
+                  static_cast<unsigned long long>(key.hash));
+    return directory + "/" + name + EntryExtension;
+}
+
+bool EncodeCache::find(const Key& key, uint8_t* output, size_t size) {
+    const std::string path = getEntryPath(key);
+    std::ifstream file(fs::u8path(path), std::ios::binary);
+    EntryHeader header;
+    if (!file || !file.read(reinterpret_cast<char*>(&header), sizeof(header)) || !matches(header, key, size) ||
+        !file.read(reinterpret_cast<char*>(output), static_cast<std::streamsize>(size))) {
+        misses++;
+        return false;
+    }
+    file.close();
+
+    // Bump the modification time so eviction sees this entry as recently used
+    std::error_code ec;
+    fs::last_write_time(fs::u8path(path), fs::file_time_type::clock::now(), ec);
+    hits++;
+    return true;
+}
+
+void EncodeCache::store(const Key& key, const uint8_t* data, size_t payloadSize) {
+    const uint64_t entrySize = sizeof(EntryHeader) + payloadSize;
+    if (entrySize > maxSize) {
+        return;
+    }
+
+    EntryHeader header;
+    std::memcpy(header.magic, EntryMagic, 4);
+    header.version = EntryVersion;
+    header.hash = key.hash;
+    header.width = key.width;
+    header.height = key.height;
+    header.kind = static_cast<uint32_t>(key.kind);
+    header.settings = key.settings;
+    header.payloadSize = payloadSize;
+
+    const fs::path path = fs::u8path(getEntryPath(key));
+    std::error_code ec;
+    fs::create_directories(path.parent_path(), ec);
+
+    // Unique per thread and call, so concurrent writers of one key don't collide
+    char suffix[48];
+    std::snprintf(suffix, sizeof(suffix), ".%zx.%x.tmp", std::hash<std::thread::id>()(std::this_thread::get_id()),
+                  tempCounter++);
+    fs::path tempPath = path;
+    tempPath += suffix;
+    {
+        std::ofstream file(tempPath, std::ios::binary);
+        if (!file || !file.write(reinterpret_cast<const char*>(&header), sizeof(header)) ||
+            !file.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(payloadSize))) {
+            file.close();
+            fs::remove(tempPath, ec);
+            return;
+        }
+    }
+
+    // Replacing an entry with the same content is harmless
+    const bool existed = fs::exists(path, ec);
+    fs::rename(tempPath, path, ec);
+    if (ec) {
+        fs::remove(tempPath, ec);
+        return;
+    }
+    if (!existed && (size += entrySize) > maxSize) {
+        evict();
+    }
+}
+
+void EncodeCache::evict() {
+    // Another thread evicting will free enough for both
+    std::unique_lock<std::mutex> lock(evictMutex, std::try_to_lock);
+    if (!lock.owns_lock()) {
+        return;
+    }
+
+    struct Entry {
+        fs::file_time_type time;
+        uint64_t size;
+        fs::path path;
+    };
+    std::vector<Entry> entries;
+    uint64_t total = 0;
+    std::error_code ec;
+    for (fs::recursive_directory_iterator it(fs::u8path(directory), ec), end; !ec && it != end; it.increment(ec)) {
+        std::error_code entryError;
+        if (it->is_regular_file(entryError) && it->path().extension() == EntryExtension) {
+            Entry entry{it->last_write_time(entryError), it->file_size(entryError), it->path()};
+            if (!entryError) {
+                total += entry.size;
+                entries.push_back(std::move(entry));
+            }
+        }
+    }
+
+    // Oldest first, down to 3/4 of the limit so not every store evicts
+    std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) { return a.time < b.time; });
+    const uint64_t target = maxSize / 4 * 3;
+    for (const Entry& entry : entries) {
+        if (total <= target) {
+            break;
+        }
+        std::error_code removeError;
+        if (fs::remove(entry.path, removeError)) {
+            total -= entry.size;
+        }
+    }
+    size = total;
+}
+
+void EncodeCache::clear() {
+    std::lock_guard<std::mutex> lock(evictMutex);
+    // Only entry files are removed, in case the directory holds anything else
+    std::vector<fs::path> entries;
+    std::error_code ec;
+    for (fs::recursive_directory_iterator it(fs::u8path(directory), ec), end; !ec && it != end; it.increment(ec)) {
+        std::error_code entryError;
+        if (it->is_regular_file(entryError) && it->path().extension() == EntryExtension) {
+            entries.push_back(it->path());
+        }
+    }
+    for (const fs::path& path : entries) {
+        std::error_code removeError;
+        fs::remove(path, removeError);
+    }
+    size = 0;
+}
+
+} // namespace LibTXD
@@ -0,0 +1,76 @@
+#ifndef TXD_ENCODE_CACHE_H
+#define TXD_ENCODE_CACHE_H
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <memory>
+#include <mutex>
+#include <atomic>
+
+namespace LibTXD {
+
+// Persistent on-disk cache of encoder output (DXT blocks, palettes), keyed by
+// a hash of the RGBA8 input plus everything else that affects the result.
+// Entries are written to a temporary file and renamed into place, so readers
+// never lock and several threads or processes can share one directory.
+// The total size is bounded; the least recently used entries are evicted.
+class EncodeCache {
+public:
+    static constexpr uint64_t DefaultMaxSize = uint64_t(1) << 30;
+
+    // What produced an entry
+    enum class Kind : uint32_t {
+        DXT1 = 1,
+        DXT3 = 2,
+        Palette16 = 3,
+        Palette256 = 4
+    };
+
+    struct Key {
+        uint64_t hash = 0;       // Pixels and all fields below
+        uint32_t width = 0;
+        uint32_t height = 0;
+        Kind kind = Kind::DXT1;
+        uint32_t settings = 0;   // Encoder flags/speed that change the output
+    };
+
+    // Open (creating if needed) a cache directory, returns nullptr on failure
+    static std::shared_ptr<EncodeCache> open(const std::string& directory, uint64_t maxSize = DefaultMaxSize);
+
+    static Key makeKey(const uint8_t* rgbaData, uint32_t width, uint32_t height, Kind kind, uint32_t settings);
+
+    // Copy a cached result of exactly `size` bytes into `output`.
+    // Returns false on a miss, or if the entry doesn't match the key.
+    bool find(const Key& key, uint8_t* output, size_t size);
+
+    // Add a result; evicts old entries if the cache grows past its limit
+    void store(const Key& key, const uint8_t* data, size_t size);
+
+    // Remove every entry
+    void clear();
+
+    const std::string& getDirectory() const { return directory; }
+    uint64_t getMaxSize() const { return maxSize; }
+    uint64_t getSize() const { return size; }
+    uint64_t getHits() const { return hits; }
+    uint64_t getMisses() const { return misses; }
+
+private:
+    EncodeCache(const std::string& directory, uint64_t maxSize);
+
+    std::string getEntryPath(const Key& key) const;
+    void evict();
+
+    std::string directory;
+    uint64_t maxSize;
+    std::atomic<uint64_t> size{0};
+    std::atomic<uint64_t> hits{0};
+    std::atomic<uint64_t> misses{0};
+    std::atomic<uint32_t> tempCounter{0};
+    std::mutex evictMutex;  // Writers only; one eviction pass at a time
+};
+
+} // namespace LibTXD
+
+#endif // TXD_ENCODE_CACHE_H
@@ -0,0 +1,25 @@
+#ifndef TXD_HASH_H
+#define TXD_HASH_H
+
+#include <cstdint>
+#include <cstddef>
+
+namespace LibTXD {
+
+// Fast non-cryptographic content hashing (XXH64), used to key cached
+// encoder output and to detect changed images. Several GB/s per core.
+namespace Hash {
+
+uint64_t hash64(const void* data, size_t size, uint64_t seed = 0);
+
+// Fold a value into an existing hash, for keys built from several fields
+inline uint64_t combine(uint64_t hash, uint64_t value) {
+    hash ^= value + 0x9E3779B97F4A7C15ull + (hash << 6) + (hash >> 2);
+    return hash;
+}
+
+} // namespace Hash
+
+} // namespace LibTXD
+
+#endif // TXD_HASH_H
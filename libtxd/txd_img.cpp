@@ -0,0 +1,236 @@
+#include "txd_img.h"
+#include "txd_dictionary.h"
+#include "txd_texture.h"
+#include "txd_reader.h"
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+namespace LibTXD {
+
+namespace fs = std::filesystem;
+
+namespace {
+
+constexpr size_t DirectoryEntrySize = 32;
+constexpr size_t NameSize = 24;
+constexpr size_t V2HeaderSize = 8;
+
+std::string toLower(std::string text) {
+    std::transform(text.begin(), text.end(), text.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return text;
+}
+
+std::string readName(const uint8_t* field) {
+    const char* name = reinterpret_cast<const char*>(field);
+    return std::string(name, strnlen(name, NameSize));
+}
+
+void store32(uint8_t* p, uint32_t value) {
+    p[0] = static_cast<uint8_t>(value);
+    p[1] = static_cast<uint8_t>(value >> 8);
+    p[2] = static_cast<uint8_t>(value >> 16);
+    p[3] = static_cast<uint8_t>(value >> 24);
+}
+
+} // namespace
+
+ImgArchive::ImgArchive() : version(Version::V2), firstDataSector(0) {
+}
+
+ImgArchive::~ImgArchive() = default;
+
+bool ImgArchive::open(const std::string& imgPath) {
+    close();
+    path = imgPath;
+    mapping = MappedFile::open(imgPath);
+    if (!mapping || !readDirectory()) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+void ImgArchive::close() {
+    mapping.reset();
+    entries.clear();
+    entryMap.clear();
+}
+
+std::string ImgArchive::getDirectoryPath() const {
+    fs::path dirPath = fs::u8path(path);
+    dirPath.replace_extension(".dir");
+    std::error_code ec;
+    if (!fs::exists(dirPath, ec)) {
+        dirPath.replace_extension(".DIR");
+    }
+    return dirPath.u8string();
+}
+
+bool ImgArchive::readDirectory() {
+    entries.clear();
+    entryMap.clear();
+
+    const uint8_t* directory = nullptr;
+    size_t count = 0;
+    std::vector<uint8_t> dirFile;
+
+    ChunkReader reader(mapping->getData(), mapping->getSize());
+    uint32_t magic = 0;
+    if (reader.has(V2HeaderSize) && std::memcmp(mapping->getData(), "VER2", 4) == 0) {
+        // Version 2: count and entries follow the magic
+        version = Version::V2;
+        uint32_t entryCount = 0;
+        reader.readU32(magic);
+        reader.readU32(entryCount);
+        if (!reader.readView(static_cast<size_t>(entryCount) * DirectoryEntrySize, directory)) {
+            return false;
+        }
+        count = entryCount;
+        firstDataSector = static_cast<uint32_t>((V2HeaderSize + count * DirectoryEntrySize + SectorSize - 1) / SectorSize);
+    } else {
+        // Version 1: the directory is a separate file of bare entries
+        version = Version::V1;
+        firstDataSector = 0;
+        std::ifstream file(fs::u8path(getDirectoryPath()), std::ios::binary | std::ios::ate);
+        if (!file) {
+            return false;
+        }
+        std::streamsize size = file.tellg();
+        file.seekg(0);
+        dirFile.resize(static_cast<size_t>(size));
+        if (!file.read(reinterpret_cast<char*>(dirFile.data()), size) || dirFile.size() % DirectoryEntrySize != 0) {
+            return false;
+        }
+        directory = dirFile.data();
+        count = dirFile.size() / DirectoryEntrySize;
+    }
+
+    entries.reserve(count);
+    for (size_t i = 0; i < count; i++) {
+        const uint8_t* record = directory + i * DirectoryEntrySize;
+        Entry entry;
+        entry.offset = ChunkReader::load32(record);
+        if (version == Version::V2) {
+            // Streaming size, or the archive size if that is zero
+            uint16_t streamingSize = ChunkReader::load16(record + 4);
+            uint16_t archiveSize = ChunkReader::load16(record + 6);
+            entry.sectors = streamingSize != 0 ? streamingSize : archiveSize;
+        } else {
+            entry.sectors = ChunkReader::load32(record + 4);
+        }
+        entry.name = readName(record + 8);
+        entryMap.emplace(toLower(entry.name), entries.size());
+        entries.push_back(std::move(entry));
+    }
+    return true;
+}
+
+const ImgArchive::Entry* ImgArchive::findEntry(const std::string& name) const {
+    auto it = entryMap.find(toLower(name));
+    return it != entryMap.end() ? &entries[it->second] : nullptr;
+}
+
+ByteSpan ImgArchive::getData(const Entry& entry) const {
+    if (!mapping) {
+        return ByteSpan();
+    }
+    const uint64_t start = uint64_t(entry.offset) * SectorSize;
+    if (start >= mapping->getSize()) {
+        return ByteSpan();
+    }
+    const uint64_t size = std::min<uint64_t>(uint64_t(entry.sectors) * SectorSize, mapping->getSize() - start);
+    return ByteSpan(mapping->getData() + start, static_cast<size_t>(size));
+}
+
+bool ImgArchive::loadDictionary(const Entry& entry, TextureDictionary& dict) const {
+    ByteSpan data = getData(entry);
+    if (!data.ptr) {
+        return false;
+    }
+    return dict.load(data.ptr, data.length, mapping);
+}
+
+uint32_t ImgArchive::getCapacity(const Entry& entry) const {
+    if (!mapping || entry.offset < firstDataSector) {
+        return 0;
+    }
+    uint64_t end = (mapping->getSize() + SectorSize - 1) / SectorSize;
+    for (const Entry& other : entries) {
+        if (other.offset > entry.offset && other.offset < end) {
+            end = other.offset;
+        }
+    }
+    return end > entry.offset ? static_cast<uint32_t>(end - entry.offset) : 0;
+}
+
+bool ImgArchive::replaceEntry(const Entry& entry, const uint8_t* data, size_t size) {
+    if (!mapping || &entry < entries.data() || &entry >= entries.data() + entries.size()) {
+        return false;
+    }
+    const size_t index = static_cast<size_t>(&entry - entries.data());
+    const uint32_t sectors = static_cast<uint32_t>((size + SectorSize - 1) / SectorSize);
+    if (sectors == 0 || sectors > getCapacity(entry) || (version == Version::V2 && sectors > 0xFFFF)) {
+        return false;
+    }
+    const uint64_t offset = uint64_t(entry.offset) * SectorSize;
+
+    // Write through a separate handle; our own read-only mapping is released
+    // and opened again afterwards so it shows the new contents
+    mapping.reset();
+    bool ok = false;
+    {
+        std::fstream file(fs::u8path(path), std::ios::binary | std::ios::in | std::ios::out);
+        if (file) {
+            // Pad the last sector with zeroes
+            std::vector<uint8_t> padding(static_cast<size_t>(sectors) * SectorSize - size, 0);
+            file.seekp(static_cast<std::streamoff>(offset));
+            file.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(size));
+            file.write(reinterpret_cast<const char*>(padding.data()), static_cast<std::streamsize>(padding.size()));
+
+            if (version == Version::V2) {
+                // Streaming size and archive size
+                uint8_t sizes[4];
+                sizes[0] = static_cast<uint8_t>(sectors);
+                sizes[1] = static_cast<uint8_t>(sectors >> 8);
+                sizes[2] = 0;
+                sizes[3] = 0;
+                file.seekp(static_cast<std::streamoff>(V2HeaderSize + index * DirectoryEntrySize + 4));
+                file.write(reinterpret_cast<const char*>(sizes), 4);
+            }
+            ok = static_cast<bool>(file.flush());
+        }
+    }
+    if (ok && version == Version::V1) {
+        std::fstream dirFile(fs::u8path(getDirectoryPath()), std::ios::binary | std::ios::in | std::ios::out);
+        uint8_t field[4];
+        store32(field, sectors);
+        dirFile.seekp(static_cast<std::streamoff>(index * DirectoryEntrySize + 4));
+        ok = dirFile && dirFile.write(reinterpret_cast<const char*>(field), 4) && dirFile.flush();
+    }
+
+    const std::string imgPath = path;
+    return open(imgPath) && ok;
+}
+
+bool ImgArchive::saveDictionary(const Entry& entry, TextureDictionary& dict) {
+    std::ostringstream stream(std::ios::binary);
+    if (!dict.save(stream)) {
+        return false;
+    }
+    const std::string data = stream.str();
+    if ((data.size() + SectorSize - 1) / SectorSize > getCapacity(entry)) {
+        return false;
+    }
+
+    // The dictionary may view this very entry, which is about to be overwritten
+    for (size_t i = 0; i < dict.getTextureCount(); i++) {
+        dict.getTexture(i)->detach();
+    }
+    return replaceEntry(entry, reinterpret_cast<const uint8_t*>(data.data()), data.size());
+}
+
+} // namespace LibTXD
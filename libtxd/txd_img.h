@@ -0,0 +1,88 @@
+#ifndef TXD_IMG_H
+#define TXD_IMG_H
+
+#include "txd_types.h"
+#include "txd_mapped_file.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <memory>
+#include <unordered_map>
+
+namespace LibTXD {
+
+class TextureDictionary;
+
+// GTA IMG archive: version 1 (GTA3/VC, directory in a separate .dir file)
+// or version 2 (SA, "VER2" directory at the start of the .img).
+// The archive is memory mapped and entries are handed out as views into the
+// mapping, so TXDs load straight from it without copying.
+class ImgArchive {
+public:
+    static constexpr uint32_t SectorSize = 2048;
+
+    enum class Version {
+        V1,
+        V2
+    };
+
+    struct Entry {
+        std::string name;
+        uint32_t offset = 0;   // In sectors
+        uint32_t sectors = 0;
+    };
+
+    ImgArchive();
+    ~ImgArchive();
+
+    // Open an .img file; for version 1 archives the .dir next to it is read
+    bool open(const std::string& imgPath);
+    void close();
+    bool isOpen() const { return mapping != nullptr; }
+
+    Version getVersion() const { return version; }
+    const std::string& getPath() const { return path; }
+
+    size_t getEntryCount() const { return entries.size(); }
+    const Entry& getEntry(size_t index) const { return entries[index]; }
+    // Case-insensitive; nullptr if there is no such entry
+    const Entry* findEntry(const std::string& name) const;
+
+    // The entry's bytes (whole sectors, clipped to the end of the file)
+    ByteSpan getData(const Entry& entry) const;
+    // Keeps the mapping behind getData() alive
+    std::shared_ptr<const void> getBacking() const { return mapping; }
+
+    // Load a TXD entry without copying; its textures keep the archive mapped
+    bool loadDictionary(const Entry& entry, TextureDictionary& dict) const;
+
+    // Sectors the entry can grow to in place: up to the next entry, or the
+    // end of the file for the last one. 0 for an entry that starts inside
+    // the v2 directory, which must never be written over.
+    uint32_t getCapacity(const Entry& entry) const;
+
+    // Overwrite an entry's contents if `size` fits its capacity, updating the
+    // directory's size field. The archive is mapped again afterwards, so
+    // Entry references and getData() views from before are invalidated, and
+    // data loaded from this entry must no longer be used.
+    bool replaceEntry(const Entry& entry, const uint8_t* data, size_t size);
+
+    // Write a TXD back into its entry in place. The dictionary is detached
+    // from the archive first, so it stays usable.
+    bool saveDictionary(const Entry& entry, TextureDictionary& dict);
+
+private:
+    bool readDirectory();
+    std::string getDirectoryPath() const;
+
+    std::shared_ptr<MappedFile> mapping;
+    std::string path;
+    Version version;
+    uint32_t firstDataSector;  // Sectors before it hold the v2 directory
+    std::vector<Entry> entries;
+    std::unordered_map<std::string, size_t> entryMap;  // Lowercase name -> index
+};
+
+} // namespace LibTXD
+
+#endif // TXD_IMG_H
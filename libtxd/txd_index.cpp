@@ -0,0 +1,448 @@
+#include "txd_index.h"
+#include "txd_texture.h"
+#include "txd_reader.h"
+#include "txd_parallel.h"
+#include "txd_hash.h"
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <unordered_map>
+
+namespace LibTXD {
+
+namespace fs = std::filesystem;
+
+struct TextureIndex::Header {
+    char magic[4];
+    uint32_t version;
+    uint32_t fileCount;
+    uint32_t textureCount;
+    uint32_t rootOffset;
+    uint32_t rootLength;
+    uint64_t stringsOffset;   // Position of the string pool in the file
+    uint64_t stringsSize;
+};
+
+struct TextureIndex::FileRecord {
+    uint32_t pathOffset;
+    uint32_t pathLength;
+    uint64_t size;
+    int64_t time;
+};
+
+struct TextureIndex::TextureRecord {
+    uint64_t hash;
+    uint32_t nameOffset;
+    uint32_t nameLength;
+    uint32_t file;
+    uint32_t offset;
+    uint32_t size;
+    uint16_t width;
+    uint16_t height;
+    uint32_t rasterFormat;
+    uint8_t compression;
+    uint8_t mipmapCount;
+    uint8_t hasAlpha;
+    uint8_t reserved;
+};
+
+namespace {
+
+constexpr char IndexMagic[4] = {'T', 'X', 'D', 'I'};
+constexpr uint32_t IndexVersion = 1;
+
+std::string toLower(std::string text) {
+    std::transform(text.begin(), text.end(), text.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return text;
+}
+
+bool getStamp(const fs::path& path, uint64_t& size, int64_t& time) {
+    std::error_code ec;
+    size = fs::file_size(path, ec);
+    if (ec) {
+        return false;
+    }
+    time = static_cast<int64_t>(fs::last_write_time(path, ec).time_since_epoch().count());
+    return !ec;
+}
+
+// A texture on its way into a new index
+struct Entry {
+    std::string name;
+    uint32_t file = 0;
+    IndexedTexture texture;
+};
+
+struct FileInfo {
+    std::string path;   // Relative, '/' separated
+    uint64_t size = 0;
+    int64_t time = 0;
+    bool valid = false;
+};
+
+// Walk one TXD and collect its textures; only texture headers, mip sizes
+// and the top level pixels (for the content hash) are read
+bool scanFile(const fs::path& path, std::vector<IndexedTexture>& textures) {
+    std::shared_ptr<MappedFile> file = MappedFile::open(path.u8string());
+    if (!file) {
+        return false;
+    }
+
+    ChunkReader reader(file->getData(), file->getSize());
+    ChunkHeader header;
+    if (!reader.readHeader(header) || header.type != ChunkType::TEXDICTIONARY) {
+        return false;
+    }
+
+    ChunkReader section = reader.child(header.length);
+    while (section.remaining() >= 12) {
+        const uint8_t* childStart = section.current();
+        ChunkHeader childHeader;
+        section.readHeader(childHeader);
+        ChunkReader child = section.child(childHeader.length);
+        if (childHeader.type != ChunkType::TEXTURENATIVE) {
+            continue;
+        }
+
+        // Mip levels are views into the mapping; a texture whose levels
+        // don't fit its section is skipped, as when loading the TXD
+        Texture texture;
+        if (!texture.readD3D(childStart, 12 + child.size(), file)) {
+            continue;
+        }
+        IndexedTexture entry;
+        entry.name = toLower(texture.getName());
+        entry.offset = static_cast<uint32_t>(childStart - file->getData());
+        entry.size = static_cast<uint32_t>(12 + child.size());
+        entry.width = texture.getWidth();
+        entry.height = texture.getHeight();
+        entry.mipmapCount = texture.getMipmapCount();
+        entry.rasterFormat = texture.getRasterFormat();
+        entry.compression = texture.getCompression();
+        entry.hasAlpha = texture.hasAlpha();
+
+        uint64_t hash = Hash::hash64(nullptr, 0);
+        if (entry.mipmapCount > 0) {
+            const MipmapLevel& level = texture.getMipmap(0);
+            hash = Hash::hash64(level.getData(), level.dataSize);
+        }
+        ByteSpan palette = texture.getPalette();
+        if (palette.length > 0) {
+            hash = Hash::combine(hash, Hash::hash64(palette.ptr, palette.length));
+        }
+        entry.contentHash = hash;
+        textures.push_back(std::move(entry));
+    }
+    return true;
+}
+
+bool writeIndex(const fs::path& path, const std::string& root, const std::vector<FileInfo>& files,
+                const std::vector<Entry>& entries) {
+    // Only files that made it in are stored; remap their numbers
+    std::vector<uint32_t> fileNumbers(files.size(), 0);
+    uint32_t fileCount = 0;
+    for (size_t i = 0; i < files.size(); i++) {
+        if (files[i].valid) {
+            fileNumbers[i] = fileCount++;
+        }
+    }
+
+    std::string strings;
+    auto addString = [&strings](const std::string& text, uint32_t& offset, uint32_t& length) {
+        offset = static_cast<uint32_t>(strings.size());
+        length = static_cast<uint32_t>(text.size());
+        strings += text;
+    };
+
+    TextureIndex::Header header;
+    std::memcpy(header.magic, IndexMagic, 4);
+    header.version = IndexVersion;
+    header.fileCount = fileCount;
+    header.textureCount = static_cast<uint32_t>(entries.size());
+    addString(root, header.rootOffset, header.rootLength);
+
+    std::vector<TextureIndex::FileRecord> fileRecords;
+    fileRecords.reserve(fileCount);
+    for (const FileInfo& info : files) {
+        if (info.valid) {
+            TextureIndex::FileRecord record;
+            addString(info.path, record.pathOffset, record.pathLength);
+            record.size = info.size;
+            record.time = info.time;
+            fileRecords.push_back(record);
+        }
+    }
+
+    std::vector<TextureIndex::TextureRecord> textureRecords;
+    textureRecords.reserve(entries.size());
+    for (const Entry& entry : entries) {
+        const IndexedTexture& t = entry.texture;
+        TextureIndex::TextureRecord record;
+        std::memset(&record, 0, sizeof(record));
+        record.hash = t.contentHash;
+        addString(entry.name, record.nameOffset, record.nameLength);
+        record.file = fileNumbers[entry.file];
+        record.offset = t.offset;
+        record.size = t.size;
+        record.width = static_cast<uint16_t>(t.width);
+        record.height = static_cast<uint16_t>(t.height);
+        record.rasterFormat = static_cast<uint32_t>(t.rasterFormat);
+        record.compression = static_cast<uint8_t>(t.compression);
+        record.mipmapCount = static_cast<uint8_t>(t.mipmapCount);
+        record.hasAlpha = t.hasAlpha ? 1 : 0;
+        textureRecords.push_back(record);
+    }
+
+    header.stringsOffset = sizeof(header) + fileRecords.size() * sizeof(TextureIndex::FileRecord) +
+                           textureRecords.size() * sizeof(TextureIndex::TextureRecord);
+    header.stringsSize = strings.size();
+
+    // Write-and-rename, like TextureDictionary::save
+    fs::path tempPath = path;
+    tempPath += ".tmp";
+    std::error_code ec;
+    {
+        std::ofstream out(tempPath, std::ios::binary);
+        out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        out.write(reinterpret_cast<const char*>(fileRecords.data()),
+                  static_cast<std::streamsize>(fileRecords.size() * sizeof(TextureIndex::FileRecord)));
+        out.write(reinterpret_cast<const char*>(textureRecords.data()),
+                  static_cast<std::streamsize>(textureRecords.size() * sizeof(TextureIndex::TextureRecord)));
+        out.write(strings.data(), static_cast<std::streamsize>(strings.size()));
+        if (!out) {
+            out.close();
+            fs::remove(tempPath, ec);
+            return false;
+        }
+    }
+    fs::rename(tempPath, path, ec);
+    if (ec) {
+        fs::remove(tempPath, ec);
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+static_assert(sizeof(TextureIndex::Header) == 40, "index header layout");
+static_assert(sizeof(TextureIndex::FileRecord) == 24, "index file record layout");
+static_assert(sizeof(TextureIndex::TextureRecord) == 40, "index texture record layout");
+
+TextureIndex::TextureIndex() = default;
+TextureIndex::~TextureIndex() = default;
+
+IndexBuildResult TextureIndex::build(const std::string& rootPath, const std::string& indexPath) {
+    IndexBuildResult result;
+    std::error_code ec;
+    const fs::path rootDir = fs::absolute(fs::u8path(rootPath), ec).lexically_normal();
+    if (ec || !fs::is_directory(rootDir, ec)) {
+        return result;
+    }
+    const std::string root = rootDir.generic_u8string();
+
+    // Every .txd below the root, in path order
+    std::vector<FileInfo> files;
+    for (fs::recursive_directory_iterator it(rootDir, ec), end; !ec && it != end; it.increment(ec)) {
+        std::error_code entryError;
+        if (it->is_regular_file(entryError) && toLower(it->path().extension().u8string()) == ".txd") {
+            FileInfo info;
+            info.path = it->path().lexically_relative(rootDir).generic_u8string();
+            files.push_back(std::move(info));
+        }
+    }
+    std::sort(files.begin(), files.end(), [](const FileInfo& a, const FileInfo& b) { return a.path < b.path; });
+
+    // Entries of the previous index, by file, for files that didn't change
+    TextureIndex previous;
+    std::unordered_map<std::string, size_t> previousFiles;
+    std::vector<std::vector<size_t>> previousTextures;
+    if (previous.open(indexPath) && previous.getRoot() == root) {
+        previousTextures.resize(previous.getFileCount());
+        for (size_t i = 0; i < previous.getFileCount(); i++) {
+            previousFiles[previous.getFile(i)] = i;
+        }
+        for (size_t i = 0; i < previous.getTextureCount(); i++) {
+            previousTextures[previous.getTextures()[i].file].push_back(i);
+        }
+    }
+
+    std::vector<std::vector<IndexedTexture>> textures(files.size());
+    std::atomic<size_t> scanned{0};
+    std::atomic<size_t> reused{0};
+    Parallel::parallelFor(files.size(), 1, [&](size_t first, size_t last) {
+        for (size_t i = first; i < last; i++) {
+            FileInfo& info = files[i];
+            const fs::path path = rootDir / fs::u8path(info.path);
+            if (!getStamp(path, info.size, info.time)) {
+                continue;
+            }
+
+            auto known = previousFiles.find(info.path);
+            if (known != previousFiles.end()) {
+                const FileRecord& record = previous.getFiles()[known->second];
+                if (record.size == info.size && record.time == info.time) {
+                    for (size_t t : previousTextures[known->second]) {
+                        textures[i].push_back(previous.getTexture(t));
+                    }
+                    info.valid = true;
+                    reused++;
+                    continue;
+                }
+            }
+
+            info.valid = scanFile(path, textures[i]);
+            scanned++;
+        }
+    });
+    previous.close();
+
+    std::vector<Entry> entries;
+    for (size_t i = 0; i < files.size(); i++) {
+        if (!files[i].valid) {
+            result.failed++;
+            continue;
+        }
+        result.files++;
+        for (IndexedTexture& texture : textures[i]) {
+            Entry entry;
+            entry.name = texture.name;
+            entry.file = static_cast<uint32_t>(i);
+            entry.texture = std::move(texture);
+            entries.push_back(std::move(entry));
+        }
+    }
+    // Files are already in path order, so equal names stay ordered by file
+    std::stable_sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) { return a.name < b.name; });
+
+    result.scanned = scanned;
+    result.reused = reused;
+    result.textures = entries.size();
+    result.ok = writeIndex(fs::u8path(indexPath), root, files, entries);
+    return result;
+}
+
+bool TextureIndex::open(const std::string& indexPath) {
+    close();
+    std::shared_ptr<MappedFile> file = MappedFile::open(indexPath);
+    if (!file || file->getSize() < sizeof(Header)) {
+        return false;
+    }
+
+    // Check every table and string lies inside the file, so lookups need no checks
+    const Header* header = reinterpret_cast<const Header*>(file->getData());
+    const uint64_t tablesSize = sizeof(Header) + uint64_t(header->fileCount) * sizeof(FileRecord) +
+                                uint64_t(header->textureCount) * sizeof(TextureRecord);
+    if (std::memcmp(header->magic, IndexMagic, 4) != 0 || header->version != IndexVersion ||
+        header->stringsOffset != tablesSize || tablesSize + header->stringsSize > file->getSize()) {
+        return false;
+    }
+    auto stringFits = [header](uint32_t offset, uint32_t length) {
+        return uint64_t(offset) + length <= header->stringsSize;
+    };
+    const FileRecord* files = reinterpret_cast<const FileRecord*>(file->getData() + sizeof(Header));
+    const TextureRecord* textures = reinterpret_cast<const TextureRecord*>(files + header->fileCount);
+    bool valid = stringFits(header->rootOffset, header->rootLength);
+    for (uint32_t i = 0; valid && i < header->fileCount; i++) {
+        valid = stringFits(files[i].pathOffset, files[i].pathLength);
+    }
+    for (uint32_t i = 0; valid && i < header->textureCount; i++) {
+        valid = stringFits(textures[i].nameOffset, textures[i].nameLength) && textures[i].file < header->fileCount;
+    }
+    if (!valid) {
+        return false;
+    }
+
+    mapping = std::move(file);
+    root = getString(header->rootOffset, header->rootLength);
+    return true;
+}
+
+void TextureIndex::close() {
+    mapping.reset();
+    root.clear();
+}
+
+const TextureIndex::Header* TextureIndex::getHeader() const {
+    return reinterpret_cast<const Header*>(mapping->getData());
+}
+
+const TextureIndex::FileRecord* TextureIndex::getFiles() const {
+    return reinterpret_cast<const FileRecord*>(mapping->getData() + sizeof(Header));
+}
+
+const TextureIndex::TextureRecord* TextureIndex::getTextures() const {
+    return reinterpret_cast<const TextureRecord*>(getFiles() + getHeader()->fileCount);
+}
+
+std::string TextureIndex::getString(uint32_t offset, uint32_t length) const {
+    const char* strings = reinterpret_cast<const char*>(mapping->getData() + getHeader()->stringsOffset);
+    return std::string(strings + offset, length);
+}
+
+int TextureIndex::compareName(const TextureRecord& record, const std::string& name) const {
+    const char* strings = reinterpret_cast<const char*>(mapping->getData() + getHeader()->stringsOffset);
+    int result = std::memcmp(strings + record.nameOffset, name.data(), std::min<size_t>(record.nameLength, name.size()));
+    if (result != 0) {
+        return result;
+    }
+    return record.nameLength < name.size() ? -1 : (record.nameLength > name.size() ? 1 : 0);
+}
+
+size_t TextureIndex::getTextureCount() const {
+    return mapping ? getHeader()->textureCount : 0;
+}
+
+size_t TextureIndex::getFileCount() const {
+    return mapping ? getHeader()->fileCount : 0;
+}
+
+std::string TextureIndex::getFile(size_t index) const {
+    if (!mapping || index >= getFileCount()) {
+        return std::string();
+    }
+    const FileRecord& record = getFiles()[index];
+    return getString(record.pathOffset, record.pathLength);
+}
+
+IndexedTexture TextureIndex::getTexture(size_t index) const {
+    IndexedTexture texture;
+    if (!mapping || index >= getTextureCount()) {
+        return texture;
+    }
+    const TextureRecord& record = getTextures()[index];
+    texture.name = getString(record.nameOffset, record.nameLength);
+    texture.file = getFile(record.file);
+    texture.offset = record.offset;
+    texture.size = record.size;
+    texture.width = record.width;
+    texture.height = record.height;
+    texture.mipmapCount = record.mipmapCount;
+    texture.rasterFormat = static_cast<RasterFormat>(record.rasterFormat);
+    texture.compression = static_cast<Compression>(record.compression);
+    texture.hasAlpha = record.hasAlpha != 0;
+    texture.contentHash = record.hash;
+    return texture;
+}
+
+std::vector<IndexedTexture> TextureIndex::find(const std::string& name) const {
+    std::vector<IndexedTexture> found;
+    if (!mapping) {
+        return found;
+    }
+    const std::string key = toLower(name);
+    const TextureRecord* begin = getTextures();
+    const TextureRecord* end = begin + getHeader()->textureCount;
+    const TextureRecord* it = std::lower_bound(begin, end, key, [this](const TextureRecord& record, const std::string& k) {
+        return compareName(record, k) < 0;
+    });
+    for (; it != end && compareName(*it, key) == 0; ++it) {
+        found.push_back(getTexture(static_cast<size_t>(it - begin)));
+    }
+    return found;
+}
+
+} // namespace LibTXD
@@ -0,0 +1,86 @@
+#ifndef TXD_INDEX_H
+#define TXD_INDEX_H
+
+#include "txd_types.h"
+#include "txd_mapped_file.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <memory>
+
+namespace LibTXD {
+
+// One texture found by a TextureIndex lookup
+struct IndexedTexture {
+    std::string name;        // Lowercase
+    std::string file;        // TXD path, relative to the indexed directory
+    uint32_t offset = 0;     // TEXTURENATIVE chunk position within the file
+    uint32_t size = 0;       // Chunk size, header included
+    uint32_t width = 0;
+    uint32_t height = 0;
+    uint32_t mipmapCount = 0;
+    RasterFormat rasterFormat = RasterFormat::DEFAULT;
+    Compression compression = Compression::NONE;
+    bool hasAlpha = false;
+    uint64_t contentHash = 0;  // XXH64 of the top level pixels (and palette)
+};
+
+struct IndexBuildResult {
+    bool ok = false;
+    size_t files = 0;      // TXD files in the index
+    size_t scanned = 0;    // Files parsed in this run
+    size_t reused = 0;     // Unchanged files whose entries were kept
+    size_t failed = 0;     // Files that are not valid TXDs
+    size_t textures = 0;
+};
+
+// Name lookup over every TXD below a game directory, answered from a
+// compact index file without opening any TXD. The file is memory mapped
+// and holds a table of textures sorted by lowercase name, so a lookup is a
+// binary search.
+//
+// Layout (little-endian): header, file table, texture table, string pool.
+class TextureIndex {
+public:
+    TextureIndex();
+    ~TextureIndex();
+
+    // Scan `root` for .txd files in parallel (texture headers only) and write
+    // the index to `indexPath`. If that already holds an index of the same
+    // directory, files whose size and modification time are unchanged keep
+    // their entries without being read again.
+    static IndexBuildResult build(const std::string& root, const std::string& indexPath);
+
+    // Map an index file; returns false if it is missing or invalid
+    bool open(const std::string& indexPath);
+    void close();
+    bool isOpen() const { return mapping != nullptr; }
+
+    // All textures with this name (case-insensitive), ordered by file
+    std::vector<IndexedTexture> find(const std::string& name) const;
+
+    const std::string& getRoot() const { return root; }
+    size_t getTextureCount() const;
+    size_t getFileCount() const;
+    IndexedTexture getTexture(size_t index) const;
+    std::string getFile(size_t index) const;
+
+    // On-disk records, defined in txd_index.cpp
+    struct Header;
+    struct FileRecord;
+    struct TextureRecord;
+
+private:
+    const Header* getHeader() const;
+    const FileRecord* getFiles() const;
+    const TextureRecord* getTextures() const;
+    std::string getString(uint32_t offset, uint32_t length) const;
+    int compareName(const TextureRecord& record, const std::string& name) const;
+
+    std::shared_ptr<MappedFile> mapping;
+    std::string root;
+};
+
+} // namespace LibTXD
+
+#endif // TXD_INDEX_H
@@ -0,0 +1,126 @@
+#include "txd_mapped_file.h"
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#include <filesystem>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace LibTXD {
+
+MappedFile::MappedFile()
+    : data(nullptr)
+    , size(0)
+#ifdef _WIN32
+    , fileHandle(INVALID_HANDLE_VALUE)
+    , mappingHandle(nullptr)
+#endif
+{
+}
+
+#ifdef _WIN32
+
+std::shared_ptr<MappedFile> MappedFile::open(const std::string& filepath) {
+    std::shared_ptr<MappedFile> file(new MappedFile());
+    file->path = filepath;
+
+    std::wstring widePath = std::filesystem::u8path(filepath).wstring();
+    // Allow writers, so IMG entries can be rewritten in place while
+    // dictionaries loaded from other entries still view the archive
+    HANDLE handle = CreateFileW(widePath.c_str(), GENERIC_READ,
+                                FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr,
+                                OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (handle == INVALID_HANDLE_VALUE) {
+        return nullptr;
+    }
+    file->fileHandle = handle;
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(handle, &fileSize)) {
+        return nullptr;
+    }
+    file->size = static_cast<size_t>(fileSize.QuadPart);
+
+    // Zero-length files cannot be mapped; an empty mapping is still valid
+    if (file->size == 0) {
+        return file;
+    }
+
+    HANDLE mapping = CreateFileMappingW(handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping) {
+        return nullptr;
+    }
+    file->mappingHandle = mapping;
+
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!view) {
+        return nullptr;
+    }
+    file->data = static_cast<const uint8_t*>(view);
+
+    return file;
+}
+
+MappedFile::~MappedFile() {
+    if (data) {
+        UnmapViewOfFile(data);
+    }
+    if (mappingHandle) {
+        CloseHandle(mappingHandle);
+    }
+    if (fileHandle != INVALID_HANDLE_VALUE) {
+        CloseHandle(fileHandle);
+    }
+}
+
+#else
+
+std::shared_ptr<MappedFile> MappedFile::open(const std::string& filepath) {
+    std::shared_ptr<MappedFile> file(new MappedFile());
+    file->path = filepath;
+
+    int fd = ::open(filepath.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return nullptr;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+        ::close(fd);
+        return nullptr;
+    }
+    file->size = static_cast<size_t>(st.st_size);
+
+    // Zero-length files cannot be mapped; an empty mapping is still valid
+    if (file->size == 0) {
+        ::close(fd);
+        return file;
+    }
+
+    void* view = mmap(nullptr, file->size, PROT_READ, MAP_PRIVATE, fd, 0);
+    // The mapping keeps its own reference to the file
+    ::close(fd);
+    if (view == MAP_FAILED) {
+        return nullptr;
+    }
+    file->data = static_cast<const uint8_t*>(view);
+
+    return file;
+}
+
+MappedFile::~MappedFile() {
+    if (data) {
+        munmap(const_cast<uint8_t*>(data), size);
+    }
+}
+
+#endif
+
+} // namespace LibTXD
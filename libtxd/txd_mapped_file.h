@@ -0,0 +1,44 @@
+#ifndef TXD_MAPPED_FILE_H
+#define TXD_MAPPED_FILE_H
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <memory>
+
+namespace LibTXD {
+
+// Read-only memory mapping of a whole file.
+// Textures loaded in mapped mode keep a shared reference to the mapping,
+// so pixel data stays valid for as long as any of them is alive.
+class MappedFile {
+public:
+    // Map a file into memory, returns nullptr on failure
+    static std::shared_ptr<MappedFile> open(const std::string& filepath);
+
+    ~MappedFile();
+
+    // Non-copyable, non-movable (textures hold pointers into the mapping)
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    const uint8_t* getData() const { return data; }
+    size_t getSize() const { return size; }
+    const std::string& getPath() const { return path; }
+
+private:
+    MappedFile();
+
+    const uint8_t* data;
+    size_t size;
+    std::string path;
+
+#ifdef _WIN32
+    void* fileHandle;
+    void* mappingHandle;
+#endif
+};
+
+} // namespace LibTXD
+
+#endif // TXD_MAPPED_FILE_H
@@ -0,0 +1,241 @@
+#include "txd_mipmap.h"
+#include "txd_parallel.h"
+#include "txd_cpu.h"
+#include <algorithm>
+#include <cmath>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define TXD_MIPMAP_X86
+#include <immintrin.h>
+#endif
+
+#if defined(TXD_MIPMAP_X86) && (defined(__GNUC__) || defined(__clang__))
+#define TXD_TARGET_SSE2 __attribute__((target("sse2")))
+#else
+#define TXD_TARGET_SSE2
+#endif
+
+namespace LibTXD {
+namespace Mipmaps {
+
+namespace {
+
+// Linear values are quantised to this many steps on the way back to sRGB;
+// enough for every 8-bit value to survive a roundtrip unchanged
+const int LINEAR_STEPS = 4096;
+
+struct GammaTables {
+    float toLinear[256];
+    uint8_t toSrgb[LINEAR_STEPS];
+    
+    GammaTables() {
+        for (int i = 0; i < 256; i++) {
+            float c = i / 255.0f;
+            toLinear[i] = c <= 0.04045f ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+        }
+        for (int i = 0; i < LINEAR_STEPS; i++) {
+            float l = static_cast<float>(i) / (LINEAR_STEPS - 1);
+            float c = l <= 0.0031308f ? l * 12.92f : 1.055f * std::pow(l, 1.0f / 2.4f) - 0.055f;
+            toSrgb[i] = static_cast<uint8_t>(std::min(255.0f, std::max(0.0f, c * 255.0f + 0.5f)));
+        }
+    }
+};
+
+const GammaTables& gamma() {
+    static const GammaTables tables;
+    return tables;
+}
+
+inline uint8_t linearToSrgb(const GammaTables& tables, float value) {
+    int index = static_cast<int>(value * (LINEAR_STEPS - 1) + 0.5f);
+    return tables.toSrgb[std::min(LINEAR_STEPS - 1, std::max(0, index))];
+}
+
+// Filter one output row. `row0`/`row1` are the two source rows (the same row
+// when the source is one pixel high), `dx` is 4 when the source is one
+// pixel wide so both taps read the same column.
+void downsampleRow(const uint8_t* row0, const uint8_t* row1, size_t dx, uint32_t outWidth, uint8_t* out) {
+    const GammaTables& tables = gamma();
+    for (uint32_t x = 0; x < outWidth; x++) {
+        const uint8_t* taps[4] = {row0 + x * 8, row0 + x * 8 + dx, row1 + x * 8, row1 + x * 8 + dx};
+        
+        // Alpha-weighted and plain sums of linear colour
+        float weighted[4] = {0, 0, 0, 0};
+        float plain[4] = {0, 0, 0, 0};
+        for (const uint8_t* tap : taps) {
+            float a = tap[3] * (1.0f / 255.0f);
+            float v[4] = {tables.toLinear[tap[0]], tables.toLinear[tap[1]], tables.toLinear[tap[2]], 1.0f};
+            for (int c = 0; c < 4; c++) {
+                weighted[c] += v[c] * a;
+                plain[c] += v[c];
+            }
+        }
+        
+        // Fully transparent footprints fall back to the plain average
+        const float* sum = weighted[3] > 0.0f ? weighted : plain;
+        float scale = 1.0f / sum[3];
+        out[x * 4 + 0] = linearToSrgb(tables, sum[0] * scale);
+        out[x * 4 + 1] = linearToSrgb(tables, sum[1] * scale);
+        out[x * 4 + 2] = linearToSrgb(tables, sum[2] * scale);
+        out[x * 4 + 3] = static_cast<uint8_t>(weighted[3] * 0.25f * 255.0f + 0.5f);
+    }
+}
+
+#ifdef TXD_MIPMAP_X86
+
+// Same arithmetic as downsampleRow for four output pixels at a time, one
+// pixel per lane. SSE2 has no gather, so the gamma table lookups stay
+// scalar; alpha is unpacked and everything after the lookups is vector
+// math. Results match the portable kernel bit for bit.
+TXD_TARGET_SSE2 void downsampleRowSSE2(const uint8_t* row0, const uint8_t* row1, size_t dx, uint32_t outWidth, uint8_t* out) {
+    const GammaTables& tables = gamma();
+    const float* linear = tables.toLinear;
+    const __m128 alphaScale = _mm_set1_ps(1.0f / 255.0f);
+    const __m128 zero = _mm_setzero_ps();
+    const __m128 four = _mm_set1_ps(4.0f);
+    const __m128 steps = _mm_set1_ps(static_cast<float>(LINEAR_STEPS - 1));
+    const __m128 half = _mm_set1_ps(0.5f);
+    const __m128 alphaOut = _mm_set1_ps(0.25f * 255.0f);
+    
+    // One pixel wide sources (dx = 0) have a single output column and take
+    // the portable path
+    uint32_t x = 0;
+    for (; dx == 4 && x + 4 <= outWidth; x += 4) {
+        // Alpha of the 8 source pixels in each row, split into even (left)
+        // and odd (right) taps
+        __m128 alpha[4];
+        const uint8_t* rows[2] = {row0 + x * 8, row1 + x * 8};
+        for (int r = 0; r < 2; r++) {
+            __m128i lo = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rows[r]));
+            __m128i hi = _mm_loadu_si128(reinterpret_cast<const __m128i*>(rows[r] + 16));
+            __m128 alphaLo = _mm_cvtepi32_ps(_mm_srli_epi32(lo, 24));
+            __m128 alphaHi = _mm_cvtepi32_ps(_mm_srli_epi32(hi, 24));
+            alpha[r * 2 + 0] = _mm_shuffle_ps(alphaLo, alphaHi, _MM_SHUFFLE(2, 0, 2, 0));
+            alpha[r * 2 + 1] = _mm_shuffle_ps(alphaLo, alphaHi, _MM_SHUFFLE(3, 1, 3, 1));
+        }
+        
+        // Alpha-weighted and plain sums of linear colour, taps in the same
+        // order as the portable kernel
+        __m128 weighted[4] = {zero, zero, zero, zero};
+        __m128 plain[3] = {zero, zero, zero};
+        for (int t = 0; t < 4; t++) {
+            const uint8_t* tap = rows[t >> 1] + (t & 1) * 4;
+            __m128 a = _mm_mul_ps(alpha[t], alphaScale);
+            for (int c = 0; c < 3; c++) {
+                __m128 v = _mm_setr_ps(linear[tap[c]], linear[tap[8 + c]], linear[tap[16 + c]], linear[tap[24 + c]]);
+                weighted[c] = _mm_add_ps(weighted[c], _mm_mul_ps(v, a));
+                plain[c] = _mm_add_ps(plain[c], v);
+            }
+            weighted[3] = _mm_add_ps(weighted[3], a);
+        }
+        
+        // Fully transparent footprints fall back to the plain average
+        __m128 opaque = _mm_cmpgt_ps(weighted[3], zero);
+        auto select = [opaque](__m128 a, __m128 b) {
+            return _mm_or_ps(_mm_and_ps(opaque, a), _mm_andnot_ps(opaque, b));
+        };
+        __m128 scale = _mm_div_ps(_mm_set1_ps(1.0f), select(weighted[3], four));
+        
+        alignas(16) int32_t index[4][4];
+        for (int c = 0; c < 3; c++) {
+            __m128 value = _mm_mul_ps(select(weighted[c], plain[c]), scale);
+            value = _mm_add_ps(_mm_mul_ps(value, steps), half);
+            value = _mm_min_ps(_mm_max_ps(value, zero), steps);
+            _mm_store_si128(reinterpret_cast<__m128i*>(index[c]), _mm_cvttps_epi32(value));
+        }
+        __m128 outAlpha = _mm_add_ps(_mm_mul_ps(weighted[3], alphaOut), half);
+        _mm_store_si128(reinterpret_cast<__m128i*>(index[3]), _mm_cvttps_epi32(outAlpha));
+        
+        uint8_t* pixel = out + x * 4;
+        for (int i = 0; i < 4; i++) {
+            pixel[i * 4 + 0] = tables.toSrgb[index[0][i]];
+            pixel[i * 4 + 1] = tables.toSrgb[index[1][i]];
+            pixel[i * 4 + 2] = tables.toSrgb[index[2][i]];
+            pixel[i * 4 + 3] = static_cast<uint8_t>(index[3][i]);
+        }
+    }
+    
+    if (x < outWidth) {
+        downsampleRow(row0 + x * 8, row1 + x * 8, dx, outWidth - x, out + x * 4);
+    }
+}
+
+#endif // TXD_MIPMAP_X86
+
+using DownsampleRow = void (*)(const uint8_t*, const uint8_t*, size_t, uint32_t, uint8_t*);
+
+} // namespace
+
+uint32_t getFullChainLength(uint32_t width, uint32_t height) {
+    if (width == 0 || height == 0) {
+        return 0;
+    }
+    uint32_t levels = 1;
+    while (width > 1 || height > 1) {
+        width = nextSize(width);
+        height = nextSize(height);
+        levels++;
+    }
+    return levels;
+}
+
+void downsample(const uint8_t* source, uint32_t width, uint32_t height, uint8_t* destination, bool simd) {
+    if (!source || !destination || width == 0 || height == 0) {
+        return;
+    }
+    
+    DownsampleRow kernel = downsampleRow;
+#ifdef TXD_MIPMAP_X86
+    if (simd && CPU::hasSSE2()) {
+        kernel = downsampleRowSSE2;
+    }
+#else
+    (void)simd;
+#endif
+    
+    const uint32_t outWidth = nextSize(width);
+    const uint32_t outHeight = nextSize(height);
+    const size_t sourceStride = static_cast<size_t>(width) * 4;
+    const size_t dx = width > 1 ? 4 : 0;
+    const size_t dy = height > 1 ? sourceStride : 0;
+    
+    // Make sure the tables are built before the workers race for them
+    gamma();
+    
+    size_t grain = std::max<size_t>(1, outHeight / (Parallel::getThreadCount() * 4));
+    Parallel::parallelFor(outHeight, grain, [&](size_t first, size_t last) {
+        for (size_t y = first; y < last; y++) {
+            const uint8_t* row0 = source + y * 2 * dy;
+            kernel(row0, row0 + dy, dx, outWidth, destination + y * outWidth * 4);
+        }
+    });
+}
+
+std::vector<std::vector<uint8_t>> generateChain(const uint8_t* rgba, uint32_t width, uint32_t height,
+                                                uint32_t levelCount) {
+    std::vector<std::vector<uint8_t>> levels;
+    uint32_t fullLength = getFullChainLength(width, height);
+    if (!rgba || fullLength == 0) {
+        return levels;
+    }
+    if (levelCount == 0 || levelCount > fullLength) {
+        levelCount = fullLength;
+    }
+    
+    // Each level filters the one above it
+    levels.reserve(levelCount - 1);
+    const uint8_t* previous = rgba;
+    for (uint32_t level = 1; level < levelCount; level++) {
+        uint32_t nextWidth = nextSize(width);
+        uint32_t nextHeight = nextSize(height);
+        levels.emplace_back(static_cast<size_t>(nextWidth) * nextHeight * 4);
+        downsample(previous, width, height, levels.back().data());
+        previous = levels.back().data();
+        width = nextWidth;
+        height = nextHeight;
+    }
+    return levels;
+}
+
+} // namespace Mipmaps
+} // namespace LibTXD
@@ -0,0 +1,36 @@
+#ifndef TXD_MIPMAP_H
+#define TXD_MIPMAP_H
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+namespace LibTXD {
+
+// Mipmap chain generation for RGBA8 images.
+// Each level is a 2x2 box filter of the one above it. Colours are averaged in
+// linear light and weighted by alpha, so transparent texels do not bleed
+// their colour into the smaller levels; alpha itself is averaged directly.
+namespace Mipmaps {
+
+// Number of levels in a full chain down to 1x1, level 0 included
+uint32_t getFullChainLength(uint32_t width, uint32_t height);
+
+// Size of the level below a width x height level
+inline uint32_t nextSize(uint32_t size) { return size > 1 ? size / 2 : 1; }
+
+// Halve an RGBA8 image into nextSize(width) x nextSize(height) pixels.
+// Odd trailing rows/columns are dropped. Rows are filtered in parallel.
+// simd = false selects the portable kernel.
+void downsample(const uint8_t* source, uint32_t width, uint32_t height, uint8_t* destination, bool simd = true);
+
+// Levels 1..levelCount-1 below `rgba` (level 0 is not copied);
+// levelCount 0 = full chain. Element i holds level i + 1.
+std::vector<std::vector<uint8_t>> generateChain(const uint8_t* rgba, uint32_t width, uint32_t height,
+                                                uint32_t levelCount = 0);
+
+} // namespace Mipmaps
+
+} // namespace LibTXD
+
+#endif // TXD_MIPMAP_H
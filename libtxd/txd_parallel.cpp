@@ -0,0 +1,199 @@
+#include "txd_parallel.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace LibTXD {
+namespace Parallel {
+
+namespace {
+
+// One parallelFor call; workers and the caller pull chunks from it
+struct Job {
+    const std::function<void(size_t, size_t)>* body;
+    size_t count;
+    size_t grain;
+    size_t chunks;
+    std::atomic<size_t> next{0};
+    std::atomic<size_t> finished{0};
+
+    std::mutex mutex;
+    std::condition_variable done;
+    std::exception_ptr error;
+};
+
+class ThreadPool {
+public:
+    static ThreadPool& instance() {
+        static ThreadPool pool;
+        return pool;
+    }
+
+    ~ThreadPool() {
+        stopWorkers();
+    }
+
+    void setThreadCount(unsigned count) {
+        stopWorkers();
+        std::lock_guard<std::mutex> lock(mutex);
+        requested = count;
+    }
+
+    unsigned getThreadCount() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return resolvedCount();
+    }
+
+    void parallelFor(size_t count, size_t grain, const std::function<void(size_t, size_t)>& body) {
+        if (count == 0) {
+            return;
+        }
+        grain = std::max<size_t>(grain, 1);
+        size_t chunks = (count + grain - 1) / grain;
+
+        if (chunks == 1 || getThreadCount() <= 1) {
+            body(0, count);
+            return;
+        }
+
+        auto job = std::make_shared<Job>();
+        job->body = &body;
+        job->count = count;
+        job->grain = grain;
+        job->chunks = chunks;
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            startWorkers();
+            queue.push_back(job);
+        }
+        wake.notify_all();
+
+        runChunks(*job);
+
+        {
+            std::unique_lock<std::mutex> lock(job->mutex);
+            job->done.wait(lock, [&] { return job->finished.load() == job->chunks; });
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            auto it = std::find(queue.begin(), queue.end(), job);
+            if (it != queue.end()) {
+                queue.erase(it);
+            }
+        }
+
+        if (job->error) {
+            std::rethrow_exception(job->error);
+        }
+    }
+
+private:
+    ThreadPool() : requested(0), stopping(false) {}
+
+    unsigned resolvedCount() const {
+        if (requested > 0) {
+            return requested;
+        }
+        return std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    // Called with `mutex` held
+    void startWorkers() {
+        unsigned wanted = resolvedCount() - 1;
+        while (workers.size() < wanted) {
+            workers.emplace_back([this] { workerLoop(); });
+        }
+    }
+
+    void stopWorkers() {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (auto& worker : workers) {
+            worker.join();
+        }
+        workers.clear();
+
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = false;
+    }
+
+    void workerLoop() {
+        for (;;) {
+            std::shared_ptr<Job> job;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                wake.wait(lock, [&] { return stopping || !queue.empty(); });
+                if (stopping) {
+                    return;
+                }
+                job = queue.front();
+                // Exhausted jobs leave the queue so workers go back to sleep
+                if (job->next.load() >= job->chunks) {
+                    queue.pop_front();
+                    continue;
+                }
+            }
+            runChunks(*job);
+        }
+    }
+
+    static void runChunks(Job& job) {
+        for (;;) {
+            size_t chunk = job.next.fetch_add(1);
+            if (chunk >= job.chunks) {
+                return;
+            }
+
+            size_t begin = chunk * job.grain;
+            size_t end = std::min(begin + job.grain, job.count);
+            try {
+                (*job.body)(begin, end);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(job.mutex);
+                if (!job.error) {
+                    job.error = std::current_exception();
+                }
+            }
+
+            if (job.finished.fetch_add(1) + 1 == job.chunks) {
+                std::lock_guard<std::mutex> lock(job.mutex);
+                job.done.notify_all();
+            }
+        }
+    }
+
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::deque<std::shared_ptr<Job>> queue;
+    std::vector<std::thread> workers;
+    unsigned requested;
+    bool stopping;
+};
+
+} // namespace
+
+void setThreadCount(unsigned count) {
+    ThreadPool::instance().setThreadCount(count);
+}
+
+unsigned getThreadCount() {
+    return ThreadPool::instance().getThreadCount();
+}
+
+void parallelFor(size_t count, size_t grain, const std::function<void(size_t, size_t)>& body) {
+    ThreadPool::instance().parallelFor(count, grain, body);
+}
+
+} // namespace Parallel
+} // namespace LibTXD
@@ -0,0 +1,28 @@
+#ifndef TXD_PARALLEL_H
+#define TXD_PARALLEL_H
+
+#include <cstddef>
+#include <functional>
+
+namespace LibTXD {
+
+// Shared worker pool used by the converter for block-parallel work.
+// The calling thread always takes part in the work, so parallelFor() can be
+// called from inside another parallelFor() body without deadlocking.
+namespace Parallel {
+
+// Total number of threads used, including the caller (0 = hardware concurrency).
+// Must not be called while parallel work is running.
+void setThreadCount(unsigned count);
+unsigned getThreadCount();
+
+// Split [0, count) into ranges of at most `grain` items and run
+// body(begin, end) on each, in parallel. Returns when all ranges are done.
+// The first exception thrown by a body is rethrown in the caller.
+void parallelFor(size_t count, size_t grain, const std::function<void(size_t, size_t)>& body);
+
+} // namespace Parallel
+
+} // namespace LibTXD
+
+#endif // TXD_PARALLEL_H
@@ -0,0 +1,515 @@
+#include "txd_pixels.h"
+#include "txd_cpu.h"
+#include <cstring>
+#include <algorithm>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define TXD_PIXELS_X86
+#include <immintrin.h>
+#endif
+
+#if defined(TXD_PIXELS_X86) && (defined(__GNUC__) || defined(__clang__))
+#define TXD_TARGET_SSE2 __attribute__((target("sse2")))
+#define TXD_TARGET_SSSE3 __attribute__((target("ssse3")))
+#define TXD_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define TXD_TARGET_SSE2
+#define TXD_TARGET_SSSE3
+#define TXD_TARGET_AVX2
+#endif
+
+namespace LibTXD {
+namespace Pixels {
+
+namespace {
+
+// ----------------------------------------------------------------------------
+// Portable kernels
+// ----------------------------------------------------------------------------
+
+// BGRA <-> RGBA is the same swap in both directions
+void swapRedBlue(const uint8_t* source, uint8_t* destination, size_t count) {
+    for (size_t i = 0; i < count; i++, source += 4, destination += 4) {
+        uint8_t r = source[2];
+        uint8_t b = source[0];
+        destination[0] = r;
+        destination[1] = source[1];
+        destination[2] = b;
+        destination[3] = source[3];
+    }
+}
+
+// BGRX -> RGBA and RGBA -> BGRX: swap and force the fourth byte to 255
+void swapRedBlueOpaque(const uint8_t* source, uint8_t* destination, size_t count) {
+    for (size_t i = 0; i < count; i++, source += 4, destination += 4) {
+        uint8_t r = source[2];
+        uint8_t b = source[0];
+        destination[0] = r;
+        destination[1] = source[1];
+        destination[2] = b;
+        destination[3] = 255;
+    }
+}
+
+void unpackBGR(const uint8_t* source, uint8_t* rgba, size_t count) {
+    for (size_t i = 0; i < count; i++, source += 3, rgba += 4) {
+        rgba[0] = source[2];
+        rgba[1] = source[1];
+        rgba[2] = source[0];
+        rgba[3] = 255;
+    }
+}
+
+void packBGR(const uint8_t* rgba, uint8_t* destination, size_t count) {
+    for (size_t i = 0; i < count; i++, rgba += 4, destination += 3) {
+        destination[0] = rgba[2];
+        destination[1] = rgba[1];
+        destination[2] = rgba[0];
+    }
+}
+
+void unpackR5G6B5(const uint8_t* source, uint8_t* rgba, size_t count) {
+    for (size_t i = 0; i < count; i++, source += 2, rgba += 4) {
+        uint16_t pixel = source[0] | (source[1] << 8);
+        rgba[0] = ((pixel >> 11) & 0x1F) << 3;
+        rgba[1] = ((pixel >> 5) & 0x3F) << 2;
+        rgba[2] = (pixel & 0x1F) << 3;
+        rgba[3] = 255;
+    }
+}
+
+void packR5G6B5(const uint8_t* rgba, uint8_t* destination, size_t count) {
+    for (size_t i = 0; i < count; i++, rgba += 4, destination += 2) {
+        uint16_t pixel = ((rgba[0] >> 3) << 11) | ((rgba[1] >> 2) << 5) | (rgba[2] >> 3);
+        destination[0] = static_cast<uint8_t>(pixel);
+        destination[1] = static_cast<uint8_t>(pixel >> 8);
+    }
+}
+
+void unpackA1R5G5B5(const uint8_t* source, uint8_t* rgba, size_t count) {
+    for (size_t i = 0; i < count; i++, source += 2, rgba += 4) {
+        uint16_t pixel = source[0] | (source[1] << 8);
+        rgba[0] = ((pixel >> 10) & 0x1F) << 3;
+        rgba[1] = ((pixel >> 5) & 0x1F) << 3;
+        rgba[2] = (pixel & 0x1F) << 3;
+        rgba[3] = ((pixel >> 15) & 0x1) ? 255 : 0;
+    }
+}
+
+void packA1R5G5B5(const uint8_t* rgba, uint8_t* destination, size_t count) {
+    for (size_t i = 0; i < count; i++, rgba += 4, destination += 2) {
+        uint16_t pixel = (rgba[3] >= 128 ? 0x8000 : 0) | ((rgba[0] >> 3) << 10) | ((rgba[1] >> 3) << 5) | (rgba[2] >> 3);
+        destination[0] = static_cast<uint8_t>(pixel);
+        destination[1] = static_cast<uint8_t>(pixel >> 8);
+    }
+}
+
+void unpackR4G4B4A4(const uint8_t* source, uint8_t* rgba, size_t count) {
+    for (size_t i = 0; i < count; i++, source += 2, rgba += 4) {
+        uint16_t pixel = source[0] | (source[1] << 8);
+        rgba[0] = ((pixel >> 12) & 0xF) << 4;
+        rgba[1] = ((pixel >> 8) & 0xF) << 4;
+        rgba[2] = ((pixel >> 4) & 0xF) << 4;
+        rgba[3] = (pixel & 0xF) << 4;
+    }
+}
+
+void packR4G4B4A4(const uint8_t* rgba, uint8_t* destination, size_t count) {
+    for (size_t i = 0; i < count; i++, rgba += 4, destination += 2) {
+        uint16_t pixel = ((rgba[0] >> 4) << 12) | ((rgba[1] >> 4) << 8) | ((rgba[2] >> 4) << 4) | (rgba[3] >> 4);
+        destination[0] = static_cast<uint8_t>(pixel);
+        destination[1] = static_cast<uint8_t>(pixel >> 8);
+    }
+}
+
+void unpackLUM8(const uint8_t* source, uint8_t* rgba, size_t count) {
+    for (size_t i = 0; i < count; i++, rgba += 4) {
+        rgba[0] = rgba[1] = rgba[2] = source[i];
+        rgba[3] = 255;
+    }
+}
+
+void packLUM8(const uint8_t* rgba, uint8_t* destination, size_t count) {
+    for (size_t i = 0; i < count; i++, rgba += 4) {
+        destination[i] = static_cast<uint8_t>((77 * rgba[0] + 150 * rgba[1] + 29 * rgba[2] + 128) >> 8);
+    }
+}
+
+void expandPalette8(const uint8_t* indices, const uint32_t* table, uint8_t* rgba, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        std::memcpy(rgba + i * 4, &table[indices[i]], 4);
+    }
+}
+
+void expandPalette4(const uint8_t* indices, const uint32_t* table, uint8_t* rgba, size_t count) {
+    size_t i = 0;
+    for (; i + 2 <= count; i += 2) {
+        uint8_t packed = indices[i / 2];
+        std::memcpy(rgba + i * 4, &table[packed & 0x0F], 4);
+        std::memcpy(rgba + i * 4 + 4, &table[packed >> 4], 4);
+    }
+    if (i < count) {
+        std::memcpy(rgba + i * 4, &table[indices[i / 2] & 0x0F], 4);
+    }
+}
+
+void extractAlpha(const uint8_t* rgba, uint8_t* channel, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        channel[i] = rgba[i * 4 + 3];
+    }
+}
+
+#ifdef TXD_PIXELS_X86
+
+// ----------------------------------------------------------------------------
+// SSE2: 16-bit and luminance expansion
+// ----------------------------------------------------------------------------
+
+// Interleave four 16-bit lanes of channel bytes into RGBA8 and store 8 pixels
+TXD_TARGET_SSE2 inline void storeChannels(__m128i r, __m128i g, __m128i b, __m128i a, uint8_t* rgba) {
+    __m128i rg = _mm_or_si128(r, _mm_slli_epi16(g, 8));
+    __m128i ba = _mm_or_si128(b, _mm_slli_epi16(a, 8));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(rgba), _mm_unpacklo_epi16(rg, ba));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(rgba + 16), _mm_unpackhi_epi16(rg, ba));
+}
+
+TXD_TARGET_SSE2 void unpackR5G6B5SSE2(const uint8_t* source, uint8_t* rgba, size_t count) {
+    const __m128i mask5 = _mm_set1_epi16(0xF8);
+    const __m128i mask6 = _mm_set1_epi16(0xFC);
+    const __m128i opaque = _mm_set1_epi16(0xFF);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m128i p = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i * 2));
+        __m128i r = _mm_and_si128(_mm_srli_epi16(p, 8), mask5);
+        __m128i g = _mm_and_si128(_mm_srli_epi16(p, 3), mask6);
+        __m128i b = _mm_and_si128(_mm_slli_epi16(p, 3), mask5);
+        storeChannels(r, g, b, opaque, rgba + i * 4);
+    }
+    unpackR5G6B5(source + i * 2, rgba + i * 4, count - i);
+}
+
+TXD_TARGET_SSE2 void unpackA1R5G5B5SSE2(const uint8_t* source, uint8_t* rgba, size_t count) {
+    const __m128i mask5 = _mm_set1_epi16(0xF8);
+    const __m128i byteMask = _mm_set1_epi16(0xFF);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m128i p = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i * 2));
+        __m128i r = _mm_and_si128(_mm_srli_epi16(p, 7), mask5);
+        __m128i g = _mm_and_si128(_mm_srli_epi16(p, 2), mask5);
+        __m128i b = _mm_and_si128(_mm_slli_epi16(p, 3), mask5);
+        __m128i a = _mm_and_si128(_mm_srai_epi16(p, 15), byteMask);
+        storeChannels(r, g, b, a, rgba + i * 4);
+    }
+    unpackA1R5G5B5(source + i * 2, rgba + i * 4, count - i);
+}
+
+TXD_TARGET_SSE2 void unpackR4G4B4A4SSE2(const uint8_t* source, uint8_t* rgba, size_t count) {
+    const __m128i mask4 = _mm_set1_epi16(0xF0);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m128i p = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i * 2));
+        __m128i r = _mm_and_si128(_mm_srli_epi16(p, 8), mask4);
+        __m128i g = _mm_and_si128(_mm_srli_epi16(p, 4), mask4);
+        __m128i b = _mm_and_si128(p, mask4);
+        __m128i a = _mm_and_si128(_mm_slli_epi16(p, 4), mask4);
+        storeChannels(r, g, b, a, rgba + i * 4);
+    }
+    unpackR4G4B4A4(source + i * 2, rgba + i * 4, count - i);
+}
+
+TXD_TARGET_SSE2 void unpackLUM8SSE2(const uint8_t* source, uint8_t* rgba, size_t count) {
+    const __m128i opaque = _mm_set1_epi8(static_cast<char>(0xFF));
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m128i l = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i));
+        __m128i llLow = _mm_unpacklo_epi8(l, l);
+        __m128i laLow = _mm_unpacklo_epi8(l, opaque);
+        __m128i llHigh = _mm_unpackhi_epi8(l, l);
+        __m128i laHigh = _mm_unpackhi_epi8(l, opaque);
+        __m128i* out = reinterpret_cast<__m128i*>(rgba + i * 4);
+        _mm_storeu_si128(out + 0, _mm_unpacklo_epi16(llLow, laLow));
+        _mm_storeu_si128(out + 1, _mm_unpackhi_epi16(llLow, laLow));
+        _mm_storeu_si128(out + 2, _mm_unpacklo_epi16(llHigh, laHigh));
+        _mm_storeu_si128(out + 3, _mm_unpackhi_epi16(llHigh, laHigh));
+    }
+    unpackLUM8(source + i, rgba + i * 4, count - i);
+}
+
+// Shift alpha down in each pixel and narrow 16 pixels to 16 bytes
+TXD_TARGET_SSE2 void extractAlphaSSE2(const uint8_t* rgba, uint8_t* channel, size_t count) {
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        const __m128i* in = reinterpret_cast<const __m128i*>(rgba + i * 4);
+        __m128i a0 = _mm_srli_epi32(_mm_loadu_si128(in + 0), 24);
+        __m128i a1 = _mm_srli_epi32(_mm_loadu_si128(in + 1), 24);
+        __m128i a2 = _mm_srli_epi32(_mm_loadu_si128(in + 2), 24);
+        __m128i a3 = _mm_srli_epi32(_mm_loadu_si128(in + 3), 24);
+        __m128i low = _mm_packs_epi32(a0, a1);
+        __m128i high = _mm_packs_epi32(a2, a3);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(channel + i), _mm_packus_epi16(low, high));
+    }
+    extractAlpha(rgba + i * 4, channel + i, count - i);
+}
+
+// ----------------------------------------------------------------------------
+// SSSE3: byte shuffles for the 24/32-bit formats
+// ----------------------------------------------------------------------------
+
+TXD_TARGET_SSSE3 void swapRedBlueSSSE3(const uint8_t* source, uint8_t* destination, size_t count) {
+    const __m128i shuffle = _mm_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128i p = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i * 4));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i * 4), _mm_shuffle_epi8(p, shuffle));
+    }
+    swapRedBlue(source + i * 4, destination + i * 4, count - i);
+}
+
+TXD_TARGET_SSSE3 void swapRedBlueOpaqueSSSE3(const uint8_t* source, uint8_t* destination, size_t count) {
+    const __m128i shuffle = _mm_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    const __m128i opaque = _mm_set1_epi32(static_cast<int>(0xFF000000));
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128i p = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i * 4));
+        p = _mm_or_si128(_mm_shuffle_epi8(p, shuffle), opaque);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + i * 4), p);
+    }
+    swapRedBlueOpaque(source + i * 4, destination + i * 4, count - i);
+}
+
+TXD_TARGET_SSSE3 void unpackBGRSSSE3(const uint8_t* source, uint8_t* rgba, size_t count) {
+    const __m128i shuffle = _mm_setr_epi8(2, 1, 0, -1, 5, 4, 3, -1, 8, 7, 6, -1, 11, 10, 9, -1);
+    const __m128i opaque = _mm_set1_epi32(static_cast<int>(0xFF000000));
+    size_t i = 0;
+    // Each load reads 16 bytes but uses 12, so stop while 16 are still in range
+    for (; i + 6 <= count; i += 4) {
+        __m128i p = _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i * 3));
+        p = _mm_or_si128(_mm_shuffle_epi8(p, shuffle), opaque);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(rgba + i * 4), p);
+    }
+    unpackBGR(source + i * 3, rgba + i * 4, count - i);
+}
+
+TXD_TARGET_SSSE3 void packBGRSSSE3(const uint8_t* rgba, uint8_t* destination, size_t count) {
+    const __m128i shuffle = _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128i p = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(rgba + i * 4)), shuffle);
+        // Store exactly 12 bytes
+        uint8_t* out = destination + i * 3;
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(out), p);
+        uint32_t tail = static_cast<uint32_t>(_mm_cvtsi128_si32(_mm_srli_si128(p, 8)));
+        std::memcpy(out + 8, &tail, 4);
+    }
+    packBGR(rgba + i * 4, destination + i * 3, count - i);
+}
+
+// ----------------------------------------------------------------------------
+// AVX2: 32-bit swizzles, eight pixels at a time
+// ----------------------------------------------------------------------------
+
+TXD_TARGET_AVX2 void swapRedBlueAVX2(const uint8_t* source, uint8_t* destination, size_t count) {
+    const __m256i shuffle = _mm256_setr_epi8(
+        2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15,
+        2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256i p = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + i * 4));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + i * 4), _mm256_shuffle_epi8(p, shuffle));
+    }
+    swapRedBlue(source + i * 4, destination + i * 4, count - i);
+}
+
+TXD_TARGET_AVX2 void swapRedBlueOpaqueAVX2(const uint8_t* source, uint8_t* destination, size_t count) {
+    const __m256i shuffle = _mm256_setr_epi8(
+        2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15,
+        2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+    const __m256i opaque = _mm256_set1_epi32(static_cast<int>(0xFF000000));
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256i p = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + i * 4));
+        p = _mm256_or_si256(_mm256_shuffle_epi8(p, shuffle), opaque);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + i * 4), p);
+    }
+    swapRedBlueOpaque(source + i * 4, destination + i * 4, count - i);
+}
+
+// ----------------------------------------------------------------------------
+// Palette expansion
+// ----------------------------------------------------------------------------
+
+// PAL4: split nibbles with SSE2 into a run of byte indices, then look up
+template <ExpandRow Expand8>
+TXD_TARGET_SSE2 void expandPalette4Unpacked(const uint8_t* indices, const uint32_t* table, uint8_t* rgba, size_t count) {
+    const __m128i nibbleMask = _mm_set1_epi8(0x0F);
+    alignas(16) uint8_t unpacked[256];
+    
+    size_t i = 0;
+    while (count - i >= 32) {
+        size_t chunk = std::min<size_t>(count - i, sizeof(unpacked)) & ~static_cast<size_t>(31);
+        for (size_t j = 0; j < chunk; j += 32) {
+            __m128i packed = _mm_loadu_si128(reinterpret_cast<const __m128i*>(indices + (i + j) / 2));
+            __m128i lo = _mm_and_si128(packed, nibbleMask);
+            __m128i hi = _mm_and_si128(_mm_srli_epi16(packed, 4), nibbleMask);
+            _mm_store_si128(reinterpret_cast<__m128i*>(unpacked + j), _mm_unpacklo_epi8(lo, hi));
+            _mm_store_si128(reinterpret_cast<__m128i*>(unpacked + j + 16), _mm_unpackhi_epi8(lo, hi));
+        }
+        Expand8(unpacked, table, rgba + i * 4, chunk);
+        i += chunk;
+    }
+    expandPalette4(indices + i / 2, table, rgba + i * 4, count - i);
+}
+
+// PAL8 with AVX2 gathers, eight pixels per instruction
+TXD_TARGET_AVX2 void expandPalette8AVX2(const uint8_t* indices, const uint32_t* table, uint8_t* rgba, size_t count) {
+    const int* base = reinterpret_cast<const int*>(table);
+    size_t i = 0;
+    for (; i + 16 <= count; i += 16) {
+        __m128i bytes = _mm_loadu_si128(reinterpret_cast<const __m128i*>(indices + i));
+        __m256i first = _mm256_i32gather_epi32(base, _mm256_cvtepu8_epi32(bytes), 4);
+        __m256i second = _mm256_i32gather_epi32(base, _mm256_cvtepu8_epi32(_mm_srli_si128(bytes, 8)), 4);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(rgba + i * 4), first);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(rgba + i * 4 + 32), second);
+    }
+    expandPalette8(indices + i, table, rgba + i * 4, count - i);
+}
+
+// PAL8 without gathers: four scalar table loads per iteration, stored as
+// one 16-byte write
+TXD_TARGET_SSE2 void expandPalette8SSE2(const uint8_t* indices, const uint32_t* table, uint8_t* rgba, size_t count) {
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128i pixels = _mm_setr_epi32(
+            static_cast<int>(table[indices[i]]), static_cast<int>(table[indices[i + 1]]),
+            static_cast<int>(table[indices[i + 2]]), static_cast<int>(table[indices[i + 3]]));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(rgba + i * 4), pixels);
+    }
+    expandPalette8(indices + i, table, rgba + i * 4, count - i);
+}
+
+#endif // TXD_PIXELS_X86
+
+struct KernelSet {
+    UnpackRow unpack;
+    PackRow pack;
+};
+
+KernelSet selectKernels(uint32_t baseFormat, uint32_t bytesPerPixel, bool simd) {
+#ifdef TXD_PIXELS_X86
+    const bool sse2 = simd && CPU::hasSSE2();
+    const bool ssse3 = simd && CPU::hasSSSE3();
+    const bool avx2 = simd && CPU::hasAVX2();
+#else
+    (void)simd;
+#endif
+
+    switch (baseFormat) {
+        case 0x0500: // B8G8R8A8
+            if (bytesPerPixel != 4) break;
+#ifdef TXD_PIXELS_X86
+            if (avx2) return {swapRedBlueAVX2, swapRedBlueAVX2};
+            if (ssse3) return {swapRedBlueSSSE3, swapRedBlueSSSE3};
+#endif
+            return {swapRedBlue, swapRedBlue};
+
+        case 0x0600: // B8G8R8, stored as 24-bit or padded to 32-bit
+            if (bytesPerPixel == 4) {
+#ifdef TXD_PIXELS_X86
+                if (avx2) return {swapRedBlueOpaqueAVX2, swapRedBlueOpaqueAVX2};
+                if (ssse3) return {swapRedBlueOpaqueSSSE3, swapRedBlueOpaqueSSSE3};
+#endif
+                return {swapRedBlueOpaque, swapRedBlueOpaque};
+            }
+            if (bytesPerPixel != 3) break;
+#ifdef TXD_PIXELS_X86
+            if (ssse3) return {unpackBGRSSSE3, packBGRSSSE3};
+#endif
+            return {unpackBGR, packBGR};
+
+        case 0x0200: // R5G6B5
+            if (bytesPerPixel != 2) break;
+#ifdef TXD_PIXELS_X86
+            if (sse2) return {unpackR5G6B5SSE2, packR5G6B5};
+#endif
+            return {unpackR5G6B5, packR5G6B5};
+
+        case 0x0100: // A1R5G5B5
+            if (bytesPerPixel != 2) break;
+#ifdef TXD_PIXELS_X86
+            if (sse2) return {unpackA1R5G5B5SSE2, packA1R5G5B5};
+#endif
+            return {unpackA1R5G5B5, packA1R5G5B5};
+
+        case 0x0300: // R4G4B4A4
+            if (bytesPerPixel != 2) break;
+#ifdef TXD_PIXELS_X86
+            if (sse2) return {unpackR4G4B4A4SSE2, packR4G4B4A4};
+#endif
+            return {unpackR4G4B4A4, packR4G4B4A4};
+
+        case 0x0400: // LUM8
+            if (bytesPerPixel != 1) break;
+#ifdef TXD_PIXELS_X86
+            if (sse2) return {unpackLUM8SSE2, packLUM8};
+#endif
+            return {unpackLUM8, packLUM8};
+
+        default:
+            break;
+    }
+    return {nullptr, nullptr};
+}
+
+} // namespace
+
+void buildPaletteTable(const uint8_t* rgbaPalette, uint32_t paletteSize, uint32_t table[256]) {
+    paletteSize = std::min<uint32_t>(paletteSize, 256);
+    if (!rgbaPalette || paletteSize == 0) {
+        std::fill(table, table + 256, 0u);
+        return;
+    }
+    std::memcpy(table, rgbaPalette, paletteSize * 4);
+    std::fill(table + paletteSize, table + 256, table[0]);
+}
+
+ExpandRow getPalette8Expander(bool simd) {
+#ifdef TXD_PIXELS_X86
+    if (simd && CPU::hasAVX2()) return expandPalette8AVX2;
+    if (simd && CPU::hasSSE2()) return expandPalette8SSE2;
+#else
+    (void)simd;
+#endif
+    return expandPalette8;
+}
+
+ExpandRow getPalette4Expander(bool simd) {
+#ifdef TXD_PIXELS_X86
+    if (simd && CPU::hasAVX2()) return expandPalette4Unpacked<expandPalette8AVX2>;
+    if (simd && CPU::hasSSE2()) return expandPalette4Unpacked<expandPalette8SSE2>;
+#else
+    (void)simd;
+#endif
+    return expandPalette4;
+}
+
+ExtractRow getAlphaExtractor(bool simd) {
+#ifdef TXD_PIXELS_X86
+    if (simd && CPU::hasSSE2()) return extractAlphaSSE2;
+#else
+    (void)simd;
+#endif
+    return extractAlpha;
+}
+
+UnpackRow getUnpacker(RasterFormat format, uint32_t bytesPerPixel, bool simd) {
+    uint32_t baseFormat = static_cast<uint32_t>(format) & static_cast<uint32_t>(RasterFormat::MASK);
+    return selectKernels(baseFormat, bytesPerPixel, simd).unpack;
+}
+
+PackRow getPacker(RasterFormat format, uint32_t bytesPerPixel, bool simd) {
+    uint32_t baseFormat = static_cast<uint32_t>(format) & static_cast<uint32_t>(RasterFormat::MASK);
+    return selectKernels(baseFormat, bytesPerPixel, simd).pack;
+}
+
+} // namespace Pixels
+} // namespace LibTXD
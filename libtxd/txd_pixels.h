@@ -0,0 +1,52 @@
+#ifndef TXD_PIXELS_H
+#define TXD_PIXELS_H
+
+#include "txd_types.h"
+#include <cstdint>
+#include <cstddef>
+
+namespace LibTXD {
+
+// Row kernels converting between uncompressed native raster formats and RGBA8.
+// Pick a kernel once per image, then call it for every row.
+namespace Pixels {
+
+// Convert `count` native pixels to RGBA8
+using UnpackRow = void (*)(const uint8_t* source, uint8_t* rgba, size_t count);
+// Convert `count` RGBA8 pixels to the native format
+using PackRow = void (*)(const uint8_t* rgba, uint8_t* destination, size_t count);
+
+// Kernels for a base raster format (flag bits are ignored) stored with
+// `bytesPerPixel` bytes per pixel. B8G8R8 may be stored as 3 or 4 bytes;
+// the other formats only in their natural size. Returns nullptr for
+// unsupported combinations. simd = false selects the portable kernels.
+//
+// 16-bit formats expand by shifting (5 bits << 3, 4 bits << 4), A1R5G5B5
+// alpha is 0 or 255, and LUM8 packs as rounded Rec.601 luma.
+UnpackRow getUnpacker(RasterFormat format, uint32_t bytesPerPixel, bool simd = true);
+PackRow getPacker(RasterFormat format, uint32_t bytesPerPixel, bool simd = true);
+
+// Palette lookup table: 256 RGBA8 entries, one 32-bit word each (bytes in
+// memory order). Entries at or past `paletteSize` repeat entry 0, so the
+// expanders never need to range-check an index.
+void buildPaletteTable(const uint8_t* rgbaPalette, uint32_t paletteSize, uint32_t table[256]);
+
+// Expand `count` palette indices of a row to RGBA8 through a table from
+// buildPaletteTable()
+using ExpandRow = void (*)(const uint8_t* indices, const uint32_t* table, uint8_t* rgba, size_t count);
+
+// One index per byte (PAL8, and PAL4 stored unpacked)
+ExpandRow getPalette8Expander(bool simd = true);
+// Two indices per byte, low nibble first (packed PAL4)
+ExpandRow getPalette4Expander(bool simd = true);
+
+// Copy one channel (0 = R .. 3 = A) of `count` RGBA8 pixels to a byte per
+// pixel, e.g. to show the alpha channel as a greyscale image
+using ExtractRow = void (*)(const uint8_t* rgba, uint8_t* channel, size_t count);
+ExtractRow getAlphaExtractor(bool simd = true);
+
+} // namespace Pixels
+
+} // namespace LibTXD
+
+#endif // TXD_PIXELS_H
@@ -0,0 +1,148 @@
+#ifndef TXD_READER_H
+#define TXD_READER_H
+
+#include "txd_types.h"
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <string>
+
+namespace LibTXD {
+
+// Bounds-checked cursor over a contiguous RenderWare buffer.
+// Every read either succeeds completely or fails without moving the cursor,
+// so parsers can check once per field group instead of once per byte.
+class ChunkReader {
+public:
+    ChunkReader() : begin(nullptr), cursor(nullptr), end(nullptr) {}
+    ChunkReader(const uint8_t* data, size_t size)
+        : begin(data), cursor(data), end(data ? data + size : data) {}
+
+    const uint8_t* data() const { return begin; }
+    const uint8_t* current() const { return cursor; }
+    size_t size() const { return static_cast<size_t>(end - begin); }
+    size_t tell() const { return static_cast<size_t>(cursor - begin); }
+    size_t remaining() const { return static_cast<size_t>(end - cursor); }
+    bool has(size_t count) const { return remaining() >= count; }
+
+    bool seek(size_t offset) {
+        if (offset > size()) {
+            return false;
+        }
+        cursor = begin + offset;
+        return true;
+    }
+
+    bool skip(size_t count) {
+        if (!has(count)) {
+            return false;
+        }
+        cursor += count;
+        return true;
+    }
+
+    bool readU8(uint8_t& value) {
+        if (!has(1)) {
+            return false;
+        }
+        value = *cursor++;
+        return true;
+    }
+
+    bool readU16(uint16_t& value) {
+        if (!has(2)) {
+            return false;
+        }
+        value = load16(cursor);
+        cursor += 2;
+        return true;
+    }
+
+    bool readU32(uint32_t& value) {
+        if (!has(4)) {
+            return false;
+        }
+        value = load32(cursor);
+        cursor += 4;
+        return true;
+    }
+
+    // Borrow `count` bytes without copying
+    bool readView(size_t count, const uint8_t*& out) {
+        if (!has(count)) {
+            return false;
+        }
+        out = cursor;
+        cursor += count;
+        return true;
+    }
+
+    bool readBytes(void* out, size_t count) {
+        if (!has(count)) {
+            return false;
+        }
+        std::memcpy(out, cursor, count);
+        cursor += count;
+        return true;
+    }
+
+    // Fixed-width, NUL-padded string field
+    bool readString(size_t width, std::string& out) {
+        if (!has(width)) {
+            return false;
+        }
+        const char* text = reinterpret_cast<const char*>(cursor);
+        size_t length = 0;
+        while (length < width && text[length] != '\0') {
+            length++;
+        }
+        out.assign(text, length);
+        cursor += width;
+        return true;
+    }
+
+    // Chunk header: type, length and version in one 12-byte load
+    bool readHeader(ChunkHeader& header) {
+        if (!has(12)) {
+            return false;
+        }
+        header.type = static_cast<ChunkType>(load32(cursor));
+        header.length = load32(cursor + 4);
+        header.version = load32(cursor + 8);
+        cursor += 12;
+        return true;
+    }
+
+    // Reader over the next `count` bytes (clamped to what is left); the
+    // parent skips past them
+    ChunkReader child(size_t count) {
+        if (count > remaining()) {
+            count = remaining();
+        }
+        ChunkReader sub(cursor, count);
+        cursor += count;
+        return sub;
+    }
+
+    // Unchecked little-endian loads for callers that already checked has()
+    static uint16_t load16(const uint8_t* p) {
+        uint16_t value;
+        std::memcpy(&value, p, 2);
+        return fromLittleEndian16(value);
+    }
+
+    static uint32_t load32(const uint8_t* p) {
+        uint32_t value;
+        std::memcpy(&value, p, 4);
+        return fromLittleEndian32(value);
+    }
+
+private:
+    const uint8_t* begin;
+    const uint8_t* cursor;
+    const uint8_t* end;
+};
+
+} // namespace LibTXD
+
+#endif // TXD_READER_H
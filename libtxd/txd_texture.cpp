@@ -1,5 +1,7 @@
 #include "txd_texture.h"
 #include "txd_types.h"
+#include "txd_reader.h"
+#include "txd_writer.h"
 #include <istream>
 #include <ostream>
 #include <cstring>
@@ -15,12 +17,25 @@ Texture::Texture()
     , depth(32)
     , hasAlphaChannel(false)
     , compression(Compression::NONE)
+    , mappedPalette(nullptr)
     , paletteSize(0)
+    , headerWidth(0)
+    , headerHeight(0)
+    , headerMipmapCount(0)
+    , pendingData(nullptr)
+    , pendingSize(0)
 {
 }
 
 Texture::~Texture() = default;
 
+void MipmapLevel::detach() {
+    if (isMapped()) {
+        data.assign(mappedData, mappedData + dataSize);
+    }
+    mappedData = nullptr;
+}
+
 Texture::Texture(Texture&& other) noexcept
     : platform(other.platform)
     , name(std::move(other.name))
@@ -32,10 +47,20 @@ Texture::Texture(Texture&& other) noexcept
     , compression(other.compression)
     , mipmaps(std::move(other.mipmaps))
     , palette(std::move(other.palette))
+    , mappedPalette(other.mappedPalette)
     , paletteSize(other.paletteSize)
+    , backing(std::move(other.backing))
+    , headerWidth(other.headerWidth)
+    , headerHeight(other.headerHeight)
+    , headerMipmapCount(other.headerMipmapCount)
+    , pendingData(other.pendingData)
+    , pendingSize(other.pendingSize)
     , swizzleWidth(std::move(other.swizzleWidth))
     , swizzleHeight(std::move(other.swizzleHeight))
 {
+    other.mappedPalette = nullptr;
+    other.pendingData = nullptr;
+    other.pendingSize = 0;
 }
 
 Texture& Texture::operator=(Texture&& other) noexcept {
@@ -50,14 +75,44 @@ Texture& Texture::operator=(Texture&& other) noexcept {
         compression = other.compression;
         mipmaps = std::move(other.mipmaps);
         palette = std::move(other.palette);
+        mappedPalette = other.mappedPalette;
+        other.mappedPalette = nullptr;
         paletteSize = other.paletteSize;
+        backing = std::move(other.backing);
+        headerWidth = other.headerWidth;
+        headerHeight = other.headerHeight;
+        headerMipmapCount = other.headerMipmapCount;
+        pendingData = other.pendingData;
+        pendingSize = other.pendingSize;
+        other.pendingData = nullptr;
+        other.pendingSize = 0;
         swizzleWidth = std::move(other.swizzleWidth);
         swizzleHeight = std::move(other.swizzleHeight);
     }
     return *this;
 }
 
+uint32_t Texture::getWidth() const {
+    return mipmaps.empty() ? headerWidth : mipmaps[0].width;
+}
+
+uint32_t Texture::getHeight() const {
+    return mipmaps.empty() ? headerHeight : mipmaps[0].height;
+}
+
+uint32_t Texture::getMipmapCount() const {
+    if (pendingData) {
+        return headerMipmapCount;
+    }
+    return static_cast<uint32_t>(mipmaps.size());
+}
+
+bool Texture::isLoaded() const {
+    return pendingData == nullptr;
+}
+
 const MipmapLevel& Texture::getMipmap(size_t index) const {
+    ensureLoaded();
     if (index >= mipmaps.size()) {
         throw std::out_of_range("Mipmap index out of range");
     }
@@ -65,129 +120,244 @@ const MipmapLevel& Texture::getMipmap(size_t index) const {
 }
 
 MipmapLevel& Texture::getMipmap(size_t index) {
+    ensureLoaded();
     if (index >= mipmaps.size()) {
         throw std::out_of_range("Mipmap index out of range");
     }
+    // Mutable access means the caller may edit the pixels, so stop borrowing
+    mipmaps[index].detach();
     return mipmaps[index];
 }
 
+ByteSpan Texture::getPalette() const {
+    ensureLoaded();
+    if (palette.empty() && mappedPalette) {
+        return ByteSpan(mappedPalette, paletteSize * 4);
+    }
+    return ByteSpan(palette);
+}
+
 void Texture::addMipmap(MipmapLevel mipmap) {
+    ensureLoaded();
     mipmaps.push_back(std::move(mipmap));
 }
 
+void Texture::clearMipmaps() {
+    ensureLoaded();
+    mipmaps.clear();
+}
+
 void Texture::setPalette(const std::vector<uint8_t>& pal, uint32_t size) {
+    ensureLoaded();
     palette = pal;
+    mappedPalette = nullptr;
     paletteSize = size;
 }
 
 void Texture::clear() {
     mipmaps.clear();
     palette.clear();
+    mappedPalette = nullptr;
     paletteSize = 0;
+    backing.reset();
+    headerWidth = 0;
+    headerHeight = 0;
+    headerMipmapCount = 0;
+    pendingData = nullptr;
+    pendingSize = 0;
     swizzleWidth.clear();
     swizzleHeight.clear();
 }
 
+bool Texture::isMapped() const {
+    if (pendingData) {
+        return true;
+    }
+    if (palette.empty() && mappedPalette) {
+        return true;
+    }
+    for (const auto& mipmap : mipmaps) {
+        if (mipmap.isMapped()) {
+            return true;
+        }
+    }
+    return false;
+}
+
+Texture Texture::clone() const {
+    Texture copy;
+    copy.platform = platform;
+    copy.name = name;
+    copy.maskName = maskName;
+    copy.filterFlags = filterFlags;
+    copy.rasterFormat = rasterFormat;
+    copy.depth = depth;
+    copy.hasAlphaChannel = hasAlphaChannel;
+    copy.compression = compression;
+    copy.mipmaps = mipmaps;
+    copy.palette = palette;
+    copy.mappedPalette = mappedPalette;
+    copy.paletteSize = paletteSize;
+    copy.backing = backing;
+    copy.headerWidth = headerWidth;
+    copy.headerHeight = headerHeight;
+    copy.headerMipmapCount = headerMipmapCount;
+    copy.pendingData = pendingData;
+    copy.pendingSize = pendingSize;
+    copy.swizzleWidth = swizzleWidth;
+    copy.swizzleHeight = swizzleHeight;
+    return copy;
+}
+
+void Texture::detach() {
+    ensureLoaded();
+    for (auto& mipmap : mipmaps) {
+        mipmap.detach();
+    }
+    if (palette.empty() && mappedPalette) {
+        palette.assign(mappedPalette, mappedPalette + paletteSize * 4);
+    }
+    mappedPalette = nullptr;
+    backing.reset();
+}
+
 bool Texture::readD3D(std::istream& stream) {
-    ChunkHeader header;
-    if (!header.read(stream)) {
+    // Pull the whole section into memory and parse it from there
+    uint8_t headerBytes[12];
+    stream.read(reinterpret_cast<char*>(headerBytes), 12);
+    if (stream.gcount() != 12) {
         return false;
     }
     
+    ChunkHeader header;
+    ChunkReader(headerBytes, 12).readHeader(header);
     if (header.type != ChunkType::TEXTURENATIVE) {
         return false;
     }
     
-    size_t sectionStart = stream.tellg();
-    size_t sectionEnd = sectionStart + header.length;
-    
-    // Read struct section
-    if (!readD3DStruct(stream, header)) {
-        return false;
+    // The length comes from the file, so never allocate more than the
+    // stream holds; unseekable streams are read in bounded steps
+    size_t length = header.length;
+    std::streampos start = stream.tellg();
+    stream.seekg(0, std::ios::end);
+    std::streampos end = stream.tellg();
+    if (start != std::streampos(-1) && end != std::streampos(-1) && end >= start) {
+        length = std::min(length, static_cast<size_t>(end - start));
+        stream.seekg(start, std::ios::beg);
+    } else {
+        stream.clear(stream.rdstate() & ~std::ios::failbit);
     }
     
-    // Skip to end of section (there might be an extension section)
-    stream.seekg(sectionEnd, std::ios::beg);
+    auto buffer = std::make_shared<std::vector<uint8_t>>(headerBytes, headerBytes + 12);
+    const size_t step = 1 << 20;
+    size_t received = 0;
+    while (received < length && stream) {
+        size_t count = std::min(step, length - received);
+        buffer->resize(12 + received + count);
+        stream.read(reinterpret_cast<char*>(buffer->data() + 12 + received), static_cast<std::streamsize>(count));
+        received += static_cast<size_t>(stream.gcount());
+    }
+    buffer->resize(12 + received);
+    if (received != header.length) {
+        // A short section may still hold a complete struct
+        stream.clear(stream.rdstate() & ~(std::ios::failbit | std::ios::eofbit));
+    }
     
-    return true;
+    return readD3D(buffer->data(), buffer->size(), buffer);
 }
 
-bool Texture::readD3DStruct(std::istream& stream, ChunkHeader& parentHeader) {
+bool Texture::readD3D(const uint8_t* data, size_t size, std::shared_ptr<const void> source) {
+    if (!readD3DHeader(data, size, std::move(source))) {
+        return false;
+    }
+    return ensureLoaded();
+}
+
+bool Texture::readD3DHeader(const uint8_t* data, size_t size, std::shared_ptr<const void> source) {
+    ChunkReader reader(data, size);
+    
+    ChunkHeader header;
+    if (!reader.readHeader(header)) {
+        return false;
+    }
+    
+    if (header.type != ChunkType::TEXTURENATIVE) {
+        return false;
+    }
+    
+    // Struct section (anything after it, like the extension, is ignored)
+    ChunkReader section = reader.child(header.length);
     ChunkHeader structHeader;
-    if (!structHeader.read(stream)) {
+    if (!section.readHeader(structHeader) || structHeader.type != ChunkType::STRUCT) {
+        return false;
+    }
+    
+    ChunkReader body = section.child(structHeader.length);
+    if (!readD3DStruct(body)) {
         return false;
     }
     
-    if (structHeader.type != ChunkType::STRUCT) {
+    // Check the palette and mip sizes against the section now, so lazy
+    // loading rejects the same textures a full parse does and the deferred
+    // parse can't fail later
+    ChunkReader levels = body;
+    if (paletteSize > 0 && !levels.skip(paletteSize * 4)) {
         return false;
     }
+    for (uint32_t i = 0; i < headerMipmapCount; i++) {
+        uint32_t mipSize;
+        if (!levels.readU32(mipSize) || !levels.skip(mipSize)) {
+            return false;
+        }
+    }
     
-    size_t structStart = stream.tellg();
-    size_t structEnd = structStart + structHeader.length;
+    // Palette and mipmaps stay in the source buffer until first use
+    mipmaps.clear();
+    palette.clear();
+    mappedPalette = nullptr;
+    pendingData = body.current();
+    pendingSize = body.remaining();
+    backing = std::move(source);
     
-    // Read platform
-    uint32_t platformVal;
-    stream.read(reinterpret_cast<char*>(&platformVal), 4);
-    if (stream.gcount() != 4) {
+    return true;
+}
+
+bool Texture::readD3DStruct(ChunkReader& body) {
+    // Fixed-size part of the struct: platform through compression/alpha byte
+    const size_t fixedSize = 4 + 4 + 32 + 32 + 4 + 4 + 2 + 2 + 1 + 1 + 1 + 1;
+    const uint8_t* fields;
+    if (!body.readView(fixedSize, fields)) {
         return false;
     }
-    platform = static_cast<Platform>(fromLittleEndian32(platformVal));
     
+    platform = static_cast<Platform>(ChunkReader::load32(fields));
     if (platform != Platform::D3D8 && platform != Platform::D3D9) {
         return false;
     }
     
-    // Read filter flags
-    stream.read(reinterpret_cast<char*>(&filterFlags), 4);
-    filterFlags = fromLittleEndian32(filterFlags);
+    filterFlags = ChunkReader::load32(fields + 4);
     
-    // Read names (32 bytes each)
-    char nameBuffer[32];
-    stream.read(nameBuffer, 32);
-    name = std::string(nameBuffer, strnlen(nameBuffer, 32));
+    // Names (32 bytes each)
+    ChunkReader(fields + 8, 64).readString(32, name);
+    ChunkReader(fields + 40, 32).readString(32, maskName);
     
-    stream.read(nameBuffer, 32);
-    maskName = std::string(nameBuffer, strnlen(nameBuffer, 32));
+    rasterFormat = static_cast<RasterFormat>(ChunkReader::load32(fields + 72));
     
-    // Read raster format
-    uint32_t rasterFormatVal;
-    stream.read(reinterpret_cast<char*>(&rasterFormatVal), 4);
-    rasterFormat = static_cast<RasterFormat>(fromLittleEndian32(rasterFormatVal));
-    
-    // Read alpha/compression info
+    // Alpha/compression info
     hasAlphaChannel = false;
     compression = Compression::NONE;
     
-    char fourcc[5] = {0};
-    uint8_t compressionOrAlpha = 0;
-    
-    if (platform == Platform::D3D9) {
-        stream.read(fourcc, 4);
-    } else {
-        uint32_t alphaVal;
-        stream.read(reinterpret_cast<char*>(&alphaVal), 4);
-        hasAlphaChannel = (fromLittleEndian32(alphaVal) == 1);
+    const uint8_t* fourcc = fields + 76;
+    if (platform == Platform::D3D8) {
+        hasAlphaChannel = (ChunkReader::load32(fields + 76) == 1);
     }
     
-    // Read dimensions
-    uint16_t width, height;
-    stream.read(reinterpret_cast<char*>(&width), 2);
-    stream.read(reinterpret_cast<char*>(&height), 2);
-    width = fromLittleEndian16(width);
-    height = fromLittleEndian16(height);
-    
-    // Read depth
-    stream.read(reinterpret_cast<char*>(&depth), 1);
-    
-    // Read mipmap count
-    uint8_t mipmapCount;
-    stream.read(reinterpret_cast<char*>(&mipmapCount), 1);
-    
-    // Skip raster type (always 4)
-    stream.seekg(1, std::ios::cur);
-    
-    // Read compression/alpha
-    stream.read(reinterpret_cast<char*>(&compressionOrAlpha), 1);
+    headerWidth = ChunkReader::load16(fields + 80);
+    headerHeight = ChunkReader::load16(fields + 82);
+    depth = fields[84];
+    headerMipmapCount = fields[85];
+    // fields[86] is the raster type (always 4)
+    uint8_t compressionOrAlpha = fields[87];
     
     if (platform == Platform::D3D9) {
         hasAlphaChannel = (compressionOrAlpha & 0x1) != 0;
@@ -199,8 +369,6 @@ bool Texture::readD3DStruct(std::istream& stream, ChunkHeader& parentHeader) {
                     compression = Compression::DXT3;
                 }
             }
-        } else {
-            compression = Compression::NONE;
         }
     } else {
         if (compressionOrAlpha == 1) {
@@ -210,7 +378,6 @@ bool Texture::readD3DStruct(std::istream& stream, ChunkHeader& parentHeader) {
         }
     }
     
-    // Read palette if present
     paletteSize = 0;
     if ((static_cast<uint32_t>(rasterFormat) & 0x2000) != 0) { // PAL8
         paletteSize = 256;
@@ -218,17 +385,30 @@ bool Texture::readD3DStruct(std::istream& stream, ChunkHeader& parentHeader) {
         paletteSize = 16;
     }
     
-    if (paletteSize > 0) {
-        palette.resize(paletteSize * 4);
-        stream.read(reinterpret_cast<char*>(palette.data()), paletteSize * 4);
+    return true;
+}
+
+bool Texture::ensureLoaded() const {
+    if (!pendingData) {
+        return true;
+    }
+    
+    ChunkReader body(pendingData, pendingSize);
+    pendingData = nullptr;
+    pendingSize = 0;
+    
+    // Palette refers into the source buffer
+    if (paletteSize > 0 && !body.readView(paletteSize * 4, mappedPalette)) {
+        return false;
     }
     
-    // Read mipmaps
-    mipmaps.clear();
-    uint32_t currentWidth = width;
-    uint32_t currentHeight = height;
+    // Mipmaps refer into the source buffer
+    std::vector<MipmapLevel> levels;
+    levels.reserve(headerMipmapCount);
+    uint32_t currentWidth = headerWidth;
+    uint32_t currentHeight = headerHeight;
     
-    for (uint32_t i = 0; i < mipmapCount; i++) {
+    for (uint32_t i = 0; i < headerMipmapCount; i++) {
         if (i > 0) {
             currentWidth = std::max(1u, currentWidth / 2);
             currentHeight = std::max(1u, currentHeight / 2);
@@ -240,10 +420,10 @@ bool Texture::readD3DStruct(std::istream& stream, ChunkHeader& parentHeader) {
             }
         }
         
-        // Read mipmap size
         uint32_t mipSize;
-        stream.read(reinterpret_cast<char*>(&mipSize), 4);
-        mipSize = fromLittleEndian32(mipSize);
+        if (!body.readU32(mipSize)) {
+            return false;
+        }
         
         if (mipSize == 0) {
             currentWidth = currentHeight = 0;
@@ -253,17 +433,17 @@ bool Texture::readD3DStruct(std::istream& stream, ChunkHeader& parentHeader) {
         mipmap.width = currentWidth;
         mipmap.height = currentHeight;
         mipmap.dataSize = mipSize;
-        
-        if (mipSize > 0) {
-            mipmap.data.resize(mipSize);
-            stream.read(reinterpret_cast<char*>(mipmap.data.data()), mipSize);
+        if (!body.readView(mipSize, mipmap.mappedData)) {
+            return false;
+        }
+        if (mipSize == 0) {
+            mipmap.mappedData = nullptr;
         }
         
-        mipmaps.push_back(std::move(mipmap));
+        levels.push_back(std::move(mipmap));
     }
     
-    // Skip to end of struct
-    stream.seekg(structEnd, std::ios::beg);
+    mipmaps = std::move(levels);
     
     return true;
 }
@@ -278,135 +458,106 @@ bool Texture::readPS2(std::istream& stream) {
     return false;
 }
 
+uint32_t Texture::getWrittenMipmapCount() const {
+    // A chain is only stored when the raster says it has one. With AUTOMIPMAP
+    // the game builds the smaller levels itself, so only level 0 is written.
+    uint32_t flags = static_cast<uint32_t>(rasterFormat);
+    bool storesChain = (flags & static_cast<uint32_t>(RasterFormat::MIPMAP)) != 0
+        && (flags & static_cast<uint32_t>(RasterFormat::AUTOMIPMAP)) == 0;
+    uint32_t count = static_cast<uint32_t>(mipmaps.size());
+    return storesChain ? count : std::min<uint32_t>(count, 1);
+}
+
+uint32_t Texture::getD3DStructSize() const {
+    ensureLoaded();
+    
+    // platform, filter flags, two names, raster format, alpha/fourcc,
+    // width, height, depth, mipmap count, raster type, compression
+    size_t size = 4 + 4 + 32 + 32 + 4 + 4 + 2 + 2 + 1 + 1 + 1 + 1;
+    if (paletteSize > 0 && !getPalette().empty()) {
+        size += static_cast<size_t>(paletteSize) * 4;
+    }
+    for (uint32_t i = 0; i < getWrittenMipmapCount(); i++) {
+        size += 4 + (mipmaps[i].getData() ? mipmaps[i].dataSize : 0);
+    }
+    return static_cast<uint32_t>(size);
+}
+
+uint32_t Texture::getD3DSize() const {
+    // Section header, struct chunk and empty extension chunk
+    return 12 + 12 + getD3DStructSize() + 12;
+}
+
 uint32_t Texture::writeD3D(std::ostream& stream, uint32_t version) const {
-    size_t sectionStart = stream.tellp();
-    
-    // Write section header (will update later)
-    ChunkHeader sectionHeader;
-    sectionHeader.type = ChunkType::TEXTURENATIVE;
-    sectionHeader.length = 0; // Will update
-    sectionHeader.version = version;
-    sectionHeader.write(stream);
-    
-    // Write struct
-    uint32_t structSize = writeD3DStruct(stream, version);
-    
-    // Write extension section (empty)
-    ChunkHeader extHeader;
-    extHeader.type = ChunkType::EXTENSION;
-    extHeader.length = 0;
-    extHeader.version = version;
-    extHeader.write(stream);
-    
-    // Update section size
-    size_t sectionEnd = stream.tellp();
-    stream.seekp(sectionStart + 4, std::ios::beg);
-    uint32_t sectionSize = toLittleEndian32(static_cast<uint32_t>(sectionEnd - sectionStart - 12));
-    stream.write(reinterpret_cast<const char*>(&sectionSize), 4);
-    stream.seekp(sectionEnd, std::ios::beg);
-    
-    return static_cast<uint32_t>(sectionEnd - sectionStart);
+    ChunkWriter writer;
+    writeD3D(writer, version);
+    writer.writeTo(stream);
+    return static_cast<uint32_t>(writer.size());
 }
 
-uint32_t Texture::writeD3DStruct(std::ostream& stream, uint32_t version) const {
-    size_t structStart = stream.tellp();
-    
-    // Write struct header (will update later)
-    ChunkHeader structHeader;
-    structHeader.type = ChunkType::STRUCT;
-    structHeader.length = 0; // Will update
-    structHeader.version = version;
-    structHeader.write(stream);
+void Texture::writeD3D(ChunkWriter& writer, uint32_t version) const {
+    uint32_t structSize = getD3DStructSize();
     
-    // Write platform
-    uint32_t platformVal = toLittleEndian32(static_cast<uint32_t>(platform));
-    stream.write(reinterpret_cast<const char*>(&platformVal), 4);
-    
-    // Write filter flags
-    uint32_t filterFlagsVal = toLittleEndian32(filterFlags);
-    stream.write(reinterpret_cast<const char*>(&filterFlagsVal), 4);
+    writer.writeHeader(ChunkType::TEXTURENATIVE, 12 + structSize + 12, version);
+    writer.writeHeader(ChunkType::STRUCT, structSize, version);
+    writeD3DStruct(writer);
+    writer.writeHeader(ChunkType::EXTENSION, 0, version);
+}
+
+void Texture::writeD3DStruct(ChunkWriter& writer) const {
+    writer.writeU32(static_cast<uint32_t>(platform));
+    writer.writeU32(filterFlags);
     
-    // Write names (32 bytes each, null-padded)
+    // Names (32 bytes each, null-padded)
     char nameBuffer[32] = {0};
     strncpy(nameBuffer, name.c_str(), 31);
-    stream.write(nameBuffer, 32);
+    writer.writeBytes(nameBuffer, 32);
     
+    std::memset(nameBuffer, 0, sizeof(nameBuffer));
     strncpy(nameBuffer, maskName.c_str(), 31);
-    stream.write(nameBuffer, 32);
+    writer.writeBytes(nameBuffer, 32);
     
-    // Write raster format
-    uint32_t rasterFormatVal = toLittleEndian32(static_cast<uint32_t>(rasterFormat));
-    stream.write(reinterpret_cast<const char*>(&rasterFormatVal), 4);
+    writer.writeU32(static_cast<uint32_t>(rasterFormat));
     
-    // Write alpha/compression
+    // Alpha/compression
     if (platform == Platform::D3D8) {
-        uint32_t alphaVal = toLittleEndian32(hasAlphaChannel ? 1 : 0);
-        stream.write(reinterpret_cast<const char*>(&alphaVal), 4);
+        writer.writeU32(hasAlphaChannel ? 1 : 0);
     } else { // D3D9
-        if (compression != Compression::NONE) {
-            char fourcc[4];
-            if (compression == Compression::DXT1) {
-                fourcc[0] = 'D'; fourcc[1] = 'X'; fourcc[2] = 'T'; fourcc[3] = '1';
-            } else if (compression == Compression::DXT3) {
-                fourcc[0] = 'D'; fourcc[1] = 'X'; fourcc[2] = 'T'; fourcc[3] = '3';
-            }
-            stream.write(fourcc, 4);
+        if (compression == Compression::DXT1) {
+            writer.writeBytes("DXT1", 4);
+        } else if (compression == Compression::DXT3) {
+            writer.writeBytes("DXT3", 4);
         } else {
-            uint32_t value = hasAlphaChannel ? 0x15 : 0x16;
-            uint32_t valueLE = toLittleEndian32(value);
-            stream.write(reinterpret_cast<const char*>(&valueLE), 4);
+            writer.writeU32(hasAlphaChannel ? 0x15 : 0x16);
         }
     }
     
-    // Write dimensions
-    uint16_t widthVal = toLittleEndian16(static_cast<uint16_t>(mipmaps.empty() ? 0 : mipmaps[0].width));
-    uint16_t heightVal = toLittleEndian16(static_cast<uint16_t>(mipmaps.empty() ? 0 : mipmaps[0].height));
-    stream.write(reinterpret_cast<const char*>(&widthVal), 2);
-    stream.write(reinterpret_cast<const char*>(&heightVal), 2);
-    
-    // Write depth
-    stream.write(reinterpret_cast<const char*>(&depth), 1);
-    
-    // Write mipmap count
-    uint8_t mipmapCount = static_cast<uint8_t>(mipmaps.size());
-    stream.write(reinterpret_cast<const char*>(&mipmapCount), 1);
-    
-    // Write raster type (always 4)
-    uint8_t rasterType = 0x4;
-    stream.write(reinterpret_cast<const char*>(&rasterType), 1);
+    writer.writeU16(static_cast<uint16_t>(mipmaps.empty() ? 0 : mipmaps[0].width));
+    writer.writeU16(static_cast<uint16_t>(mipmaps.empty() ? 0 : mipmaps[0].height));
+    writer.writeU8(static_cast<uint8_t>(depth));
+    const uint32_t mipmapCount = getWrittenMipmapCount();
+    writer.writeU8(static_cast<uint8_t>(mipmapCount));
+    writer.writeU8(0x4); // Raster type (always 4)
     
-    // Write compression/alpha
-    uint8_t compressionOrAlpha;
     if (platform == Platform::D3D8) {
-        compressionOrAlpha = static_cast<uint8_t>(compression);
+        writer.writeU8(static_cast<uint8_t>(compression));
     } else {
-        compressionOrAlpha = (compression != Compression::NONE ? 8 : 0) | (hasAlphaChannel ? 1 : 0);
+        writer.writeU8((compression != Compression::NONE ? 8 : 0) | (hasAlphaChannel ? 1 : 0));
     }
-    stream.write(reinterpret_cast<const char*>(&compressionOrAlpha), 1);
     
-    // Write palette if present
-    if (paletteSize > 0 && !palette.empty()) {
-        stream.write(reinterpret_cast<const char*>(palette.data()), paletteSize * 4);
+    // Palette and mipmaps are referenced, not copied
+    ByteSpan paletteData = getPalette();
+    if (paletteSize > 0 && !paletteData.empty()) {
+        writer.writeView(paletteData.data(), static_cast<size_t>(paletteSize) * 4);
     }
     
-    // Write mipmaps
-    for (const auto& mipmap : mipmaps) {
-        uint32_t mipSize = toLittleEndian32(mipmap.dataSize);
-        stream.write(reinterpret_cast<const char*>(&mipSize), 4);
-        
-        if (mipmap.dataSize > 0 && !mipmap.data.empty()) {
-            stream.write(reinterpret_cast<const char*>(mipmap.data.data()), mipmap.dataSize);
-        }
+    for (uint32_t i = 0; i < mipmapCount; i++) {
+        const MipmapLevel& mipmap = mipmaps[i];
+        // A level without data is written as empty so the precomputed size holds
+        uint32_t mipSize = mipmap.getData() ? mipmap.dataSize : 0;
+        writer.writeU32(mipSize);
+        writer.writeView(mipmap.getData(), mipSize);
     }
-    
-    // Update struct size
-    size_t structEnd = stream.tellp();
-    stream.seekp(structStart + 4, std::ios::beg);
-    uint32_t structSize = toLittleEndian32(static_cast<uint32_t>(structEnd - structStart - 12));
-    stream.write(reinterpret_cast<const char*>(&structSize), 4);
-    stream.seekp(structEnd, std::ios::beg);
-    
-    return static_cast<uint32_t>(structEnd - structStart);
 }
 
 } // namespace LibTXD
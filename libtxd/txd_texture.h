@@ -10,14 +10,27 @@
 
 namespace LibTXD {
 
+class ChunkReader;
+class ChunkWriter;
+
 // Mipmap level data
+// A level either owns its pixels in `data`, or (when loaded from a file
+// buffer or memory mapping) refers to them through `mappedData` without copying.
 struct MipmapLevel {
     uint32_t width;
     uint32_t height;
     uint32_t dataSize;
     std::vector<uint8_t> data;
+    const uint8_t* mappedData;  // Borrowed pixels, only used while `data` is empty
+    
+    MipmapLevel() : width(0), height(0), dataSize(0), mappedData(nullptr) {}
     
-    MipmapLevel() : width(0), height(0), dataSize(0) {}
+    // Pixel data regardless of where it lives
+    const uint8_t* getData() const { return data.empty() ? mappedData : data.data(); }
+    bool isMapped() const { return data.empty() && mappedData != nullptr; }
+    
+    // Copy borrowed pixels into `data` so they can be modified
+    void detach();
 };
 
 // Texture class representing a native texture in a TXD file
@@ -32,6 +45,10 @@ public:
     Texture(Texture&&) noexcept;
     Texture& operator=(Texture&&) noexcept;
     
+    // Explicit copy. Mapped pixel and palette data is shared with the
+    // original (it stays alive through the same backing), owned data is copied.
+    Texture clone() const;
+    
     // Getters
     Platform getPlatform() const { return platform; }
     const std::string& getName() const { return name; }
@@ -39,14 +56,19 @@ public:
     uint32_t getFilterFlags() const { return filterFlags; }
     RasterFormat getRasterFormat() const { return rasterFormat; }
     uint32_t getDepth() const { return depth; }
-    uint32_t getMipmapCount() const { return static_cast<uint32_t>(mipmaps.size()); }
+    uint32_t getMipmapCount() const;
     bool hasAlpha() const { return hasAlphaChannel; }
     Compression getCompression() const { return compression; }
     
+    // Base level dimensions; available without loading pixel data
+    uint32_t getWidth() const;
+    uint32_t getHeight() const;
+    
+    // Loads pixel and palette data first if only the header was read
     const MipmapLevel& getMipmap(size_t index) const;
     MipmapLevel& getMipmap(size_t index);
     
-    const std::vector<uint8_t>& getPalette() const { return palette; }
+    ByteSpan getPalette() const;
     uint32_t getPaletteSize() const { return paletteSize; }
     
     // Setters
@@ -60,18 +82,37 @@ public:
     void setCompression(Compression comp) { compression = comp; }
     
     void addMipmap(MipmapLevel mipmap);
+    void clearMipmaps();
     void setPalette(const std::vector<uint8_t>& pal, uint32_t size);
     
     // Reading
+    // Reads one TEXTURENATIVE section into memory; the texture shares that buffer
     bool readD3D(std::istream& stream);
+    // Read from memory; pixel data and palette refer into `data` and `backing`
+    // keeps it alive. `data` must start at the TEXTURENATIVE chunk header.
+    bool readD3D(const uint8_t* data, size_t size, std::shared_ptr<const void> backing);
+    // Like readD3D, but only parses the header fields. Palette and mipmaps are
+    // located on first access, which is not thread-safe for the same texture.
+    bool readD3DHeader(const uint8_t* data, size_t size, std::shared_ptr<const void> backing);
     bool readXbox(std::istream& stream);
     bool readPS2(std::istream& stream);
     
     // Writing
     uint32_t writeD3D(std::ostream& stream, uint32_t version = 0x1803FFFF) const;
+    // Append the TEXTURENATIVE chunk; mipmaps and palette are referenced, so
+    // the texture must outlive the writer
+    void writeD3D(ChunkWriter& writer, uint32_t version = 0x1803FFFF) const;
+    // Size in bytes of the TEXTURENATIVE chunk writeD3D produces, header included
+    uint32_t getD3DSize() const;
     
     // Utility
     void clear();
+    // False while only the header has been read
+    bool isLoaded() const;
+    // True if any pixel or palette data still refers to the source buffer
+    bool isMapped() const;
+    // Copy all mapped data into owned buffers (copy-on-write)
+    void detach();
     
 private:
     Platform platform;
@@ -83,19 +124,33 @@ private:
     bool hasAlphaChannel;
     Compression compression;
     
-    std::vector<MipmapLevel> mipmaps;
+    mutable std::vector<MipmapLevel> mipmaps;
     std::vector<uint8_t> palette;
+    mutable const uint8_t* mappedPalette;  // Borrowed palette, only used while `palette` is empty
     uint32_t paletteSize;
     
+    // Keeps the memory behind mapped mipmaps and palette alive
+    std::shared_ptr<const void> backing;
+    
+    // Header fields, and the unparsed palette/mipmap bytes for lazy loading
+    uint32_t headerWidth;
+    uint32_t headerHeight;
+    uint32_t headerMipmapCount;
+    mutable const uint8_t* pendingData;
+    mutable size_t pendingSize;
+    
     // PS2 specific
     std::vector<uint32_t> swizzleWidth;
     std::vector<uint32_t> swizzleHeight;
     
     // Helper functions
-    bool readD3DStruct(std::istream& stream, ChunkHeader& header);
+    bool readD3DStruct(ChunkReader& body);
+    bool ensureLoaded() const;
     bool readXboxStruct(std::istream& stream, ChunkHeader& header);
     bool readPS2Struct(std::istream& stream, ChunkHeader& header);
-    uint32_t writeD3DStruct(std::ostream& stream, uint32_t version) const;
+    uint32_t getWrittenMipmapCount() const;
+    uint32_t getD3DStructSize() const;
+    void writeD3DStruct(ChunkWriter& writer) const;
 };
 
 } // namespace LibTXD
@@ -1,4 +1,5 @@
 #include "txd_types.h"
+#include "txd_reader.h"
 #include <istream>
 #include <ostream>
 #include <cstring>
@@ -6,28 +7,13 @@
 namespace LibTXD {
 
 bool ChunkHeader::read(std::istream& stream) {
-    uint32_t typeVal, lengthVal, versionVal;
-    
-    stream.read(reinterpret_cast<char*>(&typeVal), 4);
-    if (stream.gcount() != 4) {
-        return false;
-    }
-    
-    stream.read(reinterpret_cast<char*>(&lengthVal), 4);
-    if (stream.gcount() != 4) {
+    uint8_t bytes[12];
+    stream.read(reinterpret_cast<char*>(bytes), 12);
+    if (stream.gcount() != 12) {
         return false;
     }
     
-    stream.read(reinterpret_cast<char*>(&versionVal), 4);
-    if (stream.gcount() != 4) {
-        return false;
-    }
-    
-    type = static_cast<ChunkType>(fromLittleEndian32(typeVal));
-    length = fromLittleEndian32(lengthVal);
-    version = fromLittleEndian32(versionVal);
-    
-    return true;
+    return ChunkReader(bytes, 12).readHeader(*this);
 }
 
 uint32_t ChunkHeader::write(std::ostream& stream) const {
@@ -112,6 +112,23 @@ inline uint16_t fromLittleEndian16(uint16_t value) {
 #endif
 }
 
+// Non-owning view over a contiguous range of bytes
+struct ByteSpan {
+    const uint8_t* ptr;
+    size_t length;
+
+    ByteSpan() : ptr(nullptr), length(0) {}
+    ByteSpan(const uint8_t* p, size_t len) : ptr(p), length(len) {}
+    ByteSpan(const std::vector<uint8_t>& v) : ptr(v.data()), length(v.size()) {}
+
+    const uint8_t* data() const { return ptr; }
+    size_t size() const { return length; }
+    bool empty() const { return length == 0; }
+    const uint8_t* begin() const { return ptr; }
+    const uint8_t* end() const { return ptr + length; }
+    uint8_t operator[](size_t index) const { return ptr[index]; }
+};
+
 // Chunk header structure
 struct ChunkHeader {
     ChunkType type;
@@ -0,0 +1,189 @@
+#include "txd_writer.h"
+#include <cstring>
+#include <algorithm>
+#include <fstream>
+
+#ifdef _WIN32
+#include <io.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#else
+#include <sys/uio.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <climits>
+#include <cerrno>
+#endif
+
+namespace LibTXD {
+
+namespace {
+
+// Views smaller than this are copied; an iovec per 4-byte field costs more
+// than the copy
+const size_t MIN_VIEW_SIZE = 64;
+
+#ifndef _WIN32
+#ifdef IOV_MAX
+const size_t MAX_IOVECS = IOV_MAX;
+#else
+const size_t MAX_IOVECS = 1024;
+#endif
+#endif
+
+} // namespace
+
+void ChunkWriter::append(const void* data, size_t count) {
+    if (count == 0) {
+        return;
+    }
+    size_t offset = buffer.size();
+    buffer.insert(buffer.end(), static_cast<const uint8_t*>(data), static_cast<const uint8_t*>(data) + count);
+    
+    // Extend the previous slice if it ends where this one starts
+    if (!slices.empty() && !slices.back().view && slices.back().offset + slices.back().size == offset) {
+        slices.back().size += count;
+    } else {
+        slices.push_back({nullptr, offset, count});
+    }
+    total += count;
+}
+
+void ChunkWriter::writeU8(uint8_t value) {
+    append(&value, 1);
+}
+
+void ChunkWriter::writeU16(uint16_t value) {
+    uint8_t bytes[2] = {static_cast<uint8_t>(value), static_cast<uint8_t>(value >> 8)};
+    append(bytes, 2);
+}
+
+void ChunkWriter::writeU32(uint32_t value) {
+    uint8_t bytes[4] = {
+        static_cast<uint8_t>(value), static_cast<uint8_t>(value >> 8),
+        static_cast<uint8_t>(value >> 16), static_cast<uint8_t>(value >> 24)
+    };
+    append(bytes, 4);
+}
+
+void ChunkWriter::writeHeader(ChunkType type, uint32_t length, uint32_t version) {
+    writeU32(static_cast<uint32_t>(type));
+    writeU32(length);
+    writeU32(version);
+}
+
+void ChunkWriter::writeBytes(const void* data, size_t count) {
+    append(data, count);
+}
+
+void ChunkWriter::writeView(const uint8_t* data, size_t count) {
+    if (count < MIN_VIEW_SIZE) {
+        append(data, count);
+        return;
+    }
+    slices.push_back({data, 0, count});
+    total += count;
+}
+
+bool ChunkWriter::writeTo(std::ostream& stream) const {
+    for (const auto& slice : slices) {
+        stream.write(reinterpret_cast<const char*>(sliceData(slice)), static_cast<std::streamsize>(slice.size));
+    }
+    return stream.good();
+}
+
+#ifdef _WIN32
+
+bool ChunkWriter::writeTo(int fd) const {
+    for (const auto& slice : slices) {
+        const uint8_t* data = sliceData(slice);
+        size_t left = slice.size;
+        while (left > 0) {
+            unsigned int chunk = static_cast<unsigned int>(std::min<size_t>(left, 1u << 30));
+            int written = _write(fd, data, chunk);
+            if (written <= 0) {
+                return false;
+            }
+            data += written;
+            left -= static_cast<size_t>(written);
+        }
+    }
+    return true;
+}
+
+bool ChunkWriter::writeToFile(const std::string& filepath, bool sync) const {
+    int fd = _open(filepath.c_str(), _O_WRONLY | _O_CREAT | _O_TRUNC | _O_BINARY, _S_IREAD | _S_IWRITE);
+    if (fd < 0) {
+        return false;
+    }
+    bool ok = writeTo(fd);
+    // _commit flushes the file buffers to disk (FlushFileBuffers)
+    if (ok && sync && _commit(fd) != 0) {
+        ok = false;
+    }
+    if (_close(fd) != 0) {
+        ok = false;
+    }
+    return ok;
+}
+
+#else
+
+bool ChunkWriter::writeTo(int fd) const {
+    std::vector<iovec> iov;
+    iov.reserve(std::min(slices.size(), MAX_IOVECS));
+    
+    size_t next = 0;
+    while (next < slices.size()) {
+        // Gather up to MAX_IOVECS slices per call
+        iov.clear();
+        for (size_t i = next; i < slices.size() && iov.size() < MAX_IOVECS; i++) {
+            iov.push_back({const_cast<uint8_t*>(sliceData(slices[i])), slices[i].size});
+        }
+        next += iov.size();
+        
+        // Resume after short writes
+        size_t first = 0;
+        while (first < iov.size()) {
+            ssize_t written = ::writev(fd, iov.data() + first, static_cast<int>(iov.size() - first));
+            if (written < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                return false;
+            }
+            if (written == 0) {
+                return false;
+            }
+            size_t done = static_cast<size_t>(written);
+            while (first < iov.size() && done >= iov[first].iov_len) {
+                done -= iov[first].iov_len;
+                first++;
+            }
+            if (first < iov.size()) {
+                iov[first].iov_base = static_cast<uint8_t*>(iov[first].iov_base) + done;
+                iov[first].iov_len -= done;
+            }
+        }
+    }
+    return true;
+}
+
+bool ChunkWriter::writeToFile(const std::string& filepath, bool sync) const {
+    int fd = ::open(filepath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        return false;
+    }
+    bool ok = writeTo(fd);
+    if (ok && sync && ::fsync(fd) != 0) {
+        ok = false;
+    }
+    if (::close(fd) != 0) {
+        ok = false;
+    }
+    return ok;
+}
+
+#endif
+
+} // namespace LibTXD
@@ -0,0 +1,58 @@
+#ifndef TXD_WRITER_H
+#define TXD_WRITER_H
+
+#include "txd_types.h"
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <ostream>
+
+namespace LibTXD {
+
+// Forward-only RenderWare output built as a list of byte slices.
+// Small fields are copied into an internal buffer, large payloads (mipmaps,
+// palettes) are referenced in place and must outlive the writer. Chunk lengths
+// have to be known when the header is written; nothing is patched afterwards,
+// so the result can go to pipes and other non-seekable outputs.
+class ChunkWriter {
+public:
+    void writeU8(uint8_t value);
+    void writeU16(uint16_t value);
+    void writeU32(uint32_t value);
+    void writeHeader(ChunkType type, uint32_t length, uint32_t version);
+    // Copy `count` bytes
+    void writeBytes(const void* data, size_t count);
+    // Reference `count` bytes without copying
+    void writeView(const uint8_t* data, size_t count);
+
+    // Total bytes written so far
+    size_t size() const { return total; }
+
+    bool writeTo(std::ostream& stream) const;
+    // Write to a file descriptor with gathered writes where available
+    bool writeTo(int fd) const;
+    // Create or truncate `filepath` and write everything to it; with `sync`
+    // the data is flushed to disk before returning
+    bool writeToFile(const std::string& filepath, bool sync = false) const;
+
+private:
+    struct Slice {
+        const uint8_t* view;  // Borrowed data, or nullptr for bytes in `buffer`
+        size_t offset;        // Offset into `buffer` when `view` is null
+        size_t size;
+    };
+
+    std::vector<uint8_t> buffer;
+    std::vector<Slice> slices;
+    size_t total = 0;
+
+    void append(const void* data, size_t count);
+    const uint8_t* sliceData(const Slice& slice) const {
+        return slice.view ? slice.view : buffer.data() + slice.offset;
+    }
+};
+
+} // namespace LibTXD
+
+#endif // TXD_WRITER_H
@@ -11,9 +11,19 @@
 #include <cstring>
 
 #include "libtxd/txd_types.h"
+#include "libtxd/txd_reader.h"
 #include "libtxd/txd_texture.h"
 #include "libtxd/txd_dictionary.h"
 #include "libtxd/txd_converter.h"
+#include "libtxd/txd_dxt.h"
+#include "libtxd/txd_pixels.h"
+#include "libtxd/txd_mipmap.h"
+#include "libtxd/txd_hash.h"
+#include "libtxd/txd_encode_cache.h"
+#include "libtxd/txd_builder.h"
+#include "libtxd/txd_index.h"
+#include "libtxd/txd_img.h"
+#include <squish.h>
 
 namespace fs = std::filesystem;
 
@@ -107,6 +117,50 @@ TEST_F(TxdTypesTest, ChunkHeader_ReadFromEmptyStream_ReturnsFalse) {
     EXPECT_FALSE(header.read(ss));
 }
 
+TEST_F(TxdTypesTest, ChunkReader_ReadsLittleEndianFields) {
+    const uint8_t bytes[] = {
+        0x16, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0xFF, 0xFF, 0x03, 0x18,
+        0x34, 0x12, 'a', 'b', 0x00, 'z'
+    };
+    LibTXD::ChunkReader reader(bytes, sizeof(bytes));
+    
+    LibTXD::ChunkHeader header;
+    ASSERT_TRUE(reader.readHeader(header));
+    EXPECT_EQ(header.type, LibTXD::ChunkType::TEXDICTIONARY);
+    EXPECT_EQ(header.length, 4u);
+    EXPECT_EQ(header.version, 0x1803FFFFu);
+    
+    uint16_t value = 0;
+    ASSERT_TRUE(reader.readU16(value));
+    EXPECT_EQ(value, 0x1234);
+    
+    std::string text;
+    ASSERT_TRUE(reader.readString(4, text));
+    EXPECT_EQ(text, "ab");
+    EXPECT_EQ(reader.remaining(), 0u);
+}
+
+TEST_F(TxdTypesTest, ChunkReader_FailsPastEndWithoutMoving) {
+    const uint8_t bytes[] = {1, 2, 3};
+    LibTXD::ChunkReader reader(bytes, sizeof(bytes));
+    
+    uint32_t value = 0;
+    EXPECT_FALSE(reader.readU32(value));
+    EXPECT_EQ(reader.tell(), 0u);
+    
+    const uint8_t* view = nullptr;
+    EXPECT_FALSE(reader.readView(4, view));
+    EXPECT_TRUE(reader.readView(3, view));
+    EXPECT_EQ(view, bytes);
+    EXPECT_FALSE(reader.skip(1));
+    
+    // Child readers are clamped to what is left
+    reader.seek(1);
+    LibTXD::ChunkReader child = reader.child(100);
+    EXPECT_EQ(child.size(), 2u);
+    EXPECT_EQ(reader.remaining(), 0u);
+}
+
 TEST_F(TxdTypesTest, RasterFormat_MaskExtractsBaseFormat) {
     uint32_t formatWithFlags = static_cast<uint32_t>(LibTXD::RasterFormat::B8G8R8A8) | 
                                static_cast<uint32_t>(LibTXD::RasterFormat::MIPMAP);
@@ -271,6 +325,15 @@ TEST_F(TextureTest, MoveConstructor_TransfersData) {
     EXPECT_EQ(texture2.getMipmap(0).data[0], 0x42);
 }
 
+TEST_F(TextureTest, ReadD3D_OversizedSectionLength_Fails) {
+    // TEXTURENATIVE header claiming ~4 GB with nothing after it
+    const uint8_t header[12] = {0x15, 0, 0, 0, 0xF0, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x03, 0x18};
+    std::istringstream stream(std::string(reinterpret_cast<const char*>(header), sizeof(header)));
+    
+    LibTXD::Texture texture;
+    EXPECT_FALSE(texture.readD3D(stream));
+}
+
 // ============================================================================
 // Texture Dictionary Tests
 // ============================================================================
@@ -487,6 +550,44 @@ TEST_F(DictionaryFileIOTest, Load_InvalidFile_ReturnsFalse) {
     EXPECT_FALSE(dict.load(invalidPath.string()));
 }
 
+TEST_F(DictionaryFileIOTest, Load_TruncatedFile_DropsIncompleteTexture) {
+    fs::path txdPath = getExamplePath("gtasa/infernus.txd");
+    
+    if (!fs::exists(txdPath)) {
+        GTEST_SKIP() << "Example file not found: " << txdPath;
+    }
+    
+    std::ifstream in(txdPath, std::ios::binary);
+    std::string bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    
+    LibTXD::TextureDictionary full;
+    std::istringstream fullStream(bytes);
+    ASSERT_TRUE(full.load(fullStream));
+    ASSERT_GT(full.getTextureCount(), 1u);
+    
+    // Cut the file in the middle of the last texture's pixels, before the
+    // trailing texture and dictionary extension headers
+    uint32_t sectionLength = 0;
+    std::memcpy(&sectionLength, bytes.data() + 4, 4);
+    size_t dictionaryEnd = 12 + LibTXD::fromLittleEndian32(sectionLength);
+    ASSERT_LE(dictionaryEnd, bytes.size());
+    std::istringstream truncated(bytes.substr(0, dictionaryEnd - 24 - 64));
+    LibTXD::TextureDictionary dict;
+    ASSERT_TRUE(dict.load(truncated));
+    EXPECT_EQ(dict.getTextureCount(), full.getTextureCount() - 1);
+    
+    // Lazy loading drops the same texture instead of failing on first use
+    fs::path truncatedPath = tempDir / "truncated.txd";
+    std::ofstream(truncatedPath, std::ios::binary) << truncated.str();
+    LibTXD::TextureDictionary lazy;
+    ASSERT_TRUE(lazy.load(truncatedPath.string(), LibTXD::LoadMode::Lazy));
+    ASSERT_EQ(lazy.getTextureCount(), dict.getTextureCount());
+    for (size_t i = 0; i < lazy.getTextureCount(); i++) {
+        EXPECT_GT(lazy.getTexture(i)->getMipmapCount(), 0u);
+        EXPECT_NO_THROW(lazy.getTexture(i)->getMipmap(0));
+    }
+}
+
 TEST_F(DictionaryFileIOTest, Save_EmptyDictionary) {
     LibTXD::TextureDictionary dict;
     dict.setVersion(0x1803FFFF);
@@ -501,6 +602,37 @@ TEST_F(DictionaryFileIOTest, Save_EmptyDictionary) {
     EXPECT_EQ(reloaded.getTextureCount(), 0u);
 }
 
+TEST_F(DictionaryFileIOTest, Save_ReplacesFileAtomically) {
+    LibTXD::TextureDictionary dict;
+    dict.setVersion(0x1803FFFF);
+    
+    fs::path savePath = tempDir / "atomic.txd";
+    fs::path tempPath = tempDir / "atomic.txd.tmp";
+    {
+        std::ofstream existing(savePath, std::ios::binary);
+        existing << "previous contents";
+    }
+    
+    // If the temp file cannot be written the target must stay untouched
+    fs::create_directories(tempPath);
+    EXPECT_FALSE(dict.save(savePath.string()));
+    std::ifstream previous(savePath, std::ios::binary);
+    std::string contents((std::istreambuf_iterator<char>(previous)), std::istreambuf_iterator<char>());
+    EXPECT_EQ(contents, "previous contents");
+    previous.close();
+    
+    fs::remove(tempPath);
+    const fs::perms restricted = fs::perms::owner_read | fs::perms::owner_write;
+    fs::permissions(savePath, restricted);
+    EXPECT_TRUE(dict.save(savePath.string()));
+    EXPECT_FALSE(fs::exists(tempPath));
+    LibTXD::TextureDictionary reloaded;
+    EXPECT_TRUE(reloaded.load(savePath.string()));
+    
+    // The replacement keeps the original file's permissions
+    EXPECT_EQ(fs::status(savePath).permissions() & fs::perms::mask, restricted);
+}
+
 TEST_F(DictionaryFileIOTest, Roundtrip_PreservesTextureCount) {
     fs::path txdPath = getExamplePath("gtavc/infernus.txd");
     
@@ -596,6 +728,205 @@ TEST_F(DictionaryFileIOTest, Roundtrip_PreservesTextureDimensions) {
     }
 }
 
+TEST_F(DictionaryFileIOTest, LoadMapped_MatchesBufferedLoad) {
+    for (const char* example : {"gta3/infernus.txd", "gtavc/infernus.txd", "gtasa/infernus.txd"}) {
+        fs::path txdPath = getExamplePath(example);
+        if (!fs::exists(txdPath)) {
+            continue;
+        }
+        
+        LibTXD::TextureDictionary buffered;
+        LibTXD::TextureDictionary mapped;
+        ASSERT_TRUE(buffered.load(txdPath.string()));
+        ASSERT_TRUE(mapped.load(txdPath.string(), LibTXD::LoadMode::Mapped));
+        
+        EXPECT_EQ(mapped.getVersion(), buffered.getVersion());
+        ASSERT_EQ(mapped.getTextureCount(), buffered.getTextureCount());
+        for (size_t i = 0; i < mapped.getTextureCount(); i++) {
+            const auto* a = buffered.getTexture(i);
+            const auto* b = mapped.getTexture(i);
+            EXPECT_EQ(b->getName(), a->getName());
+            EXPECT_EQ(b->getRasterFormat(), a->getRasterFormat());
+            EXPECT_EQ(b->getCompression(), a->getCompression());
+            EXPECT_TRUE(b->isMapped());
+            ASSERT_EQ(b->getMipmapCount(), a->getMipmapCount());
+            for (size_t m = 0; m < b->getMipmapCount(); m++) {
+                const auto& mipA = a->getMipmap(m);
+                const auto& mipB = b->getMipmap(m);
+                EXPECT_TRUE(mipB.isMapped());
+                ASSERT_EQ(mipB.dataSize, mipA.dataSize);
+                EXPECT_EQ(std::memcmp(mipB.getData(), mipA.getData(), mipA.dataSize), 0);
+            }
+        }
+    }
+}
+
+TEST_F(DictionaryFileIOTest, LoadMapped_EditCopiesOnWrite) {
+    fs::path txdPath = getExamplePath("gtasa/infernus.txd");
+    
+    if (!fs::exists(txdPath)) {
+        GTEST_SKIP() << "Example file not found: " << txdPath;
+    }
+    
+    LibTXD::TextureDictionary dict;
+    ASSERT_TRUE(dict.load(txdPath.string(), LibTXD::LoadMode::Mapped));
+    ASSERT_GT(dict.getTextureCount(), 0u);
+    
+    LibTXD::Texture* tex = dict.getTexture(0);
+    const uint8_t* mappedPixels = static_cast<const LibTXD::Texture*>(tex)->getMipmap(0).getData();
+    
+    // Non-const access detaches the level into an owned buffer
+    auto& mip = tex->getMipmap(0);
+    EXPECT_FALSE(mip.isMapped());
+    EXPECT_NE(mip.getData(), mappedPixels);
+    EXPECT_EQ(std::memcmp(mip.getData(), mappedPixels, mip.dataSize), 0);
+    mip.data[0] ^= 0xFF;
+    EXPECT_NE(mip.data[0], mappedPixels[0]);
+}
+
+TEST_F(DictionaryFileIOTest, Clone_SharesMappedPixels) {
+    fs::path txdPath = getExamplePath("gtavc/infernus.txd");
+    
+    if (!fs::exists(txdPath)) {
+        GTEST_SKIP() << "Example file not found: " << txdPath;
+    }
+    
+    std::ostringstream original;
+    LibTXD::Texture copy;
+    const uint8_t* mappedPixels = nullptr;
+    uint32_t version = 0;
+    {
+        LibTXD::TextureDictionary dict;
+        ASSERT_TRUE(dict.load(txdPath.string(), LibTXD::LoadMode::Mapped));
+        ASSERT_GT(dict.getTextureCount(), 0u);
+        const LibTXD::Texture* tex = dict.getTexture(0);
+        mappedPixels = tex->getMipmap(0).getData();
+        version = dict.getVersion();
+        tex->writeD3D(original, version);
+        copy = tex->clone();
+    }
+    
+    // The clone views the same mapping and keeps it alive
+    EXPECT_EQ(static_cast<const LibTXD::Texture&>(copy).getMipmap(0).getData(), mappedPixels);
+    std::ostringstream cloned;
+    copy.writeD3D(cloned, version);
+    EXPECT_EQ(cloned.str(), original.str());
+}
+
+TEST_F(DictionaryFileIOTest, LoadLazy_DefersPixelDataUntilAccess) {
+    fs::path txdPath = getExamplePath("gtavc/infernus.txd");
+    
+    if (!fs::exists(txdPath)) {
+        GTEST_SKIP() << "Example file not found: " << txdPath;
+    }
+    
+    LibTXD::TextureDictionary buffered;
+    LibTXD::TextureDictionary lazy;
+    ASSERT_TRUE(buffered.load(txdPath.string()));
+    ASSERT_TRUE(lazy.load(txdPath.string(), LibTXD::LoadMode::Lazy));
+    ASSERT_EQ(lazy.getTextureCount(), buffered.getTextureCount());
+    
+    for (size_t i = 0; i < lazy.getTextureCount(); i++) {
+        const auto* a = buffered.getTexture(i);
+        const auto* b = lazy.getTexture(i);
+        
+        // Header fields are available without touching pixel data
+        EXPECT_FALSE(b->isLoaded());
+        EXPECT_EQ(b->getName(), a->getName());
+        EXPECT_EQ(b->getWidth(), a->getMipmap(0).width);
+        EXPECT_EQ(b->getHeight(), a->getMipmap(0).height);
+        EXPECT_EQ(b->getMipmapCount(), a->getMipmapCount());
+        EXPECT_FALSE(b->isLoaded());
+        
+        const auto& mip = b->getMipmap(0);
+        EXPECT_TRUE(b->isLoaded());
+        ASSERT_EQ(mip.dataSize, a->getMipmap(0).dataSize);
+        EXPECT_EQ(std::memcmp(mip.getData(), a->getMipmap(0).getData(), mip.dataSize), 0);
+    }
+    
+    // Saving loads whatever was not touched yet
+    LibTXD::TextureDictionary lazyAgain;
+    ASSERT_TRUE(lazyAgain.load(txdPath.string(), LibTXD::LoadMode::Lazy));
+    std::stringstream fromLazy, fromBuffered;
+    ASSERT_TRUE(lazyAgain.save(fromLazy));
+    ASSERT_TRUE(buffered.save(fromBuffered));
+    EXPECT_EQ(fromLazy.str(), fromBuffered.str());
+}
+
+TEST_F(DictionaryFileIOTest, LoadMapped_SaveOverSourceFile) {
+    fs::path txdPath = getExamplePath("gtavc/infernus.txd");
+    
+    if (!fs::exists(txdPath)) {
+        GTEST_SKIP() << "Example file not found: " << txdPath;
+    }
+    
+    fs::path workPath = tempDir / "mapped_inplace.txd";
+    fs::copy_file(txdPath, workPath, fs::copy_options::overwrite_existing);
+    
+    LibTXD::TextureDictionary dict;
+    ASSERT_TRUE(dict.load(workPath.string(), LibTXD::LoadMode::Mapped));
+    size_t count = dict.getTextureCount();
+    
+    // Writing over the mapped file must not invalidate the pixel views
+    ASSERT_TRUE(dict.save(workPath.string()));
+    ASSERT_TRUE(dict.save(workPath.string()));
+    
+    LibTXD::TextureDictionary reloaded;
+    ASSERT_TRUE(reloaded.load(workPath.string()));
+    EXPECT_EQ(reloaded.getTextureCount(), count);
+}
+
+// Output that accepts bytes but cannot seek, like a pipe
+class AppendOnlyBuffer : public std::streambuf {
+public:
+    std::string bytes;
+protected:
+    int_type overflow(int_type ch) override {
+        if (ch != traits_type::eof()) {
+            bytes.push_back(static_cast<char>(ch));
+        }
+        return ch;
+    }
+    std::streamsize xsputn(const char* s, std::streamsize n) override {
+        bytes.append(s, static_cast<size_t>(n));
+        return n;
+    }
+};
+
+TEST_F(DictionaryFileIOTest, Save_NonSeekableStreamMatchesFile) {
+    fs::path txdPath = getExamplePath("gtavc/infernus.txd");
+    
+    if (!fs::exists(txdPath)) {
+        GTEST_SKIP() << "Example file not found: " << txdPath;
+    }
+    
+    LibTXD::TextureDictionary dict;
+    ASSERT_TRUE(dict.load(txdPath.string(), LibTXD::LoadMode::Mapped));
+    
+    AppendOnlyBuffer buffer;
+    std::ostream pipe(&buffer);
+    ASSERT_TRUE(dict.save(pipe));
+    
+    // Precomputed sizes match what was written
+    size_t expected = 12 + 12 + 4 + 12;
+    for (size_t i = 0; i < dict.getTextureCount(); i++) {
+        expected += dict.getTexture(i)->getD3DSize();
+    }
+    EXPECT_EQ(buffer.bytes.size(), expected);
+    
+    // The file path goes through gathered writes and must produce the same bytes
+    fs::path outPath = tempDir / "streamed.txd";
+    ASSERT_TRUE(dict.save(outPath.string()));
+    std::ifstream file(outPath, std::ios::binary);
+    std::string fileBytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    EXPECT_EQ(fileBytes, buffer.bytes);
+    
+    LibTXD::TextureDictionary reloaded;
+    std::istringstream input(buffer.bytes);
+    ASSERT_TRUE(reloaded.load(input));
+    EXPECT_EQ(reloaded.getTextureCount(), dict.getTextureCount());
+}
+
 // ============================================================================
 // Texture Converter Tests
 // ============================================================================
@@ -741,6 +1072,414 @@ TEST_F(TextureConverterTest, DXT1_CompressDecompress_Roundtrip) {
     EXPECT_LT(maxDiff, 20) << "DXT roundtrip error too high";
 }
 
+TEST_F(TextureConverterTest, CompressToDXT_Parallel_MatchesSquish) {
+    // Odd dimensions exercise partial edge blocks
+    const uint32_t width = 67, height = 45;
+    std::vector<uint8_t> rgba(width * height * 4);
+    uint32_t seed = 12345;
+    for (auto& byte : rgba) {
+        seed = seed * 1103515245 + 12345;
+        byte = static_cast<uint8_t>(seed >> 16);
+    }
+    
+    unsigned previous = LibTXD::TextureConverter::getThreadCount();
+    LibTXD::TextureConverter::setThreadCount(4);
+    EXPECT_EQ(LibTXD::TextureConverter::getThreadCount(), 4u);
+    
+    for (auto compression : {LibTXD::Compression::DXT1, LibTXD::Compression::DXT3}) {
+        for (float quality : {0.0f, 1.0f}) {
+            int flags = (compression == LibTXD::Compression::DXT1) ? squish::kDxt1 : squish::kDxt3;
+            flags |= (quality >= 0.5f) ? squish::kColourClusterFit : squish::kColourRangeFit;
+            size_t size = LibTXD::TextureConverter::getCompressedDataSize(width, height, compression);
+            std::vector<uint8_t> expected(size);
+            squish::CompressImage(rgba.data(), width, height, expected.data(), flags);
+            
+            auto compressed = LibTXD::TextureConverter::compressToDXT(
+                rgba.data(), width, height, compression, quality);
+            ASSERT_NE(compressed, nullptr);
+            EXPECT_EQ(std::memcmp(compressed.get(), expected.data(), size), 0);
+        }
+    }
+    
+    LibTXD::TextureConverter::setThreadCount(previous);
+}
+
+TEST_F(TextureConverterTest, DecompressDXTInto_StridedOutputMatchesSquish) {
+    const uint32_t width = 37, height = 22;
+    std::vector<uint8_t> rgba(width * height * 4);
+    uint32_t seed = 777;
+    for (auto& byte : rgba) {
+        seed = seed * 1103515245 + 12345;
+        byte = static_cast<uint8_t>(seed >> 16);
+    }
+    
+    unsigned previous = LibTXD::TextureConverter::getThreadCount();
+    LibTXD::TextureConverter::setThreadCount(3);
+    
+    for (auto compression : {LibTXD::Compression::DXT1, LibTXD::Compression::DXT3}) {
+        auto compressed = LibTXD::TextureConverter::compressToDXT(
+            rgba.data(), width, height, compression, 0.0f);
+        ASSERT_NE(compressed, nullptr);
+        
+        int flags = (compression == LibTXD::Compression::DXT1) ? squish::kDxt1 : squish::kDxt3;
+        std::vector<uint8_t> expected(width * height * 4);
+        squish::DecompressImage(expected.data(), width, height, compressed.get(), flags);
+        
+        // Decode into the middle of a wider canvas; padding must stay untouched
+        const size_t stride = (width + 5) * 4;
+        std::vector<uint8_t> canvas(stride * height, 0xCD);
+        ASSERT_TRUE(LibTXD::TextureConverter::decompressDXTInto(
+            compressed.get(), width, height, compression, canvas.data(), stride));
+        
+        for (uint32_t y = 0; y < height; y++) {
+            EXPECT_EQ(std::memcmp(canvas.data() + y * stride, expected.data() + y * width * 4, width * 4), 0)
+                << "Row " << y;
+            for (size_t x = width * 4; x < stride; x++) {
+                EXPECT_EQ(canvas[y * stride + x], 0xCD);
+            }
+        }
+    }
+    
+    LibTXD::TextureConverter::setThreadCount(previous);
+}
+
+TEST_F(TextureConverterTest, DXTDecoders_BitExactWithSquish) {
+    // Random block data covers both DXT1 colour modes and every index
+    const uint32_t width = 45, height = 30;
+    const uint32_t blocksWide = (width + 3) / 4, blocksHigh = (height + 3) / 4;
+    std::vector<uint8_t> blocks(blocksWide * blocksHigh * 16);
+    uint32_t seed = 4242;
+    for (auto& byte : blocks) {
+        seed = seed * 1103515245 + 12345;
+        byte = static_cast<uint8_t>(seed >> 16);
+    }
+    
+    for (auto decoder : {LibTXD::DXT::Decoder::Scalar, LibTXD::DXT::Decoder::SSE2, LibTXD::DXT::Decoder::AVX2}) {
+        if (!LibTXD::DXT::isDecoderSupported(decoder)) {
+            continue;
+        }
+        for (bool dxt3 : {false, true}) {
+            std::vector<uint8_t> expected(width * height * 4);
+            squish::DecompressImage(expected.data(), width, height, blocks.data(),
+                                    dxt3 ? squish::kDxt3 : squish::kDxt1);
+            
+            std::vector<uint8_t> actual(width * height * 4);
+            const size_t blockSize = dxt3 ? 16 : 8;
+            for (uint32_t by = 0; by < blocksHigh; by++) {
+                uint32_t y = by * 4;
+                LibTXD::DXT::decodeBlockRow(decoder, blocks.data() + by * blocksWide * blockSize, dxt3,
+                                            width, std::min(4u, height - y), actual.data() + y * width * 4, width * 4);
+            }
+            
+            EXPECT_EQ(actual, expected) << "Decoder " << static_cast<int>(decoder) << (dxt3 ? " DXT3" : " DXT1");
+        }
+    }
+}
+
+TEST_F(TextureConverterTest, PixelKernels_SimdMatchesPortable) {
+    struct Case { LibTXD::RasterFormat format; uint32_t bytesPerPixel; };
+    const Case cases[] = {
+        {LibTXD::RasterFormat::B8G8R8A8, 4},
+        {LibTXD::RasterFormat::B8G8R8, 4},
+        {LibTXD::RasterFormat::B8G8R8, 3},
+        {LibTXD::RasterFormat::R5G6B5, 2},
+        {LibTXD::RasterFormat::A1R5G5B5, 2},
+        {LibTXD::RasterFormat::R4G4B4A4, 2},
+        {LibTXD::RasterFormat::LUM8, 1},
+    };
+    
+    // Odd length so every kernel also runs its scalar tail
+    const size_t count = 53;
+    std::vector<uint8_t> input(count * 4);
+    uint32_t seed = 99;
+    for (auto& byte : input) {
+        seed = seed * 1103515245 + 12345;
+        byte = static_cast<uint8_t>(seed >> 16);
+    }
+    
+    for (const auto& c : cases) {
+        auto unpackSimd = LibTXD::Pixels::getUnpacker(c.format, c.bytesPerPixel);
+        auto unpackPlain = LibTXD::Pixels::getUnpacker(c.format, c.bytesPerPixel, false);
+        auto packSimd = LibTXD::Pixels::getPacker(c.format, c.bytesPerPixel);
+        auto packPlain = LibTXD::Pixels::getPacker(c.format, c.bytesPerPixel, false);
+        ASSERT_TRUE(unpackSimd && unpackPlain && packSimd && packPlain);
+        
+        std::vector<uint8_t> a(count * 4), b(count * 4);
+        unpackSimd(input.data(), a.data(), count);
+        unpackPlain(input.data(), b.data(), count);
+        EXPECT_EQ(a, b) << "Unpack format " << std::hex << static_cast<uint32_t>(c.format);
+        
+        std::vector<uint8_t> na(count * c.bytesPerPixel), nb(count * c.bytesPerPixel);
+        packSimd(input.data(), na.data(), count);
+        packPlain(input.data(), nb.data(), count);
+        EXPECT_EQ(na, nb) << "Pack format " << std::hex << static_cast<uint32_t>(c.format);
+    }
+    
+    // Unsupported combinations have no kernel
+    EXPECT_EQ(LibTXD::Pixels::getUnpacker(LibTXD::RasterFormat::R5G6B5, 4), nullptr);
+}
+
+TEST_F(TextureConverterTest, PaletteKernels_SimdMatchesPortable) {
+    // 16 colour palette: indices 16..255 must read entry 0
+    std::vector<uint8_t> palette(16 * 4);
+    for (size_t i = 0; i < palette.size(); i++) {
+        palette[i] = static_cast<uint8_t>(i * 7 + 3);
+    }
+    alignas(32) uint32_t table[256];
+    LibTXD::Pixels::buildPaletteTable(palette.data(), 16, table);
+    
+    // Long enough for the chunked PAL4 path, odd so the tails run too
+    const size_t count = 301;
+    std::vector<uint8_t> indices(count);
+    uint32_t seed = 7;
+    for (auto& index : indices) {
+        seed = seed * 1103515245 + 12345;
+        index = static_cast<uint8_t>(seed >> 16);
+    }
+    
+    std::vector<uint8_t> a(count * 4), b(count * 4);
+    LibTXD::Pixels::getPalette8Expander()(indices.data(), table, a.data(), count);
+    LibTXD::Pixels::getPalette8Expander(false)(indices.data(), table, b.data(), count);
+    EXPECT_EQ(a, b);
+    for (size_t i = 0; i < count; i++) {
+        size_t entry = indices[i] < 16 ? indices[i] : 0;
+        ASSERT_EQ(0, std::memcmp(&a[i * 4], &palette[entry * 4], 4)) << "Pixel " << i;
+    }
+    
+    LibTXD::Pixels::getPalette4Expander()(indices.data(), table, a.data(), count);
+    LibTXD::Pixels::getPalette4Expander(false)(indices.data(), table, b.data(), count);
+    EXPECT_EQ(a, b);
+    for (size_t i = 0; i < count; i++) {
+        size_t entry = (indices[i / 2] >> ((i & 1) * 4)) & 0x0F;
+        ASSERT_EQ(0, std::memcmp(&a[i * 4], &palette[entry * 4], 4)) << "Pixel " << i;
+    }
+}
+
+TEST_F(TextureConverterTest, AlphaExtractor_SimdMatchesPortable) {
+    // Odd count so the tail runs too
+    const size_t count = 301;
+    std::vector<uint8_t> rgba(count * 4);
+    uint32_t seed = 11;
+    for (auto& byte : rgba) {
+        seed = seed * 1103515245 + 12345;
+        byte = static_cast<uint8_t>(seed >> 16);
+    }
+    
+    std::vector<uint8_t> a(count), b(count);
+    LibTXD::Pixels::getAlphaExtractor()(rgba.data(), a.data(), count);
+    LibTXD::Pixels::getAlphaExtractor(false)(rgba.data(), b.data(), count);
+    EXPECT_EQ(a, b);
+    for (size_t i = 0; i < count; i++) {
+        ASSERT_EQ(a[i], rgba[i * 4 + 3]) << "Pixel " << i;
+    }
+}
+
+TEST_F(TextureConverterTest, Mipmaps_DownsampleIsGammaCorrectAndAlphaWeighted) {
+    EXPECT_EQ(LibTXD::Mipmaps::getFullChainLength(256, 64), 9u);
+    EXPECT_EQ(LibTXD::Mipmaps::getFullChainLength(1, 1), 1u);
+    
+    // Uniform images keep their colour exactly
+    for (int v = 0; v < 256; v++) {
+        std::vector<uint8_t> flat = createTestRGBA(2, 2, static_cast<uint8_t>(v), 0, 255, 255);
+        uint8_t out[4];
+        LibTXD::Mipmaps::downsample(flat.data(), 2, 2, out);
+        ASSERT_EQ(out[0], v);
+        ASSERT_EQ(out[3], 255);
+    }
+    
+    // Black and white average to mid grey in linear light, not 128
+    const uint8_t checker[] = {0, 0, 0, 255, 255, 255, 255, 255, 255, 255, 255, 255, 0, 0, 0, 255};
+    uint8_t grey[4];
+    LibTXD::Mipmaps::downsample(checker, 2, 2, grey);
+    EXPECT_EQ(grey[0], 188);
+    
+    // Transparent texels do not tint the result
+    const uint8_t edge[] = {255, 0, 0, 255, 0, 255, 0, 0, 255, 0, 0, 255, 0, 255, 0, 0};
+    uint8_t red[4];
+    LibTXD::Mipmaps::downsample(edge, 2, 2, red);
+    EXPECT_EQ(red[0], 255);
+    EXPECT_EQ(red[1], 0);
+    EXPECT_EQ(red[3], 128);
+}
+
+TEST_F(TextureConverterTest, Mipmaps_SimdMatchesPortable) {
+    const uint32_t width = 37;
+    const uint32_t height = 22;
+    std::vector<uint8_t> image(width * height * 4);
+    uint32_t seed = 5;
+    for (auto& byte : image) {
+        seed = seed * 1103515245 + 12345;
+        byte = static_cast<uint8_t>(seed >> 16);
+    }
+    
+    std::vector<uint8_t> a(18 * 11 * 4), b(18 * 11 * 4);
+    LibTXD::Mipmaps::downsample(image.data(), width, height, a.data());
+    LibTXD::Mipmaps::downsample(image.data(), width, height, b.data(), false);
+    EXPECT_EQ(a, b);
+    
+    // One pixel wide sources only filter vertically
+    std::vector<uint8_t> column(1 * 8 * 4);
+    LibTXD::Mipmaps::downsample(image.data(), 1, 8, column.data());
+    LibTXD::Mipmaps::downsample(image.data(), 1, 8, column.data() + 16, false);
+    EXPECT_EQ(0, std::memcmp(column.data(), column.data() + 16, 16));
+}
+
+TEST_F(TextureConverterTest, GenerateMipmaps_FullChainRoundtrip) {
+    auto rgba = createTestRGBA(64, 32, 200, 100, 50, 255);
+    
+    LibTXD::Texture texture;
+    texture.setPlatform(LibTXD::Platform::D3D9);
+    texture.setName("chain");
+    texture.setRasterFormat(LibTXD::RasterFormat::B8G8R8A8);
+    texture.setDepth(16);
+    texture.setCompression(LibTXD::Compression::DXT1);
+    ASSERT_TRUE(LibTXD::TextureConverter::generateMipmaps(texture, rgba.data(), 64, 32));
+    
+    ASSERT_EQ(texture.getMipmapCount(), 7u);
+    EXPECT_NE(static_cast<uint32_t>(texture.getRasterFormat()) & static_cast<uint32_t>(LibTXD::RasterFormat::MIPMAP), 0u);
+    const LibTXD::Texture& constTexture = texture;
+    EXPECT_EQ(constTexture.getMipmap(6).width, 1u);
+    EXPECT_EQ(constTexture.getMipmap(6).height, 1u);
+    EXPECT_EQ(constTexture.getMipmap(1).dataSize, LibTXD::TextureConverter::getCompressedDataSize(32, 16, LibTXD::Compression::DXT1));
+    
+    // The chain survives a save/load
+    LibTXD::TextureDictionary dict;
+    dict.addTexture(std::move(texture));
+    std::stringstream stream;
+    ASSERT_TRUE(dict.save(stream));
+    LibTXD::TextureDictionary reloaded;
+    ASSERT_TRUE(reloaded.load(stream));
+    ASSERT_EQ(reloaded.getTextureCount(), 1u);
+    EXPECT_EQ(reloaded.getTexture(0)->getMipmapCount(), 7u);
+    
+    // AUTOMIPMAP textures only store level 0
+    LibTXD::Texture* stored = dict.getTexture(0);
+    stored->setRasterFormat(static_cast<LibTXD::RasterFormat>(
+        static_cast<uint32_t>(stored->getRasterFormat()) | static_cast<uint32_t>(LibTXD::RasterFormat::AUTOMIPMAP)));
+    std::stringstream autoStream;
+    ASSERT_TRUE(dict.save(autoStream));
+    LibTXD::TextureDictionary autoReloaded;
+    ASSERT_TRUE(autoReloaded.load(autoStream));
+    EXPECT_EQ(autoReloaded.getTexture(0)->getMipmapCount(), 1u);
+}
+
+TEST_F(TextureConverterTest, DXTBlockAverage_MatchesDecodedTexels) {
+    const uint32_t blocksWide = 16;
+    std::vector<uint8_t> blocks(blocksWide * 16);
+    uint32_t seed = 977;
+    for (auto& byte : blocks) {
+        seed = seed * 1103515245 + 12345;
+        byte = static_cast<uint8_t>(seed >> 16);
+    }
+    
+    for (bool dxt3 : {false, true}) {
+        const uint32_t width = blocksWide * 4;
+        std::vector<uint8_t> decoded(width * 4 * 4);
+        LibTXD::DXT::decodeBlockRow(LibTXD::DXT::Decoder::Scalar, blocks.data(), dxt3, width, 4,
+                                    decoded.data(), width * 4);
+        std::vector<uint8_t> averaged(blocksWide * 4);
+        LibTXD::DXT::averageBlockRow(blocks.data(), dxt3, blocksWide, averaged.data());
+        
+        for (uint32_t block = 0; block < blocksWide; block++) {
+            for (uint32_t c = 0; c < 4; c++) {
+                uint32_t sum = 0;
+                for (uint32_t y = 0; y < 4; y++) {
+                    for (uint32_t x = 0; x < 4; x++) {
+                        sum += decoded[y * width * 4 + (block * 4 + x) * 4 + c];
+                    }
+                }
+                EXPECT_EQ(averaged[block * 4 + c], (sum + 8) / 16) << "Block " << block << " channel " << c;
+            }
+        }
+    }
+}
+
+TEST_F(TextureConverterTest, ConvertToThumbnail_UsesSmallestCoveringLevel) {
+    // Uncompressed chain: the 32x16 level is read as is
+    auto gradient = createGradientRGBA(256, 128);
+    LibTXD::Texture chained;
+    chained.setRasterFormat(LibTXD::RasterFormat::B8G8R8A8);
+    chained.setDepth(32);
+    ASSERT_TRUE(LibTXD::TextureConverter::generateMipmaps(chained, gradient.data(), 256, 128));
+    
+    std::vector<uint8_t> thumbnail;
+    uint32_t width = 0, height = 0;
+    ASSERT_TRUE(LibTXD::TextureConverter::convertToThumbnail(chained, 32, thumbnail, width, height));
+    EXPECT_EQ(width, 32u);
+    EXPECT_EQ(height, 16u);
+    auto level3 = LibTXD::TextureConverter::convertToRGBA8(chained, 3);
+    ASSERT_NE(level3, nullptr);
+    EXPECT_EQ(std::memcmp(thumbnail.data(), level3.get(), thumbnail.size()), 0);
+    
+    // Single DXT level: block averaged to 64x32, then halved once
+    auto solid = createTestRGBA(256, 128, 200, 100, 50, 255);
+    LibTXD::Texture single;
+    single.setRasterFormat(LibTXD::RasterFormat::B8G8R8);
+    single.setDepth(16);
+    single.setCompression(LibTXD::Compression::DXT1);
+    ASSERT_TRUE(LibTXD::TextureConverter::generateMipmaps(single, solid.data(), 256, 128, 1));
+    ASSERT_TRUE(LibTXD::TextureConverter::convertToThumbnail(single, 32, thumbnail, width, height));
+    EXPECT_EQ(width, 32u);
+    EXPECT_EQ(height, 16u);
+    auto decoded = LibTXD::TextureConverter::convertToRGBA8(single, 0);
+    ASSERT_NE(decoded, nullptr);
+    for (size_t i = 0; i < thumbnail.size(); i++) {
+        EXPECT_NEAR(thumbnail[i], decoded[i % 4], 1) << "Byte " << i;
+    }
+}
+
+TEST_F(TextureConverterTest, ConvertToRGBA8_PackedPAL4) {
+    LibTXD::Texture texture;
+    texture.setRasterFormat(LibTXD::RasterFormat::PAL4);
+    std::vector<uint8_t> palette(16 * 4);
+    for (size_t i = 0; i < 16; i++) {
+        palette[i * 4 + 0] = static_cast<uint8_t>(i * 16);
+        palette[i * 4 + 3] = 255;
+    }
+    texture.setPalette(palette, 16);
+    
+    // 3x2 image, two indices per byte, rows padded to a whole byte
+    LibTXD::MipmapLevel level;
+    level.width = 3;
+    level.height = 2;
+    level.data = {0x21, 0x03, 0x54, 0x06};
+    level.dataSize = level.data.size();
+    texture.addMipmap(level);
+    
+    auto rgba = LibTXD::TextureConverter::convertToRGBA8(texture, 0);
+    ASSERT_NE(rgba, nullptr);
+    const uint8_t expected[] = {1, 2, 3, 4, 5, 6};
+    for (size_t i = 0; i < 6; i++) {
+        EXPECT_EQ(rgba[i * 4], expected[i] * 16) << "Pixel " << i;
+        EXPECT_EQ(rgba[i * 4 + 3], 255);
+    }
+}
+
+TEST_F(TextureConverterTest, PixelKernels_PackUnpackRoundtrip) {
+    // Values already representable in the native format survive a roundtrip
+    const uint8_t rgba[] = {
+        0x10, 0x20, 0x30, 0xFF,  0xF8, 0xFC, 0xF8, 0x00,  0x00, 0x04, 0x08, 0x80,
+    };
+    std::vector<uint8_t> native(3 * 4), back(3 * 4);
+    
+    auto pack565 = LibTXD::Pixels::getPacker(LibTXD::RasterFormat::R5G6B5, 2);
+    auto unpack565 = LibTXD::Pixels::getUnpacker(LibTXD::RasterFormat::R5G6B5, 2);
+    pack565(rgba, native.data(), 3);
+    unpack565(native.data(), back.data(), 3);
+    for (size_t i = 0; i < 3; i++) {
+        EXPECT_EQ(back[i * 4 + 0], rgba[i * 4 + 0]);
+        EXPECT_EQ(back[i * 4 + 1], rgba[i * 4 + 1]);
+        EXPECT_EQ(back[i * 4 + 2], rgba[i * 4 + 2]);
+        EXPECT_EQ(back[i * 4 + 3], 255);
+    }
+    
+    auto packBGRA = LibTXD::Pixels::getPacker(LibTXD::RasterFormat::B8G8R8A8, 4);
+    packBGRA(rgba, native.data(), 3);
+    EXPECT_EQ(native[0], 0x30);
+    EXPECT_EQ(native[2], 0x10);
+    EXPECT_EQ(native[7], 0x00);
+}
+
 TEST_F(TextureConverterTest, ConvertToRGBA8_UncompressedTexture) {
     LibTXD::Texture texture;
     texture.setRasterFormat(LibTXD::RasterFormat::B8G8R8A8);
@@ -850,6 +1589,91 @@ TEST_F(TextureConverterTest, GeneratePalette_PAL4) {
     EXPECT_EQ(indexedData.size(), 16u * 16);
 }
 
+TEST_F(TextureConverterTest, Hash64_MatchesReferenceVectors) {
+    // XXH64 reference values
+    EXPECT_EQ(LibTXD::Hash::hash64("", 0), 0xEF46DB3751D8E999ull);
+    EXPECT_EQ(LibTXD::Hash::hash64("abc", 3), 0x44BC2CF5AD770999ull);
+    const char* text = "Nobody inspects the spammish repetition";
+    EXPECT_EQ(LibTXD::Hash::hash64(text, std::strlen(text)), 0xFBCEA83C8A378BF1ull);
+}
+
+TEST_F(TextureConverterTest, EncodeCache_ReturnsStoredDXTAndPalettes) {
+    fs::path dir = fs::temp_directory_path() / "libtxd_encode_cache";
+    fs::remove_all(dir);
+    auto cache = LibTXD::EncodeCache::open(dir.string());
+    ASSERT_NE(cache, nullptr);
+    LibTXD::TextureConverter::setEncodeCache(cache);
+
+    const uint32_t size = 64;
+    auto rgba = createGradientRGBA(size, size);
+    const size_t blockBytes = LibTXD::TextureConverter::getCompressedDataSize(size, size, LibTXD::Compression::DXT1);
+    auto first = LibTXD::TextureConverter::compressToDXT(rgba.data(), size, size, LibTXD::Compression::DXT1);
+    EXPECT_EQ(cache->getMisses(), 1u);
+    auto second = LibTXD::TextureConverter::compressToDXT(rgba.data(), size, size, LibTXD::Compression::DXT1);
+    EXPECT_EQ(cache->getHits(), 1u);
+    ASSERT_TRUE(first && second);
+    EXPECT_EQ(std::memcmp(first.get(), second.get(), blockBytes), 0);
+
+    // Other settings or pixels are separate entries
+    LibTXD::TextureConverter::compressToDXT(rgba.data(), size, size, LibTXD::Compression::DXT1, 0.0f);
+    rgba[0] ^= 1;
+    LibTXD::TextureConverter::compressToDXT(rgba.data(), size, size, LibTXD::Compression::DXT1);
+    EXPECT_EQ(cache->getHits(), 1u);
+
+    std::vector<uint8_t> palette, indices, cachedPalette, cachedIndices;
+    ASSERT_TRUE(LibTXD::TextureConverter::generatePalette(rgba.data(), size, size, 256, palette, indices));
+    ASSERT_TRUE(LibTXD::TextureConverter::generatePalette(rgba.data(), size, size, 256, cachedPalette, cachedIndices));
+    EXPECT_EQ(cache->getHits(), 2u);
+    EXPECT_EQ(palette, cachedPalette);
+    EXPECT_EQ(indices, cachedIndices);
+
+    // A second handle on the directory sees the same entries
+    auto reopened = LibTXD::EncodeCache::open(dir.string());
+    ASSERT_NE(reopened, nullptr);
+    EXPECT_EQ(reopened->getSize(), cache->getSize());
+
+    LibTXD::TextureConverter::setEncodeCache(nullptr);
+    fs::remove_all(dir);
+}
+
+TEST_F(TextureConverterTest, EncodeCache_EvictsLeastRecentlyUsed) {
+    fs::path dir = fs::temp_directory_path() / "libtxd_encode_cache_evict";
+    fs::remove_all(dir);
+    // Room for three entries of 1 KB
+    auto cache = LibTXD::EncodeCache::open(dir.string(), 3 * 1100);
+    ASSERT_NE(cache, nullptr);
+
+    std::vector<uint8_t> payload(1024, 7), out(1024);
+    auto rgba = createTestRGBA(16, 16, 1, 2, 3, 255);
+    std::vector<LibTXD::EncodeCache::Key> keys;
+    for (uint32_t i = 0; i < 3; i++) {
+        keys.push_back(LibTXD::EncodeCache::makeKey(rgba.data(), 16, 16, LibTXD::EncodeCache::Kind::DXT1, i));
+        cache->store(keys.back(), payload.data(), payload.size());
+    }
+    // Make entry 0 the oldest, then use it so entry 1 becomes the oldest
+    auto old = fs::file_time_type::clock::now() - std::chrono::hours(1);
+    for (const auto& entry : fs::recursive_directory_iterator(dir)) {
+        if (entry.is_regular_file()) {
+            fs::last_write_time(entry.path(), old);
+        }
+    }
+    ASSERT_TRUE(cache->find(keys[0], out.data(), out.size()));
+
+    keys.push_back(LibTXD::EncodeCache::makeKey(rgba.data(), 16, 16, LibTXD::EncodeCache::Kind::DXT1, 3));
+    cache->store(keys.back(), payload.data(), payload.size());
+    EXPECT_LE(cache->getSize(), cache->getMaxSize());
+    EXPECT_TRUE(cache->find(keys[0], out.data(), out.size()));
+    EXPECT_FALSE(cache->find(keys[1], out.data(), out.size()));
+    EXPECT_TRUE(cache->find(keys[3], out.data(), out.size()));
+    // Wrong size is a miss, not a partial copy
+    EXPECT_FALSE(cache->find(keys[3], out.data(), out.size() - 1));
+
+    cache->clear();
+    EXPECT_EQ(cache->getSize(), 0u);
+    EXPECT_FALSE(cache->find(keys[0], out.data(), out.size()));
+    fs::remove_all(dir);
+}
+
 TEST_F(TextureConverterTest, ConvertPaletteToRGBA_ReconstructsImage) {
     // Create simple indexed data
     uint32_t width = 4;
@@ -1098,6 +1922,260 @@ TEST_F(IntegrationTest, CompressedTexture_FullPipeline) {
     EXPECT_TRUE(hasColorData);
 }
 
+TEST_F(IntegrationTest, DictionaryBuilder_ReencodesOnlyChangedSources) {
+    // Raw test images: width and height (uint32 each), then RGBA8 pixels
+    auto writeImage = [](const fs::path& path, uint32_t size, uint8_t shade) {
+        std::ofstream file(path, std::ios::binary);
+        file.write(reinterpret_cast<const char*>(&size), 4);
+        file.write(reinterpret_cast<const char*>(&size), 4);
+        std::vector<uint8_t> rgba(size * size * 4, shade);
+        for (size_t i = 3; i < rgba.size(); i += 4) {
+            rgba[i] = 255;
+        }
+        file.write(reinterpret_cast<const char*>(rgba.data()), static_cast<std::streamsize>(rgba.size()));
+    };
+    LibTXD::ImageDecoder decode = [](const uint8_t* data, size_t size, std::vector<uint8_t>& rgba,
+                                     uint32_t& width, uint32_t& height) {
+        if (size < 8) {
+            return false;
+        }
+        std::memcpy(&width, data, 4);
+        std::memcpy(&height, data + 4, 4);
+        rgba.assign(data + 8, data + size);
+        return rgba.size() == static_cast<size_t>(width) * height * 4;
+    };
+
+    writeImage(tempDir / "a.raw", 32, 40);
+    writeImage(tempDir / "b.raw", 16, 200);
+    LibTXD::BuildTarget target;
+    target.output = (tempDir / "out" / "test.txd").string();
+    target.sources = {{"alpha", (tempDir / "a.raw").string()}, {"beta", (tempDir / "b.raw").string()}};
+
+    LibTXD::BuildSettings settings;
+    LibTXD::DictionaryBuilder builder(decode, settings);
+    auto result = builder.build(target);
+    ASSERT_TRUE(result.ok) << result.error;
+    EXPECT_TRUE(result.written);
+    EXPECT_EQ(result.encoded, 2u);
+
+    // Nothing changed: the TXD is left alone
+    result = builder.build(target);
+    ASSERT_TRUE(result.ok);
+    EXPECT_FALSE(result.written);
+    EXPECT_EQ(result.reused, 2u);
+
+    LibTXD::TextureDictionary before;
+    ASSERT_TRUE(before.load(target.output));
+    std::vector<uint8_t> alphaBefore(before.findTexture("alpha")->getMipmap(0).getData(),
+                                     before.findTexture("alpha")->getMipmap(0).getData() +
+                                     before.findTexture("alpha")->getMipmap(0).dataSize);
+
+    // Only the changed image is encoded; the other texture is copied as is
+    writeImage(tempDir / "b.raw", 16, 90);
+    result = builder.build(target);
+    ASSERT_TRUE(result.ok);
+    EXPECT_TRUE(result.written);
+    EXPECT_EQ(result.encoded, 1u);
+    EXPECT_EQ(result.reused, 1u);
+
+    LibTXD::TextureDictionary after;
+    ASSERT_TRUE(after.load(target.output));
+    ASSERT_EQ(after.getTextureCount(), 2u);
+    const auto& alphaLevel = after.findTexture("alpha")->getMipmap(0);
+    EXPECT_TRUE(std::equal(alphaBefore.begin(), alphaBefore.end(), alphaLevel.getData()));
+    EXPECT_EQ(after.findTexture("alpha")->getMipmapCount(), before.findTexture("alpha")->getMipmapCount());
+    auto beta = LibTXD::TextureConverter::convertToRGBA8(*after.findTexture("beta"), 0);
+    ASSERT_NE(beta, nullptr);
+    EXPECT_NEAR(beta[0], 90, 4);
+
+    // Dropped sources are removed, different settings rebuild everything
+    target.sources.pop_back();
+    result = builder.build(target);
+    ASSERT_TRUE(result.ok);
+    EXPECT_EQ(result.removed, 1u);
+    EXPECT_EQ(result.reused, 1u);
+
+    settings.compress = false;
+    result = LibTXD::DictionaryBuilder(decode, settings).build(target);
+    ASSERT_TRUE(result.ok);
+    EXPECT_EQ(result.encoded, 1u);
+    LibTXD::TextureDictionary uncompressed;
+    ASSERT_TRUE(uncompressed.load(target.output));
+    EXPECT_EQ(uncompressed.getTexture(0)->getCompression(), LibTXD::Compression::NONE);
+}
+
+TEST_F(IntegrationTest, TextureIndex_FindsTexturesAndRefreshesChangedFiles) {
+    for (const char* name : {"gta3/infernus.txd", "gtasa/infernus.txd"}) {
+        if (!fs::exists(getExamplePath(name))) {
+            GTEST_SKIP() << "Example file not found: " << getExamplePath(name);
+        }
+    }
+
+    fs::path game = tempDir / "game";
+    fs::create_directories(game / "models");
+    fs::copy_file(getExamplePath("gta3/infernus.txd"), game / "models" / "gta3.txd");
+    fs::copy_file(getExamplePath("gtasa/infernus.txd"), game / "sa.TXD");
+    std::ofstream(game / "broken.txd") << "not a txd";
+    {
+        // Cut in the middle of a texture: the complete ones are still indexed
+        std::ifstream in(getExamplePath("gtasa/infernus.txd"), std::ios::binary);
+        std::string bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        std::ofstream(game / "truncated.txd", std::ios::binary) << bytes.substr(0, bytes.size() * 2 / 3);
+    }
+    fs::path indexPath = tempDir / "game.idx";
+
+    auto result = LibTXD::TextureIndex::build(game.string(), indexPath.string());
+    ASSERT_TRUE(result.ok);
+    EXPECT_EQ(result.files, 3u);
+    EXPECT_EQ(result.failed, 1u);
+    EXPECT_EQ(result.textures, 10u);
+
+    LibTXD::TextureIndex index;
+    ASSERT_TRUE(index.open(indexPath.string()));
+    auto found = index.find("INFERNUS92Handle32");
+    ASSERT_EQ(found.size(), 1u);
+    EXPECT_EQ(found[0].file, "sa.TXD");
+    EXPECT_EQ(found[0].width, 32u);
+    EXPECT_EQ(found[0].height, 16u);
+    EXPECT_EQ(found[0].compression, LibTXD::Compression::DXT3);
+    EXPECT_TRUE(index.find("infernus92").empty());
+
+    // The entry points at the texture's chunk and hashes its top level
+    LibTXD::Texture texture;
+    std::ifstream file(game / "sa.TXD", std::ios::binary);
+    std::vector<uint8_t> chunk(found[0].size);
+    file.seekg(found[0].offset);
+    file.read(reinterpret_cast<char*>(chunk.data()), static_cast<std::streamsize>(chunk.size()));
+    ASSERT_TRUE(texture.readD3D(chunk.data(), chunk.size(), nullptr));
+    EXPECT_EQ(texture.getName(), "infernus92handle32");
+    EXPECT_EQ(found[0].contentHash, LibTXD::Hash::hash64(texture.getMipmap(0).getData(), texture.getMipmap(0).dataSize));
+    index.close();
+
+    // Unchanged files are kept without a rescan, removed ones drop out
+    fs::remove(game / "models" / "gta3.txd");
+    result = LibTXD::TextureIndex::build(game.string(), indexPath.string());
+    ASSERT_TRUE(result.ok);
+    EXPECT_EQ(result.reused, 2u);
+    EXPECT_EQ(result.files, 2u);
+    ASSERT_TRUE(index.open(indexPath.string()));
+    EXPECT_EQ(index.getTextureCount(), 4u);
+    EXPECT_TRUE(index.find("white64").empty());
+    EXPECT_EQ(index.find("infernus92wheel32").size(), 2u);
+}
+
+TEST_F(IntegrationTest, ImgArchive_LoadsAndRewritesEntriesInPlace) {
+    std::vector<std::pair<std::string, std::vector<uint8_t>>> files;
+    for (const char* name : {"gta3/infernus.txd", "gtasa/infernus.txd"}) {
+        if (!fs::exists(getExamplePath(name))) {
+            GTEST_SKIP() << "Example file not found: " << getExamplePath(name);
+        }
+        std::ifstream file(getExamplePath(name), std::ios::binary);
+        files.emplace_back(fs::path(name).parent_path().string() + ".txd",
+                           std::vector<uint8_t>(std::istreambuf_iterator<char>(file), {}));
+    }
+
+    // Entries back to back after the directory, each padded to whole sectors
+    auto writeArchive = [&](const fs::path& imgPath, bool ver2) {
+        const uint32_t sectorSize = LibTXD::ImgArchive::SectorSize;
+        std::vector<uint8_t> directory;
+        std::vector<uint8_t> body;
+        uint32_t offset = ver2 ? 1 : 0;
+        for (const auto& [name, data] : files) {
+            uint32_t sectors = static_cast<uint32_t>((data.size() + sectorSize - 1) / sectorSize);
+            uint8_t record[32] = {};
+            std::memcpy(record, &offset, 4);
+            if (ver2) {
+                uint16_t streamingSize = static_cast<uint16_t>(sectors);
+                std::memcpy(record + 4, &streamingSize, 2);
+            } else {
+                std::memcpy(record + 4, &sectors, 4);
+            }
+            std::memcpy(record + 8, name.data(), name.size());
+            directory.insert(directory.end(), record, record + 32);
+            body.insert(body.end(), data.begin(), data.end());
+            body.resize(static_cast<size_t>(offset + sectors - (ver2 ? 1 : 0)) * sectorSize, 0);
+            offset += sectors;
+        }
+        std::ofstream img(imgPath, std::ios::binary);
+        if (ver2) {
+            uint32_t count = static_cast<uint32_t>(files.size());
+            std::vector<uint8_t> header(sectorSize, 0);
+            std::memcpy(header.data(), "VER2", 4);
+            std::memcpy(header.data() + 4, &count, 4);
+            std::memcpy(header.data() + 8, directory.data(), directory.size());
+            img.write(reinterpret_cast<const char*>(header.data()), sectorSize);
+        } else {
+            fs::path dirPath = imgPath;
+            std::ofstream(dirPath.replace_extension(".dir"), std::ios::binary)
+                .write(reinterpret_cast<const char*>(directory.data()), static_cast<std::streamsize>(directory.size()));
+        }
+        img.write(reinterpret_cast<const char*>(body.data()), static_cast<std::streamsize>(body.size()));
+    };
+
+    for (bool ver2 : {false, true}) {
+        SCOPED_TRACE(ver2 ? "VER2" : "v1");
+        fs::path imgPath = tempDir / (ver2 ? "gta3.img" : "gta_vc.img");
+        writeArchive(imgPath, ver2);
+
+        LibTXD::ImgArchive archive;
+        ASSERT_TRUE(archive.open(imgPath.string()));
+        EXPECT_EQ(archive.getVersion(), ver2 ? LibTXD::ImgArchive::Version::V2 : LibTXD::ImgArchive::Version::V1);
+        ASSERT_EQ(archive.getEntryCount(), 2u);
+        EXPECT_EQ(archive.findEntry("missing.txd"), nullptr);
+        const auto* entry = archive.findEntry("GTASA.TXD");
+        ASSERT_NE(entry, nullptr);
+
+        // The dictionary views the archive's mapping
+        LibTXD::TextureDictionary dict;
+        ASSERT_TRUE(archive.loadDictionary(*entry, dict));
+        ASSERT_EQ(dict.getTextureCount(), 3u);
+        EXPECT_TRUE(dict.getTexture(0)->isMapped());
+
+        // A smaller dictionary fits its sectors and is written in place
+        dict.removeTexture("infernus92wheel32");
+        ASSERT_TRUE(archive.saveDictionary(*archive.findEntry("gtasa.txd"), dict));
+        EXPECT_FALSE(dict.getTexture(0)->isMapped());
+        EXPECT_EQ(fs::file_size(imgPath) % LibTXD::ImgArchive::SectorSize, 0u);
+
+        // Entries after it are left alone, and content larger than the
+        // allocation is refused
+        LibTXD::ImgArchive reopened;
+        ASSERT_TRUE(reopened.open(imgPath.string()));
+        LibTXD::TextureDictionary saved, other;
+        ASSERT_TRUE(reopened.loadDictionary(*reopened.findEntry("gtasa.txd"), saved));
+        EXPECT_EQ(saved.getTextureCount(), 2u);
+        EXPECT_EQ(saved.findTexture("infernus92wheel32"), nullptr);
+        ASSERT_TRUE(reopened.loadDictionary(*reopened.findEntry("gta3.txd"), other));
+        EXPECT_EQ(other.getTextureCount(), 6u);
+
+        const auto& first = reopened.getEntry(0);
+        std::vector<uint8_t> oversized((reopened.getCapacity(first) + 1) * LibTXD::ImgArchive::SectorSize, 0);
+        EXPECT_FALSE(reopened.replaceEntry(first, oversized.data(), oversized.size()));
+    }
+
+    // A VER2 entry pointing into the directory is never written over it
+    fs::path badPath = tempDir / "bad.img";
+    {
+        std::vector<uint8_t> image(2 * LibTXD::ImgArchive::SectorSize, 0);
+        const uint32_t count = 1, sectors = 2;
+        std::memcpy(image.data(), "VER2", 4);
+        std::memcpy(image.data() + 4, &count, 4);
+        std::memcpy(image.data() + 12, &sectors, 2);
+        std::memcpy(image.data() + 16, "bad.txd", 7);
+        std::ofstream(badPath, std::ios::binary).write(reinterpret_cast<const char*>(image.data()),
+                                                       static_cast<std::streamsize>(image.size()));
+    }
+    LibTXD::ImgArchive bad;
+    ASSERT_TRUE(bad.open(badPath.string()));
+    ASSERT_EQ(bad.getEntryCount(), 1u);
+    EXPECT_EQ(bad.getCapacity(bad.getEntry(0)), 0u);
+    const uint8_t small[16] = {};
+    EXPECT_FALSE(bad.replaceEntry(bad.getEntry(0), small, sizeof(small)));
+    ASSERT_TRUE(bad.open(badPath.string()));
+    EXPECT_EQ(bad.getEntryCount(), 1u);
+    EXPECT_NE(bad.findEntry("bad.txd"), nullptr);
+}
+
 // ============================================================================
 // Game-Specific Tests
 // ============================================================================
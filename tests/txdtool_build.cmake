@@ -0,0 +1,37 @@
+# txdtool build with an input directory given with a trailing separator.
+# Run through CTest: cmake -DTXDTOOL=<txdtool> -DEXAMPLES=<examples dir> -DWORK=<scratch dir> -P txdtool_build.cmake
+
+if(NOT EXISTS "${EXAMPLES}/gta3/infernus.txd")
+    message("Example file not found: ${EXAMPLES}/gta3/infernus.txd")
+    return()
+endif()
+
+file(REMOVE_RECURSE "${WORK}")
+file(MAKE_DIRECTORY "${WORK}")
+
+function(run_txdtool)
+    execute_process(COMMAND "${TXDTOOL}" ${ARGN} RESULT_VARIABLE result ERROR_VARIABLE errors)
+    if(NOT result EQUAL 0)
+        message(FATAL_ERROR "txdtool ${ARGN} failed (${result}): ${errors}")
+    endif()
+    set(txdtool_errors "${errors}" PARENT_SCOPE)
+endfunction()
+
+# Source images: work/images/infernus/*.tga
+run_txdtool(extract "${EXAMPLES}/gta3/infernus.txd" "${WORK}/images")
+
+run_txdtool(build "${WORK}/images/infernus/" "${WORK}/out")
+if(NOT EXISTS "${WORK}/out/infernus.txd")
+    file(GLOB written "${WORK}/out/*")
+    message(FATAL_ERROR "Expected out/infernus.txd, got: ${written}")
+endif()
+
+# The manifest sits next to the TXD, so a rebuild without the separator
+# finds it and has nothing to do
+if(NOT EXISTS "${WORK}/out/infernus.txd.manifest")
+    message(FATAL_ERROR "Expected out/infernus.txd.manifest")
+endif()
+run_txdtool(build "${WORK}/images/infernus" "${WORK}/out")
+if(NOT txdtool_errors MATCHES "0 textures encoded, 6 reused, 1 of 1 TXDs up to date")
+    message(FATAL_ERROR "Rebuild was not incremental: ${txdtool_errors}")
+endif()
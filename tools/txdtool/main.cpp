@@ -0,0 +1,628 @@
+// txdtool - headless batch processing of TXD files with libtxd
+//
+//   txdtool info <path or .img>...
+//   txdtool extract <input> <output-dir>
+//   txdtool build <input-dir> <output-dir> [--game gta3|vc|sa] [--compress] [--no-mipmaps] [--force]
+//   txdtool convert-version <input> <output-dir> --game gta3|vc|sa
+//   txdtool recompress <input> <output-dir> --compress dxt|none [--quality 0..1]
+//   txdtool index <game-dir> <index-file>
+//   txdtool find <index-file> <name>...
+//
+// Inputs may be single files or directory trees; outputs mirror the input
+// layout. Files are spread over the libtxd worker pool (-j sets its size).
+
+#include "tga.h"
+#include "libtxd/txd_dictionary.h"
+#include "libtxd/txd_texture.h"
+#include "libtxd/txd_converter.h"
+#include "libtxd/txd_parallel.h"
+#include "libtxd/txd_builder.h"
+#include "libtxd/txd_index.h"
+#include "libtxd/txd_img.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+struct Game {
+    const char* name;
+    uint32_t version;
+    LibTXD::Platform platform;
+};
+
+// Same versions the editor writes for new files
+const Game GAMES[] = {
+    {"gta3", 0x0800FFFF, LibTXD::Platform::D3D8},
+    {"vc",   0x1003FFFF, LibTXD::Platform::D3D8},
+    {"sa",   0x1803FFFF, LibTXD::Platform::D3D9},
+};
+
+struct Options {
+    std::string command;
+    std::vector<fs::path> paths;
+    const Game* game = nullptr;
+    bool compress = false;
+    bool compressSet = false;
+    bool mipmaps = true;
+    bool force = false;
+    float quality = 1.0f;
+    unsigned threads = 0;
+    std::string cacheDir;
+};
+
+// Totals for the throughput report
+struct Stats {
+    std::atomic<uint64_t> bytes{0};
+    std::atomic<uint64_t> textures{0};
+    std::atomic<size_t> files{0};
+    std::atomic<size_t> failed{0};
+};
+
+// Buffers reused for every file a thread processes, so steady state
+// decoding and encoding don't allocate
+struct Scratch {
+    std::vector<uint8_t> rgba;
+    std::vector<uint8_t> file;
+};
+
+Scratch& getScratch() {
+    thread_local Scratch scratch;
+    return scratch;
+}
+
+void printUsage() {
+    std::fprintf(stderr,
+        "Usage: txdtool <command> [options] <paths>\n"
+        "\n"
+        "Commands:\n"
+        "  info <path>...                          List the textures of TXD files (or of the TXDs\n"
+        "                                          inside .img archives)\n"
+        "  extract <input> <output-dir>            Write every texture as <txd>/<name>.tga\n"
+        "  build <input-dir> <output-dir>          Build one TXD per directory of .tga files,\n"
+        "                                          re-encoding only images changed since the last build\n"
+        "  convert-version <input> <output-dir>    Rewrite TXD files for another game (--game)\n"
+        "  recompress <input> <output-dir>         Re-encode textures (--compress dxt|none)\n"
+        "  index <game-dir> <index-file>           Index every texture below a directory (refreshes\n"
+        "                                          an existing index, rescanning changed files only)\n"
+        "  find <index-file> <name>...             Look up textures by name in an index\n"
+        "\n"
+        "Options:\n"
+        "  --game gta3|vc|sa     Target game (build default: sa)\n"
+        "  --compress [dxt|none] DXT1/DXT3 compression (build: on if given)\n"
+        "  --no-mipmaps          build: store only the top level\n"
+        "  --force               build: encode every image, even if unchanged\n"
+        "  --quality Q           DXT quality, 0 (fast) to 1 (best, default)\n"
+        "  --cache DIR           Reuse DXT/palette encodes stored in DIR across runs\n"
+        "  -j N                  Worker threads (default: one per core)\n");
+}
+
+bool parseArguments(int argc, char** argv, Options& options) {
+    if (argc < 2) {
+        return false;
+    }
+    options.command = argv[1];
+    for (int i = 2; i < argc; i++) {
+        std::string arg = argv[i];
+        auto next = [&]() -> const char* { return i + 1 < argc ? argv[++i] : nullptr; };
+
+        if (arg == "--game") {
+            const char* value = next();
+            options.game = nullptr;
+            for (const Game& game : GAMES) {
+                if (value && std::strcmp(value, game.name) == 0) {
+                    options.game = &game;
+                }
+            }
+            if (!options.game) {
+                std::fprintf(stderr, "Unknown game: %s\n", value ? value : "");
+                return false;
+            }
+        } else if (arg == "--compress") {
+            options.compress = true;
+            options.compressSet = true;
+            // Optional value
+            if (i + 1 < argc && (std::strcmp(argv[i + 1], "dxt") == 0 || std::strcmp(argv[i + 1], "none") == 0)) {
+                options.compress = std::strcmp(argv[++i], "dxt") == 0;
+            }
+        } else if (arg == "--no-mipmaps") {
+            options.mipmaps = false;
+        } else if (arg == "--force") {
+            options.force = true;
+        } else if (arg == "--quality") {
+            const char* value = next();
+            if (!value) {
+                return false;
+            }
+            options.quality = std::clamp(static_cast<float>(std::atof(value)), 0.0f, 1.0f);
+        } else if (arg == "--cache") {
+            const char* value = next();
+            if (!value) {
+                return false;
+            }
+            options.cacheDir = value;
+        } else if (arg == "-j") {
+            const char* value = next();
+            if (!value) {
+                return false;
+            }
+            options.threads = static_cast<unsigned>(std::max(0, std::atoi(value)));
+        } else if (arg.size() > 1 && arg[0] == '-') {
+            std::fprintf(stderr, "Unknown option: %s\n", arg.c_str());
+            return false;
+        } else {
+            options.paths.push_back(arg);
+        }
+    }
+    return true;
+}
+
+bool hasExtension(const fs::path& path, const char* extension) {
+    std::string ext = path.extension().string();
+    std::transform(ext.begin(), ext.end(), ext.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return ext == extension;
+}
+
+// Files with the extension under `input` (or `input` itself), sorted
+std::vector<fs::path> findFiles(const fs::path& input, const char* extension) {
+    std::vector<fs::path> files;
+    std::error_code error;
+    if (fs::is_directory(input, error)) {
+        for (fs::recursive_directory_iterator it(input, error), end; !error && it != end; it.increment(error)) {
+            if (it->is_regular_file(error) && hasExtension(it->path(), extension)) {
+                files.push_back(it->path());
+            }
+        }
+    } else if (fs::is_regular_file(input, error)) {
+        files.push_back(input);
+    }
+    std::sort(files.begin(), files.end());
+    return files;
+}
+
+// Where the output for `file` goes, mirroring its place under `input`
+fs::path mirrorPath(const fs::path& file, const fs::path& input, const fs::path& output) {
+    std::error_code error;
+    if (fs::is_directory(input, error)) {
+        return output / fs::relative(file, input, error);
+    }
+    return output / file.filename();
+}
+
+bool writeFile(const fs::path& path, const std::vector<uint8_t>& data) {
+    std::error_code error;
+    fs::create_directories(path.parent_path(), error);
+    std::ofstream stream(path, std::ios::binary);
+    return stream && stream.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+}
+
+bool saveDictionary(const LibTXD::TextureDictionary& dict, const fs::path& path) {
+    std::error_code error;
+    fs::create_directories(path.parent_path(), error);
+    return dict.save(path.string());
+}
+
+uint64_t getFileSize(const fs::path& path) {
+    std::error_code error;
+    uintmax_t size = fs::file_size(path, error);
+    return error ? 0 : static_cast<uint64_t>(size);
+}
+
+const char* getGameName(LibTXD::GameVersion version) {
+    switch (version) {
+        case LibTXD::GameVersion::GTA3_1:
+        case LibTXD::GameVersion::GTA3_2:
+        case LibTXD::GameVersion::GTA3_3:
+        case LibTXD::GameVersion::GTA3_4:
+            return "GTA:III";
+        case LibTXD::GameVersion::VC_PC:
+        case LibTXD::GameVersion::VC_PS2:
+            return "GTA:VC";
+        case LibTXD::GameVersion::SA:
+            return "GTA:SA";
+        default:
+            return "Unknown";
+    }
+}
+
+const char* getFormatName(LibTXD::RasterFormat rasterFormat, LibTXD::Compression compression) {
+    if (compression == LibTXD::Compression::DXT1) return "DXT1";
+    if (compression == LibTXD::Compression::DXT3) return "DXT3";
+    uint32_t format = static_cast<uint32_t>(rasterFormat);
+    if (format & static_cast<uint32_t>(LibTXD::RasterFormat::PAL8)) return "PAL8";
+    if (format & static_cast<uint32_t>(LibTXD::RasterFormat::PAL4)) return "PAL4";
+    switch (format & static_cast<uint32_t>(LibTXD::RasterFormat::MASK)) {
+        case 0x0100: return "A1R5G5B5";
+        case 0x0200: return "R5G6B5";
+        case 0x0300: return "R4G4B4A4";
+        case 0x0400: return "LUM8";
+        case 0x0500: return "B8G8R8A8";
+        case 0x0600: return "B8G8R8";
+        case 0x0A00: return "R5G5B5";
+        default: return "Unknown";
+    }
+}
+
+// Texture names may hold characters that aren't valid in file names
+std::string toFileName(const std::string& name, size_t index) {
+    std::string result = name;
+    for (char& c : result) {
+        if (std::strchr("<>:\"/\\|?*", c) || static_cast<unsigned char>(c) < 32) {
+            c = '_';
+        }
+    }
+    if (result.empty()) {
+        result = "texture_" + std::to_string(index);
+    }
+    return result;
+}
+
+// Decode mipmap 0 into the thread's scratch buffer
+bool decodeTop(const LibTXD::Texture& texture, std::vector<uint8_t>& rgba) {
+    if (texture.getMipmapCount() == 0) {
+        return false;
+    }
+    const auto& mipmap = texture.getMipmap(0);
+    rgba.resize(static_cast<size_t>(mipmap.width) * mipmap.height * 4);
+    return LibTXD::TextureConverter::convertToRGBA8(texture, 0, rgba.data());
+}
+
+// ----------------------------------------------------------------------------
+// Commands. Each processes one unit of work and returns false on failure.
+// ----------------------------------------------------------------------------
+
+std::string describeDictionary(const std::string& label, const LibTXD::TextureDictionary& dict) {
+    std::ostringstream out;
+    char line[160];
+    std::snprintf(line, sizeof(line), "%s: %zu textures, %s (0x%08X)\n", label.c_str(),
+                  dict.getTextureCount(), getGameName(dict.getGameVersion()), dict.getVersion());
+    out << line;
+    for (size_t i = 0; i < dict.getTextureCount(); i++) {
+        const LibTXD::Texture& texture = *dict.getTexture(i);
+        std::snprintf(line, sizeof(line), "  %-32s %5ux%-5u %-9s %2u mips%s\n", texture.getName().c_str(),
+                      texture.getWidth(), texture.getHeight(), getFormatName(texture.getRasterFormat(), texture.getCompression()),
+                      texture.getMipmapCount(), texture.hasAlpha() ? "  alpha" : "");
+        out << line;
+    }
+    return out.str();
+}
+
+bool infoFile(const fs::path& file, Stats& stats, std::string& report) {
+    LibTXD::TextureDictionary dict;
+    if (!dict.load(file.string(), LibTXD::LoadMode::Mapped)) {
+        return false;
+    }
+    stats.bytes += getFileSize(file);
+    stats.textures += dict.getTextureCount();
+    report = describeDictionary(file.string(), dict);
+    return true;
+}
+
+bool extractFile(const fs::path& file, const fs::path& outputDir, Stats& stats) {
+    LibTXD::TextureDictionary dict;
+    if (!dict.load(file.string(), LibTXD::LoadMode::Mapped)) {
+        return false;
+    }
+    stats.bytes += getFileSize(file);
+
+    Scratch& scratch = getScratch();
+    bool ok = true;
+    for (size_t i = 0; i < dict.getTextureCount(); i++) {
+        const LibTXD::Texture& texture = *dict.getTexture(i);
+        if (!decodeTop(texture, scratch.rgba)) {
+            std::fprintf(stderr, "%s: cannot decode %s\n", file.string().c_str(), texture.getName().c_str());
+            ok = false;
+            continue;
+        }
+        TGA::encode(scratch.rgba.data(), texture.getWidth(), texture.getHeight(), scratch.file);
+        if (!writeFile(outputDir / (toFileName(texture.getName(), i) + ".tga"), scratch.file)) {
+            ok = false;
+            continue;
+        }
+        stats.textures++;
+    }
+    return ok;
+}
+
+bool convertFile(const fs::path& file, const fs::path& outputFile, const Options& options, Stats& stats) {
+    LibTXD::TextureDictionary dict;
+    if (!dict.load(file.string())) {
+        return false;
+    }
+    stats.bytes += getFileSize(file);
+    stats.textures += dict.getTextureCount();
+
+    // The pixel data is the same for every game; only the headers change
+    dict.setVersion(options.game->version);
+    for (size_t i = 0; i < dict.getTextureCount(); i++) {
+        dict.getTexture(i)->setPlatform(options.game->platform);
+    }
+    return saveDictionary(dict, outputFile);
+}
+
+bool recompressFile(const fs::path& file, const fs::path& outputFile, const Options& options, Stats& stats) {
+    LibTXD::TextureDictionary dict;
+    if (!dict.load(file.string())) {
+        return false;
+    }
+    stats.bytes += getFileSize(file);
+
+    Scratch& scratch = getScratch();
+    for (size_t i = 0; i < dict.getTextureCount(); i++) {
+        LibTXD::Texture& source = *dict.getTexture(i);
+        if (!decodeTop(source, scratch.rgba)) {
+            std::fprintf(stderr, "%s: cannot decode %s\n", file.string().c_str(), source.getName().c_str());
+            return false;
+        }
+
+        LibTXD::Texture texture;
+        texture.setName(source.getName());
+        texture.setMaskName(source.getMaskName());
+        texture.setFilterFlags(source.getFilterFlags());
+        texture.setPlatform(source.getPlatform());
+        texture.setHasAlpha(source.hasAlpha());
+        LibTXD::BuildSettings settings;
+        settings.compress = options.compress;
+        settings.quality = options.quality;
+        // Keep single-level textures single-level
+        settings.mipmaps = source.getMipmapCount() > 1;
+        if (!LibTXD::DictionaryBuilder::encodeImage(texture, scratch.rgba.data(), source.getWidth(),
+                                                    source.getHeight(), settings)) {
+            std::fprintf(stderr, "%s: cannot encode %s\n", file.string().c_str(), source.getName().c_str());
+            return false;
+        }
+        source = std::move(texture);
+        stats.textures++;
+    }
+    return saveDictionary(dict, outputFile);
+}
+
+// Run `work(i)` for every item on the worker pool. Items are handed out one
+// at a time, so threads that finish early take the next pending file.
+template <typename Work>
+void forEachItem(size_t count, Stats& stats, Work work) {
+    LibTXD::Parallel::parallelFor(count, 1, [&](size_t first, size_t last) {
+        for (size_t i = first; i < last; i++) {
+            if (!work(i)) {
+                stats.failed++;
+            }
+            stats.files++;
+        }
+    });
+}
+
+void printSummary(const Stats& stats, double seconds) {
+    const double megabytes = static_cast<double>(stats.bytes) / (1024.0 * 1024.0);
+    const double rate = seconds > 0 ? 1.0 / seconds : 0.0;
+    std::fprintf(stderr, "%zu files (%zu failed), %llu textures, %.1f MB in %.2f s: %.1f MB/s, %.0f textures/s\n",
+                 stats.files.load(), stats.failed.load(), static_cast<unsigned long long>(stats.textures.load()),
+                 megabytes, seconds, megabytes * rate, static_cast<double>(stats.textures) * rate);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseArguments(argc, argv, options)) {
+        printUsage();
+        return 2;
+    }
+    LibTXD::Parallel::setThreadCount(options.threads);
+    if (!options.cacheDir.empty()) {
+        auto cache = LibTXD::EncodeCache::open(options.cacheDir);
+        if (!cache) {
+            std::fprintf(stderr, "Cannot open cache directory: %s\n", options.cacheDir.c_str());
+            return 2;
+        }
+        LibTXD::TextureConverter::setEncodeCache(cache);
+    }
+
+    const std::string& command = options.command;
+    const bool isInfo = command == "info";
+    const bool isFind = command == "find";
+    if (isInfo ? options.paths.empty() : (isFind ? options.paths.size() < 2 : options.paths.size() != 2)) {
+        printUsage();
+        return 2;
+    }
+    if (command == "convert-version" && !options.game) {
+        std::fprintf(stderr, "convert-version needs --game\n");
+        return 2;
+    }
+    if (command == "recompress" && !options.compressSet) {
+        std::fprintf(stderr, "recompress needs --compress dxt|none\n");
+        return 2;
+    }
+
+    Stats stats;
+    const auto start = std::chrono::steady_clock::now();
+
+    if (isInfo) {
+        std::vector<fs::path> files;
+        std::vector<fs::path> archives;
+        for (const fs::path& path : options.paths) {
+            if (hasExtension(path, ".img")) {
+                archives.push_back(path);
+                continue;
+            }
+            std::vector<fs::path> found = findFiles(path, ".txd");
+            files.insert(files.end(), found.begin(), found.end());
+        }
+        // Printed in file order once everything is read
+        std::vector<std::string> reports(files.size());
+        forEachItem(files.size(), stats, [&](size_t i) {
+            if (!infoFile(files[i], stats, reports[i])) {
+                reports[i] = files[i].string() + ": cannot read\n";
+                return false;
+            }
+            return true;
+        });
+        for (const std::string& report : reports) {
+            std::fputs(report.c_str(), stdout);
+        }
+
+        // TXDs inside IMG archives load straight from the archive's mapping
+        for (const fs::path& path : archives) {
+            LibTXD::ImgArchive archive;
+            if (!archive.open(path.u8string())) {
+                std::printf("%s: cannot read\n", path.string().c_str());
+                stats.failed++;
+                continue;
+            }
+            std::vector<const LibTXD::ImgArchive::Entry*> entries;
+            for (size_t i = 0; i < archive.getEntryCount(); i++) {
+                if (hasExtension(archive.getEntry(i).name, ".txd")) {
+                    entries.push_back(&archive.getEntry(i));
+                }
+            }
+            reports.assign(entries.size(), std::string());
+            forEachItem(entries.size(), stats, [&](size_t i) {
+                const std::string label = path.string() + "/" + entries[i]->name;
+                LibTXD::TextureDictionary dict;
+                if (!archive.loadDictionary(*entries[i], dict)) {
+                    reports[i] = label + ": cannot read\n";
+                    return false;
+                }
+                stats.bytes += archive.getData(*entries[i]).length;
+                stats.textures += dict.getTextureCount();
+                reports[i] = describeDictionary(label, dict);
+                return true;
+            });
+            for (const std::string& report : reports) {
+                std::fputs(report.c_str(), stdout);
+            }
+        }
+    } else if (command == "index") {
+        LibTXD::IndexBuildResult result =
+            LibTXD::TextureIndex::build(options.paths[0].u8string(), options.paths[1].u8string());
+        if (!result.ok) {
+            std::fprintf(stderr, "Cannot index %s into %s\n", options.paths[0].string().c_str(),
+                         options.paths[1].string().c_str());
+            return 1;
+        }
+        stats.files = result.scanned;
+        stats.textures = result.textures;
+        stats.failed = result.failed;
+        std::fprintf(stderr, "%zu TXDs indexed (%zu scanned, %zu unchanged, %zu invalid), %zu textures\n",
+                     result.files, result.scanned, result.reused, result.failed, result.textures);
+    } else if (isFind) {
+        LibTXD::TextureIndex index;
+        if (!index.open(options.paths[0].u8string())) {
+            std::fprintf(stderr, "Cannot open index %s\n", options.paths[0].string().c_str());
+            return 1;
+        }
+        for (size_t i = 1; i < options.paths.size(); i++) {
+            std::vector<LibTXD::IndexedTexture> found = index.find(options.paths[i].u8string());
+            if (found.empty()) {
+                std::printf("%s: not found\n", options.paths[i].string().c_str());
+                stats.failed++;
+            }
+            for (const LibTXD::IndexedTexture& texture : found) {
+                std::printf("%-32s %s/%s @%u  %ux%u %s %u mips%s  %016llx\n", texture.name.c_str(),
+                            index.getRoot().c_str(), texture.file.c_str(), texture.offset, texture.width,
+                            texture.height, getFormatName(texture.rasterFormat, texture.compression),
+                            texture.mipmapCount, texture.hasAlpha ? " alpha" : "",
+                            static_cast<unsigned long long>(texture.contentHash));
+            }
+            stats.textures += found.size();
+        }
+    } else if (command == "build") {
+        // Without a trailing separator, so the walk's parent paths compare
+        // equal to it; the name comes from the resolved path so "." works
+        fs::path input = options.paths[0].lexically_normal();
+        if (!input.has_filename()) {
+            input = input.parent_path();
+        }
+        std::error_code error;
+        const fs::path inputName = fs::weakly_canonical(input, error).filename();
+        const fs::path& output = options.paths[1];
+        // Every directory holding .tga files becomes <directory>.txd
+        std::vector<LibTXD::BuildTarget> targets;
+        std::vector<fs::path> images = findFiles(input, ".tga");
+        std::stable_sort(images.begin(), images.end(), [](const fs::path& a, const fs::path& b) {
+            return a.parent_path() < b.parent_path();
+        });
+        for (size_t i = 0; i < images.size(); i++) {
+            const fs::path dir = images[i].parent_path();
+            if (i == 0 || dir != images[i - 1].parent_path()) {
+                fs::path target = dir == input ? output / inputName : mirrorPath(dir, input, output);
+                target += ".txd";
+                targets.push_back({target.u8string(), {}});
+            }
+            targets.back().sources.push_back({images[i].stem().u8string(), images[i].u8string()});
+        }
+
+        const Game& game = options.game ? *options.game : GAMES[2];
+        LibTXD::BuildSettings settings;
+        settings.version = game.version;
+        settings.platform = game.platform;
+        settings.compress = options.compress;
+        settings.mipmaps = options.mipmaps;
+        settings.quality = options.quality;
+        LibTXD::DictionaryBuilder builder(TGA::decode, settings);
+        builder.setForce(options.force);
+
+        size_t encoded = 0, reused = 0, upToDate = 0;
+        std::vector<LibTXD::BuildResult> results = builder.build(targets);
+        for (size_t i = 0; i < results.size(); i++) {
+            const LibTXD::BuildResult& result = results[i];
+            if (!result.ok) {
+                std::fprintf(stderr, "%s: %s\n", targets[i].output.c_str(), result.error.c_str());
+                stats.failed++;
+            }
+            stats.files++;
+            stats.bytes += result.bytesRead;
+            stats.textures += result.encoded;
+            encoded += result.encoded;
+            reused += result.reused;
+            upToDate += result.ok && !result.written;
+        }
+        std::fprintf(stderr, "%zu textures encoded, %zu reused, %zu of %zu TXDs up to date\n",
+                     encoded, reused, upToDate, results.size());
+    } else if (command == "extract" || command == "convert-version" || command == "recompress") {
+        const fs::path& input = options.paths[0];
+        const fs::path& output = options.paths[1];
+        std::vector<fs::path> files = findFiles(input, ".txd");
+        forEachItem(files.size(), stats, [&](size_t i) {
+            fs::path target = mirrorPath(files[i], input, output);
+            bool ok = false;
+            if (command == "extract") {
+                // <output>/<relative path>/<txd name>/<texture>.tga
+                ok = extractFile(files[i], target.replace_extension(), stats);
+            } else if (command == "convert-version") {
+                ok = convertFile(files[i], target, options, stats);
+            } else {
+                ok = recompressFile(files[i], target, options, stats);
+            }
+            if (!ok) {
+                std::fprintf(stderr, "%s: failed\n", files[i].string().c_str());
+            }
+            return ok;
+        });
+    } else {
+        std::fprintf(stderr, "Unknown command: %s\n", command.c_str());
+        printUsage();
+        return 2;
+    }
+
+    const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    if (!isFind) {
+        printSummary(stats, seconds);
+    }
+    if (auto cache = LibTXD::TextureConverter::getEncodeCache()) {
+        std::fprintf(stderr, "Encode cache: %llu hits, %llu misses\n",
+                     static_cast<unsigned long long>(cache->getHits()),
+                     static_cast<unsigned long long>(cache->getMisses()));
+    }
+    return stats.failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,148 @@
+#include "tga.h"
+#include "libtxd/txd_pixels.h"
+#include <algorithm>
+#include <cstring>
+
+namespace TGA {
+
+namespace {
+
+constexpr size_t HeaderSize = 18;
+
+// Image types
+constexpr uint8_t TrueColour = 2;
+constexpr uint8_t Greyscale = 3;
+constexpr uint8_t TrueColourRLE = 10;
+constexpr uint8_t GreyscaleRLE = 11;
+
+constexpr uint8_t TopDown = 0x20;
+
+// Expand `count` stored pixels (BGR, BGRA or grey) to RGBA8
+void unpackPixels(const uint8_t* source, uint32_t bytesPerPixel, uint8_t* rgba, size_t count,
+                  LibTXD::Pixels::UnpackRow unpack) {
+    if (unpack) {
+        unpack(source, rgba, count);
+        return;
+    }
+    // Greyscale
+    for (size_t i = 0; i < count; i++) {
+        rgba[i * 4 + 0] = source[i * bytesPerPixel];
+        rgba[i * 4 + 1] = source[i * bytesPerPixel];
+        rgba[i * 4 + 2] = source[i * bytesPerPixel];
+        rgba[i * 4 + 3] = 255;
+    }
+}
+
+} // namespace
+
+bool decode(const uint8_t* data, size_t size, std::vector<uint8_t>& rgba, uint32_t& width, uint32_t& height) {
+    if (!data || size < HeaderSize) {
+        return false;
+    }
+
+    const uint8_t idLength = data[0];
+    const uint8_t colourMapType = data[1];
+    const uint8_t imageType = data[2];
+    width = data[12] | (data[13] << 8);
+    height = data[14] | (data[15] << 8);
+    const uint8_t bitsPerPixel = data[16];
+    const uint8_t descriptor = data[17];
+
+    const bool rle = imageType == TrueColourRLE || imageType == GreyscaleRLE;
+    const bool grey = imageType == Greyscale || imageType == GreyscaleRLE;
+    if (colourMapType != 0 || width == 0 || height == 0) {
+        return false;
+    }
+    if (!(imageType == TrueColour || imageType == TrueColourRLE || grey)) {
+        return false;
+    }
+    if (grey ? bitsPerPixel != 8 : (bitsPerPixel != 24 && bitsPerPixel != 32)) {
+        return false;
+    }
+
+    LibTXD::Pixels::UnpackRow unpack = nullptr;
+    if (bitsPerPixel == 32) {
+        unpack = LibTXD::Pixels::getUnpacker(LibTXD::RasterFormat::B8G8R8A8, 4);
+    } else if (bitsPerPixel == 24) {
+        unpack = LibTXD::Pixels::getUnpacker(LibTXD::RasterFormat::B8G8R8, 3);
+    }
+
+    const uint32_t bytesPerPixel = bitsPerPixel / 8;
+    const size_t pixelCount = static_cast<size_t>(width) * height;
+    const uint8_t* pixels = data + HeaderSize + idLength;
+    const uint8_t* end = data + size;
+    if (pixels > end) {
+        return false;
+    }
+
+    rgba.resize(pixelCount * 4);
+    if (!rle) {
+        if (static_cast<size_t>(end - pixels) < pixelCount * bytesPerPixel) {
+            return false;
+        }
+        unpackPixels(pixels, bytesPerPixel, rgba.data(), pixelCount, unpack);
+    } else {
+        size_t written = 0;
+        while (written < pixelCount) {
+            if (pixels >= end) {
+                return false;
+            }
+            const uint8_t packet = *pixels++;
+            const size_t run = std::min<size_t>((packet & 0x7F) + 1, pixelCount - written);
+            if (packet & 0x80) {
+                // One pixel repeated
+                if (static_cast<size_t>(end - pixels) < bytesPerPixel) {
+                    return false;
+                }
+                uint8_t pixel[4];
+                unpackPixels(pixels, bytesPerPixel, pixel, 1, unpack);
+                for (size_t i = 0; i < run; i++) {
+                    std::memcpy(&rgba[(written + i) * 4], pixel, 4);
+                }
+                pixels += bytesPerPixel;
+            } else {
+                if (static_cast<size_t>(end - pixels) < run * bytesPerPixel) {
+                    return false;
+                }
+                unpackPixels(pixels, bytesPerPixel, &rgba[written * 4], run, unpack);
+                pixels += run * bytesPerPixel;
+            }
+            written += run;
+        }
+    }
+
+    // Stored bottom-up unless the descriptor says otherwise
+    if (!(descriptor & TopDown)) {
+        const size_t rowBytes = static_cast<size_t>(width) * 4;
+        std::vector<uint8_t> row(rowBytes);
+        for (uint32_t y = 0; y < height / 2; y++) {
+            uint8_t* top = &rgba[y * rowBytes];
+            uint8_t* bottom = &rgba[(height - 1 - y) * rowBytes];
+            std::memcpy(row.data(), top, rowBytes);
+            std::memcpy(top, bottom, rowBytes);
+            std::memcpy(bottom, row.data(), rowBytes);
+        }
+    }
+    return true;
+}
+
+void encode(const uint8_t* rgba, uint32_t width, uint32_t height, std::vector<uint8_t>& file) {
+    const size_t pixelCount = static_cast<size_t>(width) * height;
+    file.resize(HeaderSize + pixelCount * 4);
+
+    uint8_t* header = file.data();
+    std::memset(header, 0, HeaderSize);
+    header[2] = TrueColour;
+    header[12] = static_cast<uint8_t>(width);
+    header[13] = static_cast<uint8_t>(width >> 8);
+    header[14] = static_cast<uint8_t>(height);
+    header[15] = static_cast<uint8_t>(height >> 8);
+    header[16] = 32;
+    header[17] = TopDown | 8;  // 8 alpha bits
+
+    // RGBA -> BGRA is the same swap as the B8G8R8A8 packer
+    LibTXD::Pixels::PackRow pack = LibTXD::Pixels::getPacker(LibTXD::RasterFormat::B8G8R8A8, 4);
+    pack(rgba, file.data() + HeaderSize, pixelCount);
+}
+
+} // namespace TGA
@@ -0,0 +1,21 @@
+#ifndef TXDTOOL_TGA_H
+#define TXDTOOL_TGA_H
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+// Minimal Truevision TGA support for txdtool, so it needs no image library.
+namespace TGA {
+
+// Decode an uncompressed or RLE true-colour (24/32-bit) or greyscale (8-bit)
+// image into RGBA8, top row first. `rgba` is resized, so a reused buffer
+// keeps its capacity. Returns false for anything else.
+bool decode(const uint8_t* data, size_t size, std::vector<uint8_t>& rgba, uint32_t& width, uint32_t& height);
+
+// Encode RGBA8 as an uncompressed 32-bit top-down TGA into `file`
+void encode(const uint8_t* rgba, uint32_t width, uint32_t height, std::vector<uint8_t>& file);
+
+} // namespace TGA
+
+#endif // TXDTOOL_TGA_H